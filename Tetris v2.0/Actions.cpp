@@ -0,0 +1,76 @@
+#include "Actions.h"
+
+
+// Return the bit for an action
+static ActionSet::Bits toBit(const Action action)
+{
+	return static_cast<ActionSet::Bits>(1u << static_cast<int>(action));
+}
+
+
+// Constructor ------------------------------------------------------------
+
+ActionSet::ActionSet(const Bits bits)
+	: bits(bits)
+{
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+ActionSet::Bits ActionSet::getBits() const
+{
+	return bits;
+}
+
+bool ActionSet::has(const Action action) const
+{
+	return (bits & toBit(action)) != 0;
+}
+
+bool ActionSet::isEmpty() const
+{
+	return bits == 0;
+}
+
+void ActionSet::add(const Action action)
+{
+	bits |= toBit(action);
+}
+
+void ActionSet::remove(const Action action)
+{
+	bits &= static_cast<Bits>(~toBit(action));
+}
+
+void ActionSet::clear()
+{
+	bits = 0;
+}
+
+
+void addActions(ActionFrame& pending, ActionSet& deferredReleases, const ActionFrame& frame)
+{
+	for (int i{0}; i < static_cast<int>(Action::COUNT); i++)
+	{
+		const auto action{static_cast<Action>(i)};
+
+		if (frame.released.has(action))
+		{
+			if (pending.pressed.has(action))
+			{
+				deferredReleases.add(action);
+			}
+			else
+			{
+				pending.released.add(action);
+			}
+		}
+
+		if (frame.pressed.has(action))
+		{
+			pending.pressed.add(action);
+			deferredReleases.remove(action);
+		}
+	}
+}
@@ -0,0 +1,75 @@
+// The gameplay actions, and compact sets of them.
+//  - The game is driven by actions, not by keys, so the same representation
+//     can come from the keyboard, a replay, the network or a bot
+
+#ifndef ACTIONS_H
+#define ACTIONS_H
+
+#include <cstdint>
+
+
+// Enum Action for each gameplay action
+enum class Action : std::uint8_t
+{
+	MOVE_LEFT,
+	MOVE_RIGHT,
+	SOFT_DROP,
+	HARD_DROP,
+	ROTATE_CLOCKWISE,
+	ROTATE_COUNTERCLOCKWISE,
+	ROTATE_180,
+	HOLD,
+	COUNT
+};
+
+
+// The ActionSet class is a set of actions stored as one bit per action.
+class ActionSet
+{
+public:
+	using Bits = std::uint16_t;
+	static_assert(static_cast<int>(Action::COUNT) <= 16, "Actions must fit in ActionSet::Bits");
+
+private:
+	Bits bits{0}; // Bit n is set if Action n is in the set
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor (empty set)
+	ActionSet() = default;
+
+	// Constructor from raw bits (such as a recorded or received set)
+	explicit ActionSet(Bits bits);
+
+
+	// METHODS ----------------------------------------------------------------
+
+	Bits getBits() const;				// Get the raw bits
+	bool has(Action action) const;		// True if the action is in the set
+	bool isEmpty() const;				// True if no action is in the set
+
+	void add(Action action);			// Add an action to the set
+	void remove(Action action);			// Remove an action from the set
+	void clear();						// Remove all actions from the set
+};
+
+
+// The actions that went down and up during one tick
+struct ActionFrame
+{
+	ActionSet pressed;	// Actions that started this tick
+	ActionSet released;	// Actions that stopped this tick
+};
+
+
+// Add a frame of actions to the actions pending for the next tick.
+//  - A press and a release of one action in one tick would be applied release first
+//     (leaving it held), so such a release is deferred to the tick after
+//
+// - param 1: ActionFrame, the actions pending for the next tick (updated)
+// - param 2: ActionSet, the releases deferred to the tick after (updated)
+// - param 3: ActionFrame, the actions to add
+void addActions(ActionFrame& pending, ActionSet& deferredReleases, const ActionFrame& frame);
+
+#endif /* ACTIONS_H */
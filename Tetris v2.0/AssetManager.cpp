@@ -0,0 +1,154 @@
+#include "AssetManager.h"
+
+#include <algorithm>
+
+
+// AssetError -------------------------------------------------------------
+
+AssetError::AssetError(const std::string& path)
+	: std::runtime_error("Missing or invalid asset: " + path)
+{
+}
+
+
+// Constructor ------------------------------------------------------------
+
+AssetManager::AssetManager()
+{
+	// All jobs are queued before any worker starts, so jobs never reallocates under them
+	jobs.reserve(NUM_FIRST_FRAME_JOBS + static_cast<int>(SoundId::COUNT) + 1);
+
+	// First frame assets
+	addJob(AssetPack::AssetId::BACKGROUND_IMAGE, [this](const AssetPack::Asset& asset)
+	{
+		return images[static_cast<int>(ImageId::BACKGROUND)].loadFromMemory(asset.data, asset.size);
+	});
+	addJob(AssetPack::AssetId::TILES_IMAGE, [this](const AssetPack::Asset& asset)
+	{
+		return images[static_cast<int>(ImageId::TILES)].loadFromMemory(asset.data, asset.size);
+	});
+	addJob(AssetPack::AssetId::FONT, [this](const AssetPack::Asset& asset)
+	{
+		return font.loadFromMemory(asset.data, asset.size);
+	});
+
+	// Audio
+	addJob(AssetPack::AssetId::BLOCK_DROP_SOUND, [this](const AssetPack::Asset& asset)
+	{
+		return sounds[static_cast<int>(SoundId::BLOCK_DROP)].loadFromMemory(asset.data, asset.size);
+	});
+	addJob(AssetPack::AssetId::BLOCK_ROTATE_SOUND, [this](const AssetPack::Asset& asset)
+	{
+		return sounds[static_cast<int>(SoundId::BLOCK_ROTATE)].loadFromMemory(asset.data, asset.size);
+	});
+	addJob(AssetPack::AssetId::LEVEL_UP_SOUND, [this](const AssetPack::Asset& asset)
+	{
+		return sounds[static_cast<int>(SoundId::LEVEL_UP)].loadFromMemory(asset.data, asset.size);
+	});
+	addJob(AssetPack::AssetId::GAME_OVER_SOUND, [this](const AssetPack::Asset& asset)
+	{
+		return sounds[static_cast<int>(SoundId::GAME_OVER)].loadFromMemory(asset.data, asset.size);
+	});
+	addJob(AssetPack::AssetId::MUSIC, [this](const AssetPack::Asset& asset)
+	{
+		return music.openFromMemory(asset.data, asset.size);
+	});
+
+	const int numWorkers{std::max(1, std::min(static_cast<int>(std::thread::hardware_concurrency()),
+	                                          static_cast<int>(jobs.size())))};
+
+	for (int i{0}; i < numWorkers; i++)
+	{
+		workers.emplace_back(&AssetManager::runWorker, this);
+	}
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+void AssetManager::waitForFirstFrameAssets() const
+{
+	waitForJobs(0, NUM_FIRST_FRAME_JOBS);
+}
+
+void AssetManager::waitForAll() const
+{
+	waitForJobs(0, static_cast<int>(jobs.size()));
+}
+
+const sf::Image& AssetManager::getImage(const ImageId image) const
+{
+	return images[static_cast<int>(image)];
+}
+
+const sf::Font& AssetManager::getFont() const
+{
+	return font;
+}
+
+const sf::SoundBuffer& AssetManager::getSound(const SoundId sound) const
+{
+	return sounds[static_cast<int>(sound)];
+}
+
+sf::Music& AssetManager::getMusic()
+{
+	return music;
+}
+
+
+// Destructor -------------------------------------------------------------
+
+AssetManager::~AssetManager()
+{
+	// Skip the jobs that have not started
+	nextJob = static_cast<int>(jobs.size());
+
+	for (std::thread& worker : workers)
+	{
+		if (worker.joinable())
+		{
+			worker.join();
+		}
+	}
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+void AssetManager::addJob(const AssetPack::AssetId asset, std::function<bool(const AssetPack::Asset&)> load)
+{
+	jobs.emplace_back();
+
+	Job& job{jobs.back()};
+	job.asset = asset;
+	job.load = std::move(load);
+	job.ready = job.done.get_future().share();
+}
+
+void AssetManager::waitForJobs(const int first, const int last) const
+{
+	for (int i{first}; i < last; i++)
+	{
+		jobs[i].ready.get();	// Rethrows the job's AssetError
+	}
+}
+
+void AssetManager::runWorker()
+{
+	for (int i{nextJob++}; i < static_cast<int>(jobs.size()); i = nextJob++)
+	{
+		Job& job{jobs[i]};
+
+		AssetPack::Asset asset;
+
+		if (pack.getAsset(job.asset, asset) && job.load(asset))
+		{
+			job.done.set_value();
+		}
+		else
+		{
+			job.done.set_exception(std::make_exception_ptr(AssetError(AssetPack::getPath(job.asset))));
+		}
+	}
+}
@@ -0,0 +1,144 @@
+// The AssetManager class loads all of the game's images, font and audio.
+//  - Every asset is decoded concurrently on a pool of worker threads, starting as soon
+//     as the AssetManager is constructed
+//  - waitForFirstFrameAssets() only waits for what the first frame needs (images and font),
+//     so the window can show the game while the audio is still loading
+//  - Assets are decoded from memory (AssetPack), so no asset file is opened at run time
+//  - A missing or invalid asset is reported by throwing an AssetError (in Release builds too)
+//
+// Note: only CPU work is done on the workers. Images are decoded into sf::Image, and the
+// textures are created from them on the calling thread.
+
+#ifndef ASSETMANAGER_H
+#define ASSETMANAGER_H
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+#include "AssetPack.h"
+
+
+// Thrown when an asset can not be loaded
+class AssetError : public std::runtime_error
+{
+public:
+	// Constructor
+	//
+	// - param 1: string, the path of the asset that could not be loaded
+	explicit AssetError(const std::string& path);
+};
+
+
+class AssetManager
+{
+public:
+	// TYPES ------------------------------------------------------------------
+
+	// The images
+	enum class ImageId
+	{
+		BACKGROUND,
+		TILES,
+		COUNT
+	};
+
+	// The (fully decoded) sound effects
+	enum class SoundId
+	{
+		BLOCK_DROP,
+		BLOCK_ROTATE,
+		LEVEL_UP,
+		GAME_OVER,
+		COUNT
+	};
+
+private:
+	// One asset to load on a worker
+	struct Job
+	{
+		AssetPack::AssetId asset;		// The asset to load
+		std::function<bool(const AssetPack::Asset&)> load;	// Decodes the asset's bytes, returns false on failure
+		std::promise<void> done;		// Set when the job finished (holds an AssetError on failure)
+		std::shared_future<void> ready;	// Waits for done
+	};
+
+
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int NUM_FIRST_FRAME_JOBS{static_cast<int>(ImageId::COUNT) + 1};	// Images and the font (queued first)
+
+
+	// MEMBER VARIABLES -------------------------------------------------------
+	AssetPack pack;												// The asset bytes (outlives music, which streams from it)
+	sf::Image images[static_cast<int>(ImageId::COUNT)];			// Decoded images
+	sf::Font font;												// The HUD font
+	sf::SoundBuffer sounds[static_cast<int>(SoundId::COUNT)];	// Decoded sound effects
+	sf::Music music;											// The (streamed) background music
+
+	std::vector<Job> jobs;				// Every asset, first frame assets first
+	std::atomic<int> nextJob{0};		// Index of the next job for a worker to take
+	std::vector<std::thread> workers;	// The worker pool
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//  - Queues every asset and starts the worker pool (one worker per hardware thread,
+	//     at most one per asset)
+	AssetManager();
+
+	// The asset manager can not be copied
+	AssetManager(const AssetManager&) = delete;
+	AssetManager& operator=(const AssetManager&) = delete;
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Wait for the assets the first frame needs (the images and the font).
+	//  - Throws an AssetError if one of them could not be loaded
+	void waitForFirstFrameAssets() const;
+
+	// Wait for every asset.
+	//  - Throws an AssetError if one of them could not be loaded
+	void waitForAll() const;
+
+	// Getters (only once the asset has been waited for) ----------
+
+	const sf::Image& getImage(ImageId image) const;			// Get a decoded image
+	const sf::Font& getFont() const;						// Get the HUD font
+	const sf::SoundBuffer& getSound(SoundId sound) const;	// Get a decoded sound effect
+	sf::Music& getMusic();									// Get the background music
+
+
+	// Destructor -------------------------------------------------------------
+
+	// Joins the worker pool (after the jobs it is running finish)
+	~AssetManager();
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// Queue an asset to load.
+	//
+	// - param 1: AssetId, the asset
+	// - param 2: the function that decodes its bytes (returns false on failure)
+	void addJob(AssetPack::AssetId asset, std::function<bool(const AssetPack::Asset&)> load);
+
+	// Wait for a range of jobs.
+	//  - Throws the AssetError of the first job that failed
+	//
+	// - param 1: int, the first job
+	// - param 2: int, one past the last job
+	void waitForJobs(int first, int last) const;
+
+	// Take and run jobs until there are none left, run on each worker.
+	void runWorker();
+};
+
+#endif /* ASSETMANAGER_H */
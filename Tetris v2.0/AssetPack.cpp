@@ -0,0 +1,66 @@
+#include "AssetPack.h"
+
+#include <fstream>
+#include <iterator>
+#include "resource.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+
+static_assert(IDR_MUSIC - IDR_FIRST_ASSET == static_cast<int>(AssetPack::AssetId::MUSIC),
+              "resource.h must list the assets in AssetId order");
+
+
+// METHODS ----------------------------------------------------------------
+
+bool AssetPack::getAsset(const AssetId id, Asset& asset)
+{
+#ifdef _WIN32
+	// Embedded resources are mapped with the executable and never freed
+	const HRSRC resource{FindResourceA(nullptr, MAKEINTRESOURCEA(IDR_FIRST_ASSET + static_cast<int>(id)),
+	                                   MAKEINTRESOURCEA(10))};	// RT_RCDATA
+
+	if (resource == nullptr)
+	{
+		return false;
+	}
+
+	const HGLOBAL loaded{LoadResource(nullptr, resource)};
+
+	asset.data = loaded != nullptr ? LockResource(loaded) : nullptr;
+	asset.size = SizeofResource(nullptr, resource);
+#else
+	std::vector<char>& data{fileData[static_cast<int>(id)]};
+
+	if (data.empty())
+	{
+		std::ifstream file{getPath(id), std::ios::binary};
+		data.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+	}
+
+	asset.data = data.data();
+	asset.size = data.size();
+#endif
+
+	return (asset.data != nullptr) && (asset.size > 0);
+}
+
+const char* AssetPack::getPath(const AssetId id)
+{
+	switch (id)
+	{
+	case AssetId::BACKGROUND_IMAGE:		return "images/background_v2.0.png";
+	case AssetId::TILES_IMAGE:			return "images/tiles.png";
+	case AssetId::FONT:					return "fonts/times new roman.ttf";
+	case AssetId::BLOCK_DROP_SOUND:		return "sfx/blockDrop.ogg";
+	case AssetId::BLOCK_ROTATE_SOUND:	return "sfx/blockRotate.ogg";
+	case AssetId::LEVEL_UP_SOUND:		return "sfx/levelUp.ogg";
+	case AssetId::GAME_OVER_SOUND:		return "sfx/gameOver.ogg";
+	case AssetId::MUSIC:				return "sfx/tetrisMusic.ogg";
+	default:							return "";
+	}
+}
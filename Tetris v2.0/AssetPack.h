@@ -0,0 +1,67 @@
+// The AssetPack class gives read-only access to the raw bytes of every asset file.
+//  - On Windows the assets are embedded in the executable (Tetris v2.0.rc), so getting one
+//     only maps the resource section the loader already has open: no file is opened
+//  - Elsewhere each asset is read once from its file into memory
+//  - The bytes stay valid for as long as the pack lives, so streams (sf::Music, sf::Font)
+//     can keep reading from them
+//
+// Note: the assets are stored as is, PNG and OGG are already compressed.
+
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <cstddef>
+#include <vector>
+
+
+class AssetPack
+{
+public:
+	// TYPES ------------------------------------------------------------------
+
+	// The assets (in resource ID order, see resource.h)
+	enum class AssetId
+	{
+		BACKGROUND_IMAGE,
+		TILES_IMAGE,
+		FONT,
+		BLOCK_DROP_SOUND,
+		BLOCK_ROTATE_SOUND,
+		LEVEL_UP_SOUND,
+		GAME_OVER_SOUND,
+		MUSIC,
+		COUNT
+	};
+
+	// The bytes of an asset file
+	struct Asset
+	{
+		const void* data{nullptr};
+		std::size_t size{0};
+	};
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+
+	// The asset files read from disk (only when the assets are not embedded)
+	std::vector<char> fileData[static_cast<int>(AssetId::COUNT)];
+
+public:
+	// METHODS ----------------------------------------------------------------
+
+	// Get the bytes of an asset.
+	//  - Different assets may be got concurrently, from any thread
+	//
+	// - param 1: AssetId, the asset
+	// - param 2: Asset, filled with the asset's bytes
+	// - return: bool, false if the asset is missing
+	bool getAsset(AssetId id, Asset& asset);
+
+	// Get the path of an asset's source file.
+	//
+	// - param 1: AssetId, the asset
+	// - return: const char*, the path (relative to the project directory)
+	static const char* getPath(AssetId id);
+};
+
+#endif /* ASSETPACK_H */
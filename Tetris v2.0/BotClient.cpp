@@ -0,0 +1,226 @@
+#include "BotClient.h"
+
+#include <cstring>
+#include <string>
+
+
+static constexpr int HEADER_BYTES{2};	// The uint16 payload size before each message
+static constexpr int JOINED_BYTES{10};	// Type, match id, player and seed
+static constexpr int STATE_BYTES{7 + 6 * VersusMatch::NUM_PLAYERS};	// Type, tick, over, winner, then per player
+
+static constexpr auto TAP_INTERVAL{std::chrono::milliseconds(160)};		// Mean time between random taps
+static constexpr auto DROP_INTERVAL{std::chrono::milliseconds(500)};	// Time between hard drops
+
+
+// Read an unsigned value from a message, in little endian order, and move past it.
+//
+// - param 1: uint8_t pointer, the position to read at
+// - param 2: int, the bytes to read (1, 2 or 4)
+// - return: uint32_t, the value
+static std::uint32_t readUint(const std::uint8_t*& position, const int bytes)
+{
+	std::uint32_t value{0};
+
+	for (int i{0}; i < bytes; i++)
+	{
+		value |= static_cast<std::uint32_t>(*position++) << (i * 8);
+	}
+
+	return value;
+}
+
+
+// Constructor ------------------------------------------------------------
+
+BotClient::BotClient(const sf::IpAddress& address, const unsigned short port, const std::uint32_t seed)
+	: random(seed)
+{
+	if (socket.connect(address, port, sf::seconds(5)) != sf::Socket::Done)
+	{
+		throw NetworkError("could not connect to match server " + address.toString() + ":" + std::to_string(port));
+	}
+
+	socket.setBlocking(false);
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+bool BotClient::update(const Clock::time_point now)
+{
+	for (;;)
+	{
+		std::size_t received{0};
+		const sf::Socket::Status status{socket.receive(buffer + bufferedBytes,
+		                                               static_cast<std::size_t>(RECEIVE_BUFFER_BYTES - bufferedBytes), received)};
+
+		if ((status == sf::Socket::Disconnected) || (status == sf::Socket::Error))
+		{
+			return false;
+		}
+
+		if (received == 0)
+		{
+			break;
+		}
+
+		bufferedBytes += static_cast<int>(received);
+
+		// Read the whole messages, and keep the rest for the next receive
+		int position{0};
+
+		while (bufferedBytes - position >= HEADER_BYTES)
+		{
+			const int size{buffer[position] | (buffer[position + 1] << 8)};
+
+			if (HEADER_BYTES + size > RECEIVE_BUFFER_BYTES)
+			{
+				return false;
+			}
+
+			if (bufferedBytes - position < HEADER_BYTES + size)
+			{
+				break;
+			}
+
+			if (!readMessage(buffer + position + HEADER_BYTES, size, now))
+			{
+				return false;
+			}
+
+			position += HEADER_BYTES + size;
+		}
+
+		std::memmove(buffer, buffer + position, static_cast<std::size_t>(bufferedBytes - position));
+		bufferedBytes -= position;
+	}
+
+	if (!playing)
+	{
+		return true;
+	}
+
+	ActionFrame frame;
+
+	if (now >= nextDropTime)
+	{
+		frame.pressed.add(Action::HARD_DROP);
+		nextDropTime += DROP_INTERVAL;
+	}
+	else if (now >= nextActionTime)
+	{
+		frame.pressed.add(static_cast<Action>(random.nextInt(static_cast<int>(Action::COUNT))));
+		nextActionTime = now + TAP_INTERVAL / 2 + TAP_INTERVAL * random.nextInt(100) / 100;
+	}
+	else
+	{
+		return true;
+	}
+
+	frame.released = frame.pressed;	// A tap (the server applies the release on the next tick)
+
+	return sendActions(frame);
+}
+
+int BotClient::getMatchId() const
+{
+	return matchId;
+}
+
+int BotClient::getPlayer() const
+{
+	return player;
+}
+
+bool BotClient::isPlaying() const
+{
+	return playing;
+}
+
+std::int64_t BotClient::getTick() const
+{
+	return tick;
+}
+
+const BotClient::Stats& BotClient::getStats() const
+{
+	return stats;
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+bool BotClient::readMessage(const std::uint8_t* const payload, const int size, const Clock::time_point now)
+{
+	const std::uint8_t* position{payload};
+	const auto type{static_cast<MatchServer::MessageType>(readUint(position, 1))};
+
+	if ((type == MatchServer::MessageType::JOINED) && (size == JOINED_BYTES))
+	{
+		matchId = static_cast<int>(readUint(position, 4));
+		player = static_cast<int>(readUint(position, 1));
+
+		// A new round
+		playing = true;
+		tick = 0;
+		nextActionTime = now;
+		nextDropTime = now + DROP_INTERVAL;
+
+		return true;
+	}
+
+	if ((type == MatchServer::MessageType::STATE) && (size == STATE_BYTES))
+	{
+		tick = readUint(position, 4);
+		const bool over{readUint(position, 1) != 0};
+		const int winner{static_cast<int>(readUint(position, 1)) - 1};
+
+		stats.statesReceived++;
+
+		if (over && playing)
+		{
+			playing = false;
+			stats.roundsPlayed++;
+			stats.roundsWon += (winner == player);
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+bool BotClient::sendActions(const ActionFrame& frame)
+{
+	const std::uint8_t message[HEADER_BYTES + 5]{
+		5, 0,
+		static_cast<std::uint8_t>(MatchServer::MessageType::ACTIONS),
+		static_cast<std::uint8_t>(frame.pressed.getBits()), static_cast<std::uint8_t>(frame.pressed.getBits() >> 8),
+		static_cast<std::uint8_t>(frame.released.getBits()), static_cast<std::uint8_t>(frame.released.getBits() >> 8)};
+
+	std::size_t sentBytes{0};
+
+	for (;;)
+	{
+		std::size_t sent{0};
+		const sf::Socket::Status status{socket.send(message + sentBytes, sizeof(message) - sentBytes, sent)};
+
+		sentBytes += sent;
+
+		if (status == sf::Socket::Done)
+		{
+			stats.actionsSent++;
+			return true;
+		}
+
+		if ((status == sf::Socket::NotReady) && (sentBytes == 0))
+		{
+			return true;	// The socket is full, skip the action
+		}
+
+		if ((status == sf::Socket::Disconnected) || (status == sf::Socket::Error))
+		{
+			return false;
+		}
+	}
+}
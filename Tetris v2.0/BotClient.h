@@ -0,0 +1,106 @@
+// The BotClient class is a scripted player for a MatchServer (to load the server with
+// many players on one machine.)
+//  - Taps a random action about 6 times a second, and hard drops every half second,
+//     like the bots of the other loopback tests
+//  - Only plays while its match is running (between JOINED and the state that ends it)
+//  - Non-blocking: update() reads what has arrived, sends the actions due and returns
+
+#ifndef BOTCLIENT_H
+#define BOTCLIENT_H
+
+#include <chrono>
+#include <cstdint>
+#include <SFML/Network.hpp>
+#include "MatchServer.h"
+#include "Random.h"
+
+
+class BotClient
+{
+public:
+	// TYPES ------------------------------------------------------------------
+	using Clock = MatchServer::Clock;
+
+	// Counters of the bot (see getStats())
+	struct Stats
+	{
+		std::int64_t actionsSent{0};		// Action messages sent
+		std::int64_t statesReceived{0};		// State messages received
+		std::int64_t roundsPlayed{0};		// Rounds that ended
+		std::int64_t roundsWon{0};			// Rounds this bot won
+	};
+
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int RECEIVE_BUFFER_BYTES{64};		// Bytes of partly received messages kept
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+	sf::TcpSocket socket;						// Non-blocking connection to the server
+	Random random;								// Picks the actions
+
+	std::uint8_t buffer[RECEIVE_BUFFER_BYTES];	// Received bytes not read yet
+	int bufferedBytes{0};						// Bytes in buffer
+
+	int matchId{0};								// The match id (0 until joined)
+	int player{-1};								// The player index in the match (-1 until joined)
+	bool playing{false};						// True while the round is running
+	std::int64_t tick{0};						// The tick of the last state received
+
+	Clock::time_point nextActionTime;			// The time of the next random tap
+	Clock::time_point nextDropTime;				// The time of the next hard drop
+
+	Stats stats;								// Bot counters
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//  - Connects to the server, throws a NetworkError if it can not
+	//
+	// - param 1: IpAddress, the server's address
+	// - param 2: unsigned short, the server's TCP port
+	// - param 3: uint32_t, the seed of the bot's actions
+	BotClient(const sf::IpAddress& address, unsigned short port, std::uint32_t seed);
+
+	// The bot holds a socket, so it can not be copied
+	BotClient(const BotClient&) = delete;
+	BotClient& operator=(const BotClient&) = delete;
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Read the messages that have arrived, and send the actions due.
+	//
+	// - param 1: time_point, the current time
+	// - return: bool, false if the connection was closed (or the stream was invalid)
+	bool update(Clock::time_point now);
+
+	// Getters ---------------------------------
+
+	int getMatchId() const;				// Get the match id (0 until joined)
+	int getPlayer() const;				// Get the player index (-1 until joined)
+	bool isPlaying() const;				// True while the round is running
+	std::int64_t getTick() const;		// Get the tick of the last state received
+	const Stats& getStats() const;		// Get the bot counters
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// Apply one message (see MatchServer for the format.)
+	//
+	// - param 1: uint8_t pointer, the payload
+	// - param 2: int, the payload size
+	// - param 3: time_point, the current time
+	// - return: bool, false if the message is invalid
+	bool readMessage(const std::uint8_t* payload, int size, Clock::time_point now);
+
+	// Send an action message.
+	//  - Skipped if the socket can not take it, the rest of a partly sent message is retried
+	//
+	// - param 1: ActionFrame, the actions
+	// - return: bool, false if the connection was closed or failed
+	bool sendActions(const ActionFrame& frame);
+};
+
+#endif /* BOTCLIENT_H */
@@ -0,0 +1,221 @@
+#include "GameRenderer.h"
+
+
+
+// STATIC CONSTANTS INITIALIZATION ----------------------------------------
+const int GameRenderer::BLOCK_WIDTH{ 32 };
+const int GameRenderer::BLOCK_HEIGHT{ 32 };
+const int GameRenderer::NEXT_SHAPE_Y_SPACE{ 95 };
+
+
+// Constructor ------------------------------------------------------------
+
+GameRenderer::GameRenderer(sf::RenderTarget& target, const sf::Sprite& blockSprite,
+                           const sf::Sprite& backgroundSprite, const sf::Font& font, const Point& gameboardOffset,
+                           const Point nextShapeCenter[], const Point& holdShapeCenter)
+	: target(target), blockSprite(blockSprite), backgroundSprite(backgroundSprite), gameboardOffset(gameboardOffset),
+	  holdShapeCenter(holdShapeCenter), font(font)
+{
+	for (int i{0}; i < TetrisGame::NUM_NEXT_SHAPES; i++)
+	{
+		this->nextShapeCenter[i] = nextShapeCenter[i];
+	}
+
+	setupAllText();	// Setup all text
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+void GameRenderer::draw(const TetrisGame::Snapshot& snapshot)
+{
+	drawStaticLayer();
+
+	// Draw Current and Ghost shape
+	drawShape(snapshot.currentShape, gameboardOffset);
+	drawShape(snapshot.ghostShape, gameboardOffset, 0.5f);
+
+	// Draw Hold Shape if set
+	if (snapshot.holdShape.visible)
+	{
+		drawShape(snapshot.holdShape, getCenteredTopLeft(snapshot.holdShape, holdShapeCenter));
+	}
+
+	// Draw all Next Shape(s)
+	for (int i = 0; i < TetrisGame::NUM_NEXT_SHAPES; i++)
+	{
+		drawShape(snapshot.nextShapes[i], getCenteredTopLeft(snapshot.nextShapes[i], nextShapeCenter[i]));
+	}
+
+	// Draw gameboard
+	drawGameboard(snapshot);
+
+	// Draw the HUD (laid out again only if a value changed)
+	scoreDisplay.setValue(snapshot.score);
+	levelDisplay.setValue(snapshot.level);
+	linesDisplay.setValue(snapshot.lines);
+
+	scoreDisplay.draw(target);
+	levelDisplay.draw(target);
+	linesDisplay.draw(target);
+}
+
+void GameRenderer::invalidateStaticLayer()
+{
+	staticLayerDirty = true;
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+void GameRenderer::setupAllText()
+{
+	// Title --------------------------------
+	title.setString("Tetris v2.0");
+	title.setFont(font);
+	title.setCharacterSize(35);
+	title.setFillColor(sf::Color::White);
+	title.setPosition(491 - (title.getLocalBounds().width / 2), 75 - (title.getLocalBounds().height));
+
+
+	// Hold ---------------------------------
+	holdShapeTitle.setString("Hold");
+	holdShapeTitle.setFont(font);
+	holdShapeTitle.setCharacterSize(25);
+	holdShapeTitle.setFillColor(sf::Color::White);
+	holdShapeTitle.setPosition(180 - (holdShapeTitle.getLocalBounds().width / 2), 152 - (holdShapeTitle.getLocalBounds().height));
+
+
+	// Next Shape ---------------------------
+	nextShapeTitle.setString("Next Shape");
+	nextShapeTitle.setFont(font);
+	nextShapeTitle.setCharacterSize(25);
+	nextShapeTitle.setFillColor(sf::Color::White);
+	nextShapeTitle.setPosition(802 - (nextShapeTitle.getLocalBounds().width / 2), 152 - (nextShapeTitle.getLocalBounds().height));
+
+
+	// Score Title --------------------------
+	scoreTitle.setString("Score");
+	scoreTitle.setFont(font);
+	scoreTitle.setCharacterSize(25);
+	scoreTitle.setFillColor(sf::Color::White);
+	scoreTitle.setPosition(187 - (scoreTitle.getLocalBounds().width / 2), 468 - (scoreTitle.getLocalBounds().height));
+
+	// Score Display
+	scoreDisplay.setup(font, 18, sf::Color::White, Point{188, 502});
+
+
+	// Level Title --------------------------
+	levelTitle.setString("Level");
+	levelTitle.setFont(font);
+	levelTitle.setCharacterSize(25);
+	levelTitle.setFillColor(sf::Color::White);
+	levelTitle.setPosition(187 - (levelTitle.getLocalBounds().width / 2), 545 - (levelTitle.getLocalBounds().height));
+
+	// Level Display
+	levelDisplay.setup(font, 18, sf::Color::White, Point{188, 579});
+
+
+	// Lines (rows cleared) Title -----------
+	linesTitle.setString("Lines");
+	linesTitle.setFont(font);
+	linesTitle.setCharacterSize(25);
+	linesTitle.setFillColor(sf::Color::White);
+	linesTitle.setPosition(187 - (linesTitle.getLocalBounds().width / 2), 622 - (linesTitle.getLocalBounds().height));
+
+	// Lines (rows cleared) Display
+	linesDisplay.setup(font, 18, sf::Color::White, Point{188, 656});
+}
+
+void GameRenderer::drawStaticLayer()
+{
+	const sf::Vector2u size{target.getSize()};
+
+	if (staticLayerDirty.exchange(false))
+	{
+		// Rasterize at the target's pixel size (through the game's view), so it is drawn 1:1
+		staticLayerCreated = staticLayer.create(size.x, size.y);
+
+		if (staticLayerCreated)
+		{
+			staticLayer.setView(target.getView());
+			staticLayer.clear(sf::Color::White);
+			drawStaticElements(staticLayer);
+			staticLayer.display();
+
+			staticLayerSprite.setTexture(staticLayer.getTexture(), true);
+		}
+	}
+
+	if (!staticLayerCreated)
+	{
+		drawStaticElements(target);
+		return;
+	}
+
+	const sf::View gameView{target.getView()};
+
+	target.setView(sf::View(sf::FloatRect(0.f, 0.f, static_cast<float>(size.x), static_cast<float>(size.y))));
+	target.draw(staticLayerSprite);
+	target.setView(gameView);
+}
+
+void GameRenderer::drawStaticElements(sf::RenderTarget& layerTarget) const
+{
+	layerTarget.draw(backgroundSprite);
+
+	layerTarget.draw(title);
+	layerTarget.draw(holdShapeTitle);
+	layerTarget.draw(nextShapeTitle);
+	layerTarget.draw(scoreTitle);
+	layerTarget.draw(levelTitle);
+	layerTarget.draw(linesTitle);
+}
+
+void GameRenderer::drawBlock(const Point& topLeft, const int xOffset, const int yOffset,
+                             const Tetromino::TetColor color, const float alpha)
+{
+	blockSprite.setTextureRect(sf::IntRect(0 + (static_cast<int>(color) * BLOCK_WIDTH), 0, BLOCK_WIDTH, BLOCK_HEIGHT));
+	blockSprite.setPosition(static_cast<float>(topLeft.getX()) + static_cast<float>(BLOCK_WIDTH * xOffset),
+	                        static_cast<float>(topLeft.getY()) + static_cast<float>(BLOCK_HEIGHT * yOffset));
+
+	blockSprite.setColor(sf::Color(blockSprite.getColor().r, blockSprite.getColor().g, blockSprite.getColor().b,
+	                               static_cast<sf::Uint8>(alpha * 255))); // 255 is the max alpha/ transparency, the lower the number, the more transparent the sprite
+
+	target.draw(blockSprite);
+}
+
+void GameRenderer::drawGameboard(const TetrisGame::Snapshot& snapshot)
+{
+	for (int y{0}; y < TetrisGame::Board::MAX_Y; y++)
+	{
+		for (int x{0}; x < TetrisGame::Board::MAX_X; x++)
+		{
+			if (snapshot.board[y][x] == TetrisSimulation::GARBAGE_BLOCK)
+			{
+				// There is no garbage tile, garbage is drawn as faded blocks
+				drawBlock(gameboardOffset, x, y, Tetromino::TetColor::BLUE_DARK, 0.6f);
+			}
+			else if (snapshot.board[y][x] != TetrisGame::Board::EMPTY_BLOCK)
+			{
+				drawBlock(gameboardOffset, x, y, static_cast<Tetromino::TetColor>(snapshot.board[y][x]));
+			}
+		}
+	}
+}
+
+void GameRenderer::drawShape(const TetrisGame::Snapshot::Shape& shape, const Point& topLeft, const float alpha)
+{
+	for (int i{0}; i < Tetromino::NUM_BLOCKS; i++)
+	{
+		drawBlock(topLeft, shape.blockX[i], shape.blockY[i], shape.color, alpha);
+	}
+}
+
+Point GameRenderer::getCenteredTopLeft(const TetrisGame::Snapshot::Shape& shape, const Point& center)
+{
+	return Point{
+		center.getX() - static_cast<int>(shape.xViewBlockOffset * BLOCK_WIDTH),
+		center.getY() - static_cast<int>(shape.yViewBlockOffset * BLOCK_HEIGHT)
+	};
+}
@@ -0,0 +1,145 @@
+// The GameRenderer class draws a TetrisGame from its snapshots.
+//  - It only reads TetrisGame::Snapshot objects, never the game itself, so it can
+//     draw on the render thread while the game loop keeps running
+//  - The static layer (background and titles) is composited once into a RenderTexture,
+//     and only redrawn after the window is resized
+
+#ifndef GAMERENDERER_H
+#define GAMERENDERER_H
+
+#include <atomic>
+#include <SFML/Graphics.hpp>
+#include "HudCounter.h"
+#include "TetrisGame.h"
+
+
+class GameRenderer
+{
+public:
+	// STATIC CONSTANTS -------------------------------------------------------
+	static const int BLOCK_WIDTH;			// Pixel width of a Tetris block
+	static const int BLOCK_HEIGHT;			// Pixel height of a Tetris block
+	static const int NEXT_SHAPE_Y_SPACE;	// The pixel spacing between the next shapes in the Y column
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+
+	sf::RenderTarget& target;				// The target (window) to draw on
+	sf::Sprite blockSprite;					// The sprite used for all the blocks
+	sf::Sprite backgroundSprite;			// The background sprite
+	const Point gameboardOffset;			// Pixel XY offset of the gameboard on the screen
+	const Point holdShapeCenter;			// Pixel XY center of the hold shape area on the screen
+	Point nextShapeCenter[TetrisGame::NUM_NEXT_SHAPES];	// Pixel XY center for nextShape(s)
+
+	const sf::Font& font;	 // SFML font for text (loaded by the AssetManager)
+	sf::Text title;			 // SFML text object for displaying the title
+	sf::Text holdShapeTitle; // SFML text object for displaying the block in hold
+	sf::Text nextShapeTitle; // SFML text object for displaying the next shapes
+	sf::Text scoreTitle;	 // SFML text object for displaying the score title
+	sf::Text levelTitle;	 // SFML text object for displaying the level title
+	sf::Text linesTitle;	 // SFML text object for displaying the lines (rows cleared) title
+
+	HudCounter scoreDisplay; // Displays the score
+	HudCounter levelDisplay; // Displays the level
+	HudCounter linesDisplay; // Displays the lines (rows cleared)
+
+	sf::RenderTexture staticLayer;			// The background and titles, at the target's pixel size
+	sf::Sprite staticLayerSprite;			// Sprite showing staticLayer
+	bool staticLayerCreated{false};			// False if staticLayer has not been (or could not be) created
+	std::atomic<bool> staticLayerDirty{true};	// True if staticLayer must be redrawn before it is used
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//  - Setup all text
+	//
+	// - param 1: the RenderTarget (window) to draw on
+	// - param 2: Sprite object (the block sprite, its texture must outlive the renderer)
+	// - param 3: Sprite object (the background sprite, its texture must outlive the renderer)
+	// - param 4: Font (loaded, must outlive the renderer)
+	// - param 5: Point object (the offset of the gameboard)
+	// - param 6: Point object array (next shape(s) center)
+	// - param 7: Point object (the center of the hold shape area)
+	GameRenderer(sf::RenderTarget& target, const sf::Sprite& blockSprite, const sf::Sprite& backgroundSprite,
+	             const sf::Font& font, const Point& gameboardOffset, const Point nextShapeCenter[],
+	             const Point& holdShapeCenter);
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Draw a snapshot of the game, which is:
+	// The static layer (background and titles, from the cache)
+	//
+	// For Tetrominos:
+	//  - currentShape
+	//  - ghostShape
+	//  - holdShape (if set)
+	//  - nextShape(s)
+	//
+	// The gameboard
+	//
+	// For the HUD:
+	//  - scoreDisplay, levelDisplay, linesDisplay
+	//     (only laid out again when their value changes)
+	//
+	// - param 1: the Snapshot to draw
+	void draw(const TetrisGame::Snapshot& snapshot);
+
+	// Redraw the static layer before the next draw() (call when the window is resized.)
+	//  - Can be called from any thread
+	void invalidateStaticLayer();
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// Sets up the contents, font, character size, color and position of all sf::Text,
+	// and the HUD displays
+	void setupAllText();
+
+	// Draw the static layer (background and titles)
+	//  - Composites it into staticLayer first if it is dirty
+	//  - Draws it directly if a RenderTexture can not be created
+	void drawStaticLayer();
+
+	// Draw the background and titles onto a target.
+	//
+	// - param 1: the RenderTarget to draw on
+	void drawStaticElements(sf::RenderTarget& layerTarget) const;
+
+	// Draw a Tetris block sprite on the canvas
+	// The block position is specified in terms of 2 offsets:
+	//    1) the top left (of the gameboard in pixels)
+	//    2) an x & y offset into the gameboard - in blocks (not pixels)
+	//       meaning they need to be multiplied by BLOCK_WIDTH and BLOCK_HEIGHT
+	//       to get the pixel offset.
+	//
+	// - param 1: Point topLeft
+	// - param 2: int xOffset (cols)
+	// - param 3: int yOffset (rows)
+	// - param 4: TetColor color
+	// - param 5: float alpha (1 is opaque)
+	void drawBlock(const Point& topLeft, int xOffset, int yOffset, Tetromino::TetColor color, float alpha = 1.0f);
+
+	// Draw the gameboard blocks
+	//
+	// - param 1: the Snapshot to draw the gameboard of
+	void drawGameboard(const TetrisGame::Snapshot& snapshot);
+
+	// Draw a shape.
+	//
+	// - param 1: the Snapshot::Shape to draw
+	// - param 2: Point topLeft
+	// - param 3: float alpha (1 is opaque)
+	void drawShape(const TetrisGame::Snapshot::Shape& shape, const Point& topLeft, float alpha = 1.0f);
+
+	// Get the top left to draw a preview (hold or next) shape at, so it is centered.
+	//
+	// - param 1: the Snapshot::Shape to center
+	// - param 2: Point, the pixel center to draw it around
+	// - return: Point, the pixel top left
+	static Point getCenteredTopLeft(const TetrisGame::Snapshot::Shape& shape, const Point& center);
+};
+
+#endif /* GAMERENDERER_H */
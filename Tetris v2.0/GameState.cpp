@@ -0,0 +1,415 @@
+#include "GameState.h"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cassert>
+#include <type_traits>
+
+#include "SuperRotationSystem.h"
+
+
+static_assert(std::is_trivially_copyable<GameState>::value, "Rollouts copy game states by assignment");
+static_assert(sizeof(GameState) <= 128, "A game state must fit in two cache lines");
+
+
+namespace
+{
+	using Board = GameState::Board;
+
+	constexpr int NUM_SHAPES{SuperRotationSystem::NUM_SHAPES};
+	constexpr int NUM_STATES{SuperRotationSystem::NUM_STATES};
+
+	constexpr std::uint8_t FULL_BAG{(1u << NUM_SHAPES) - 1};	// Every shape left in the bag
+
+	// A shape in one rotation state, as the masks of the rows it covers
+	struct ShapeMask
+	{
+		Board::RowMask rows[SuperRotationSystem::NUM_BLOCKS];	// Bit i of row j is set for the block at offset (left + i, top + j)
+		int left;		// Smallest block x offset
+		int top;		// Smallest block y offset
+		int width;		// Columns covered
+		int height;		// Rows covered
+		int bottoms[SuperRotationSystem::NUM_BLOCKS];	// Largest block y offset (from top) of each column covered
+	};
+
+	using ShapeMaskTable = std::array<std::array<ShapeMask, NUM_STATES>, NUM_SHAPES>;
+
+	// Generate the masks of every shape and rotation state at compile time (from the SRS block offsets)
+	constexpr ShapeMaskTable makeShapeMasks()
+	{
+		ShapeMaskTable table{};
+
+		for (int shape{0}; shape < NUM_SHAPES; shape++)
+		{
+			for (int state{0}; state < NUM_STATES; state++)
+			{
+				const auto& offsets{SuperRotationSystem::BLOCK_OFFSETS[shape][state]};
+				ShapeMask& mask{table[shape][state]};
+
+				int right{offsets[0].x};
+				int bottom{offsets[0].y};
+				mask.left = offsets[0].x;
+				mask.top = offsets[0].y;
+
+				for (const SuperRotationSystem::Offset& offset : offsets)
+				{
+					mask.left = std::min<int>(mask.left, offset.x);
+					mask.top = std::min<int>(mask.top, offset.y);
+					right = std::max<int>(right, offset.x);
+					bottom = std::max<int>(bottom, offset.y);
+				}
+
+				mask.width = right - mask.left + 1;
+				mask.height = bottom - mask.top + 1;
+
+				for (const SuperRotationSystem::Offset& offset : offsets)
+				{
+					mask.rows[offset.y - mask.top] |= static_cast<Board::RowMask>(1u << (offset.x - mask.left));
+					mask.bottoms[offset.x - mask.left] = std::max(mask.bottoms[offset.x - mask.left], offset.y - mask.top);
+				}
+			}
+		}
+
+		return table;
+	}
+
+	constexpr ShapeMaskTable SHAPE_MASKS{makeShapeMasks()};
+
+	static_assert((SHAPE_MASKS[static_cast<int>(Tetromino::TetShape::I)][0].width == 4)
+	              && (SHAPE_MASKS[static_cast<int>(Tetromino::TetShape::I)][1].height == 4)
+	              && (SHAPE_MASKS[static_cast<int>(Tetromino::TetShape::T)][0].rows[0] == 0b010)
+	              && (SHAPE_MASKS[static_cast<int>(Tetromino::TetShape::T)][0].rows[1] == 0b111), "Shape masks.");
+
+	// Get the number of set bits of a mask
+	int countBits(const std::uint32_t mask)
+	{
+		return static_cast<int>(std::bitset<32>(mask).count());
+	}
+
+	// Get the storage index of a row (0 for the top hidden row)
+	constexpr int storageRow(const int y)
+	{
+		return y + Board::HIDDEN_ROWS;
+	}
+}
+
+
+// Constructor ------------------------------------------------------------
+
+GameState::GameState(const TetrisSimulation& simulation, const std::uint32_t seed)
+	: score(simulation.getScore()), lines(simulation.getLines()), random(seed),
+	  currentShape(static_cast<std::uint8_t>(simulation.getCurrentShape())), holdShape(0),
+	  shapesLeft(simulation.getShapeBag().getShapesLeft()), holdShapeSet(false),
+	  holdAvailable(simulation.isHoldAvailable()), gameOver(simulation.isGameOver())
+{
+	// The row masks, from the packed occupancy
+	Board::PackedBoard packed;
+	simulation.getBoard().pack(packed);
+	Board::unpackRowMasks(packed, rows);
+
+	for (int i{0}; i < NUM_NEXT_SHAPES; i++)
+	{
+		nextShapes[i] = static_cast<std::uint8_t>(simulation.getNextShape(i));
+	}
+
+	Tetromino::TetShape shape;
+	holdShapeSet = simulation.getHoldShape(shape);
+	holdShape = static_cast<std::uint8_t>(shape);
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+void GameState::reseed(const std::uint32_t seed)
+{
+	random = Random{seed};
+}
+
+int GameState::getPlacements(Placement placements[MAX_PLACEMENTS]) const
+{
+	if (gameOver)
+	{
+		return 0;
+	}
+
+	const int spawnX{Board::MAX_X / 2};
+	int count{0};
+
+	Board::ColumnMask columns[Board::MAX_X];
+	getColumns(columns);
+
+	std::uint32_t coveredBlocks[MAX_PLACEMENTS];	// The landed top row, left column and row masks of each placement
+
+	for (int hold{0}; hold < (holdAvailable ? 2 : 1); hold++)
+	{
+		const int shape{getPlacedShape(hold == 1)};
+		const int firstOfShape{count};	// Only the placements of the same shape can cover the same blocks
+
+		for (int rotation{0}; rotation < NUM_STATES; rotation++)
+		{
+			if (!fits(shape, rotation, spawnX, 0))
+			{
+				continue;
+			}
+
+			const ShapeMask& mask{SHAPE_MASKS[shape][rotation]};
+			const std::uint32_t maskRows{static_cast<std::uint32_t>(mask.rows[0] | (mask.rows[1] << 4) | (mask.rows[2] << 8) | (mask.rows[3] << 12))};
+
+			// Left from the spawn column, then right of it (the order TetrisSimulation lists them in)
+			for (const int direction : {-1, 1})
+			{
+				for (int x{(direction < 0) ? spawnX : spawnX + 1}; fits(shape, rotation, x, 0); x += direction)
+				{
+					const int y{getDropDistance(columns, shape, rotation, x, 0)};
+					const std::uint32_t blocks{static_cast<std::uint32_t>(storageRow(y + mask.top))
+						| (static_cast<std::uint32_t>(x + mask.left) << 5) | (maskRows << 9)};
+
+					if (std::find(coveredBlocks + firstOfShape, coveredBlocks + count, blocks) == coveredBlocks + count)
+					{
+						coveredBlocks[count] = blocks;
+						placements[count++] = Placement{hold == 1, static_cast<std::int8_t>(rotation), static_cast<std::int8_t>(x),
+						                                static_cast<std::int8_t>(y)};
+					}
+				}
+			}
+		}
+	}
+
+	return count;
+}
+
+bool GameState::place(const Placement& placement)
+{
+	if (gameOver || !canReach(placement))
+	{
+		return false;
+	}
+
+	const int shape{getPlacedShape(placement.useHold)};
+
+	// Hold (see TetrisSimulation::setHoldShape())
+	if (placement.useHold)
+	{
+		if (holdShapeSet)
+		{
+			holdShape = currentShape;
+		}
+		else
+		{
+			holdShape = currentShape;
+			holdShapeSet = true;
+			pickNextShape();
+		}
+	}
+
+	// Hard drop and lock
+	const ShapeMask& mask{SHAPE_MASKS[shape][placement.rotation]};
+	Board::ColumnMask columns[Board::MAX_X];
+	getColumns(columns);
+
+	const int rowsDropped{getDropDistance(columns, shape, placement.rotation, placement.x, 0)};
+	const int top{rowsDropped + mask.top};
+
+	score += TetrisSimulation::getHardDropPoints(rowsDropped);
+
+	for (int i{0}; i < mask.height; i++)
+	{
+		rows[storageRow(top + i)] |= static_cast<RowMask>(mask.rows[i] << (placement.x + mask.left));
+	}
+
+	// Lock out if the shape locked entirely in the hidden rows
+	const bool lockedAboveBoard{top + mask.height <= 0};
+
+	// Remove the completed rows (from the top down, so the rows below do not move)
+	int rowsCleared{0};
+
+	for (int i{0}; i < mask.height; i++)
+	{
+		const int row{storageRow(top + i)};
+
+		if (rows[row] == Board::FULL_ROW_MASK)
+		{
+			std::copy_backward(rows, rows + row, rows + row + 1);
+			rows[0] = 0;
+			rowsCleared++;
+		}
+	}
+
+	holdAvailable = true;
+
+	// Block out if the next shape can not spawn (see TetrisSimulation::onShapeLocked())
+	currentShape = nextShapes[0];
+
+	if (lockedAboveBoard || !fits(currentShape, 0, Board::MAX_X / 2, 0))
+	{
+		gameOver = true;
+		return true;
+	}
+
+	pickNextShape();
+
+	score += TetrisSimulation::getRowClearPoints(rowsCleared, TetrisSimulation::getLevelForLines(lines));
+	lines += rowsCleared;
+
+	return true;
+}
+
+int GameState::getScore() const
+{
+	return score;
+}
+
+int GameState::getLines() const
+{
+	return lines;
+}
+
+bool GameState::isGameOver() const
+{
+	return gameOver;
+}
+
+bool GameState::isHoldAvailable() const
+{
+	return holdAvailable;
+}
+
+Tetromino::TetShape GameState::getCurrentShape() const
+{
+	return static_cast<Tetromino::TetShape>(currentShape);
+}
+
+bool GameState::getHoldShape(Tetromino::TetShape& shape) const
+{
+	shape = static_cast<Tetromino::TetShape>(holdShape);
+
+	return holdShapeSet;
+}
+
+GameState::RowMask GameState::getRow(const int y) const
+{
+	assert((y >= -Board::HIDDEN_ROWS) && (y < Board::MAX_Y) && "Invalid Row Index.");
+
+	return rows[storageRow(y)];
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+bool GameState::fits(const int shape, const int rotation, const int x, const int y) const
+{
+	const ShapeMask& mask{SHAPE_MASKS[shape][rotation]};
+	const int left{x + mask.left};
+	const int top{y + mask.top};
+
+	if ((left < 0) || (left + mask.width > Board::MAX_X) || (top < -Board::HIDDEN_ROWS) || (top + mask.height > Board::MAX_Y))
+	{
+		return false;
+	}
+
+	for (int i{0}; i < mask.height; i++)
+	{
+		if ((rows[storageRow(top + i)] & (mask.rows[i] << left)) != 0)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void GameState::getColumns(Board::ColumnMask columns[Board::MAX_X]) const
+{
+	std::fill(columns, columns + Board::MAX_X, Board::ColumnMask{0});
+
+	for (int row{0}; row < Board::TOTAL_ROWS; row++)
+	{
+		for (RowMask blocks{rows[row]}; blocks != 0; blocks &= blocks - 1)
+		{
+			columns[countBits((blocks & -blocks) - 1u)] |= Board::ColumnMask{1} << row;
+		}
+	}
+}
+
+int GameState::getDropDistance(const Board::ColumnMask columns[Board::MAX_X], const int shape, const int rotation, const int x, const int y)
+{
+	const ShapeMask& mask{SHAPE_MASKS[shape][rotation]};
+
+	int rowsDropped{Board::TOTAL_ROWS};
+
+	// The lowest block of each column drops to the first filled block below it (or the floor)
+	for (int i{0}; i < mask.width; i++)
+	{
+		const int row{storageRow(y + mask.top + mask.bottoms[i])};
+		const Board::ColumnMask below{static_cast<Board::ColumnMask>(columns[x + mask.left + i] >> (row + 1))};
+
+		rowsDropped = std::min(rowsDropped, (below != 0) ? countBits((below & -below) - 1u) : Board::TOTAL_ROWS - 1 - row);
+	}
+
+	return rowsDropped;
+}
+
+int GameState::getPlacedShape(const bool useHold) const
+{
+	if (!useHold)
+	{
+		return currentShape;
+	}
+
+	return static_cast<int>(TetrisSimulation::getShapeAfterHold(holdShapeSet, static_cast<Tetromino::TetShape>(holdShape),
+	                                                            static_cast<Tetromino::TetShape>(nextShapes[0])));
+}
+
+bool GameState::canReach(const Placement& placement) const
+{
+	if ((placement.useHold && !holdAvailable) || (placement.rotation < 0) || (placement.rotation >= NUM_STATES))
+	{
+		return false;
+	}
+
+	const int shape{getPlacedShape(placement.useHold)};
+	const int direction{(placement.x < Board::MAX_X / 2) ? -1 : 1};
+
+	for (int x{Board::MAX_X / 2}; x != placement.x + direction; x += direction)
+	{
+		if (!fits(shape, placement.rotation, x, 0))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void GameState::pickNextShape()
+{
+	currentShape = nextShapes[0];
+
+	std::copy(nextShapes + 1, nextShapes + NUM_NEXT_SHAPES, nextShapes);
+	nextShapes[NUM_NEXT_SHAPES - 1] = dealShape();
+}
+
+std::uint8_t GameState::dealShape()
+{
+	if (shapesLeft == 0)
+	{
+		shapesLeft = FULL_BAG;
+	}
+
+	// The n-th shape left in the bag, n picked at random
+	int pick{random.nextInt(static_cast<int>(std::bitset<NUM_SHAPES>(shapesLeft).count()))};
+	int shape{0};
+
+	for (;; shape++)
+	{
+		if (((shapesLeft >> shape) & 1) && (pick-- == 0))
+		{
+			break;
+		}
+	}
+
+	shapesLeft &= static_cast<std::uint8_t>(~(1u << shape));
+
+	return static_cast<std::uint8_t>(shape);
+}
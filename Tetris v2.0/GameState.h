@@ -0,0 +1,152 @@
+// The GameState class is a compact copy of a solo game between two shapes, for search that
+// plays many possible futures of a position (rollouts.)
+//  - Two cache lines, trivially copyable: the board as one bit mask per row, the current,
+//     next and hold shapes, the shapes left in the 7-bag, the score and the lines
+//  - Plays whole shapes like TetrisSimulation::place() (the same placements, row clears,
+//     scoring and top outs) on the row masks only, so a copy and a placement are cheap
+//  - The shapes after the next shapes are dealt at random from what is left of the bag (a
+//     player can not know their order), from the state's own seed (see reseed())
+//  - Not kept: block colors, the falling shape's position and timers, and garbage (a
+//     rollout is a solo future)
+
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+
+#include <cstdint>
+#include "Random.h"
+#include "TetrisSimulation.h"
+
+
+class alignas(64) GameState
+{
+public:
+	// TYPES ------------------------------------------------------------------
+	using Board = TetrisSimulation::Board;
+	using Placement = TetrisSimulation::Placement;
+	using RowMask = Board::RowMask;
+
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int MAX_PLACEMENTS{TetrisSimulation::MAX_PLACEMENTS};	// Most placements of one shape
+	static constexpr int NUM_NEXT_SHAPES{TetrisSimulation::NUM_NEXT_SHAPES};	// Next shapes known
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+	RowMask rows[Board::TOTAL_ROWS];				// Bit x is set if the block is filled (the top hidden row first)
+
+	std::int32_t score;								// The score
+	std::int32_t lines;								// Total lines cleared
+	Random random;									// Deals the shapes after the next shapes
+
+	std::uint8_t currentShape;						// The shape to place (TetShape)
+	std::uint8_t nextShapes[NUM_NEXT_SHAPES];		// The next shapes, in order
+	std::uint8_t holdShape;							// The shape on hold (if holdShapeSet)
+	std::uint8_t shapesLeft;						// Bit n is set if TetShape n is left in the bag
+	bool holdShapeSet;								// True once a shape was put on hold
+	bool holdAvailable;								// True if hold was not used for this shape yet
+	bool gameOver;									// True once the game topped out
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//  - Copies a game between two shapes (its falling shape is placed from the spawn location)
+	//
+	// - param 1: TetrisSimulation, the game
+	// - param 2: uint32_t, the seed of the shapes dealt after the next shapes
+	GameState(const TetrisSimulation& simulation, std::uint32_t seed);
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Change the seed of the shapes dealt after the next shapes (each rollout its own.)
+	//
+	// - param 1: uint32_t, the seed
+	void reseed(std::uint32_t seed);
+
+	// List the hard drop placements of the current shape, and of the shape hold would bring
+	// in (the same placements, in the same order, as TetrisSimulation::getPlacements().)
+	//
+	// - param 1: Placement array, filled with the placements (MAX_PLACEMENTS at most)
+	// - return: int, the number of placements (0 if the game is over)
+	int getPlacements(Placement placements[MAX_PLACEMENTS]) const;
+
+	// Play a whole shape (see TetrisSimulation::place().)
+	//  - Nothing changes if the placement can not be reached
+	//
+	// - param 1: Placement, the placement
+	// - return: bool, true if the shape was placed
+	bool place(const Placement& placement);
+
+	// Getters ---------------------------------
+
+	int getScore() const;						// Get the score
+	int getLines() const;						// Get the total lines cleared
+	bool isGameOver() const;					// True once the game topped out
+	bool isHoldAvailable() const;				// True if hold was not used for this shape yet
+	Tetromino::TetShape getCurrentShape() const;	// Get the shape to place
+
+	// Get the shape on hold.
+	//
+	// - param 1: TetShape, set to the shape on hold (if any)
+	// - return: bool, true if a shape is on hold
+	bool getHoldShape(Tetromino::TetShape& shape) const;
+
+	// Get the blocks of a row.
+	//
+	// - param 1: int, the row (y, negative in the hidden rows)
+	// - return: RowMask, bit x is set if the block is filled
+	RowMask getRow(int y) const;
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// Determine if a shape fits at a grid location (inside the board, on empty blocks.)
+	//
+	// - param 1: int, the shape (TetShape)
+	// - param 2: int, the rotation state
+	// - param 3: int, the gridLoc x
+	// - param 4: int, the gridLoc y
+	// - return: bool, true if the shape fits
+	bool fits(int shape, int rotation, int x, int y) const;
+
+	// Get the filled blocks of every column (the board's row masks, transposed.)
+	//
+	// - param 1: ColumnMask array, filled with bit row set for each filled block (row 0 the top hidden row)
+	void getColumns(Board::ColumnMask columns[Board::MAX_X]) const;
+
+	// Get the rows a shape can drop from a grid location (it must fit there.)
+	//  - One lookup per column of the shape (see getColumns())
+	//
+	// - param 1: ColumnMask array, the columns (see getColumns())
+	// - param 2: int, the shape (TetShape)
+	// - param 3: int, the rotation state
+	// - param 4: int, the gridLoc x
+	// - param 5: int, the gridLoc y
+	// - return: int, the rows it drops
+	static int getDropDistance(const Board::ColumnMask columns[Board::MAX_X], int shape, int rotation, int x, int y);
+
+	// Get the shape a placement places: the current shape, or the one hold brings in (see
+	// TetrisSimulation::getShapeAfterHold().)
+	//
+	// - param 1: bool, true if the placement uses hold
+	// - return: int, the shape (TetShape)
+	int getPlacedShape(bool useHold) const;
+
+	// Determine if a placement can be reached: it fits at the spawn location, and at every
+	// column on the way to its x.
+	//
+	// - param 1: Placement, the placement
+	// - return: bool, true if it can be reached
+	bool canReach(const Placement& placement) const;
+
+	// Move the first next shape to the current shape, and deal a new last next shape.
+	void pickNextShape();
+
+	// Deal a shape from the bag (a new bag once it is empty.)
+	//
+	// - return: uint8_t, the shape (TetShape)
+	std::uint8_t dealShape();
+};
+
+#endif /* GAMESTATE_H */
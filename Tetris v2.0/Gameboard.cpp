@@ -1,12 +1,142 @@
+#include <algorithm>
+#include <bitset>
 #include <cassert>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <string>
+#include <utility>
 #include "Gameboard.h"
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+// Return the index of the lowest set bit of a non-zero mask
+static int lowestSetBit(const std::uint32_t mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, mask);
+
+	return static_cast<int>(index);
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+
+// Return the index of the lowest set bit of a non-zero 64 bit mask
+//  - Split into two 32 bit scans so it also works on 32 bit (Win32) builds
+static int lowestSetBit(const std::uint64_t mask)
+{
+	const auto lowBits{static_cast<std::uint32_t>(mask)};
+
+	if (lowBits != 0)
+	{
+		return lowestSetBit(lowBits);
+	}
+
+	return 32 + lowestSetBit(static_cast<std::uint32_t>(mask >> 32));
+}
+
+
+// Packed boards ----------------------------------------------------------
+//  - Blocks are handled 8 at a time as the byte lanes of a 64 bit word (SWAR), loaded
+//     and stored in little endian order (block x in byte x % 8)
+
+static constexpr std::uint64_t BYTE_LANES{0x0101010101010101};	// Bit 0 of every byte lane
+
+// Store the lanes of a word as 8 bytes (lane i in byte i.)
+static void storeLanes(std::uint8_t* const bytes, const std::uint64_t lanes)
+{
+	std::memcpy(bytes, &lanes, sizeof(lanes));
+}
+
+// Spread the low 8 bits into bit 0 of each byte lane (bit i to lane i)
+static constexpr std::uint64_t spreadLanes(const std::uint64_t bits)
+{
+	// Each lane keeps its own bit of a copy of the 8 bits, then is rounded to 0 or 1
+	return (((((bits & 0xFF) * BYTE_LANES) & 0x8040201008040201) + 0x7F7F7F7F7F7F7F7F) >> 7) & BYTE_LANES;
+}
+
+// spreadLanes() of every byte, generated at compile time (one load instead of the arithmetic)
+struct SpreadTable
+{
+	std::uint64_t lanes[256];
+
+	constexpr SpreadTable()
+		: lanes{}
+	{
+		for (int bits{0}; bits < 256; bits++)
+		{
+			lanes[bits] = spreadLanes(static_cast<std::uint64_t>(bits));
+		}
+	}
+};
+
+static constexpr SpreadTable SPREAD_TABLE{};
+
+// Spread 8 bits of a row, starting at a bit, into bit 0 of each byte lane (see spreadLanes().)
+static std::uint64_t spreadByte(const std::uint64_t row, const int firstBit)
+{
+	return SPREAD_TABLE.lanes[(row >> firstBit) & 0xFF];
+}
+
+// Add one row of bits to a bitfield, at the row's constant position.
+template <int RowWidth, int Row>
+static void packBitRow(std::uint64_t words[], const std::uint64_t bits)
+{
+	constexpr int FIRST_BIT{Row * RowWidth};
+	constexpr int SHIFT{FIRST_BIT % 64};
+
+	words[FIRST_BIT / 64] |= bits << SHIFT;
+
+	// The row continues in the next word
+	if constexpr (SHIFT + RowWidth > 64)
+	{
+		words[FIRST_BIT / 64 + 1] |= bits >> (64 - SHIFT);
+	}
+}
+
+// Get one row of bits from a bitfield, at the row's constant position.
+template <int RowWidth, int Row>
+static std::uint64_t unpackBitRow(const std::uint64_t words[])
+{
+	constexpr int FIRST_BIT{Row * RowWidth};
+	constexpr int SHIFT{FIRST_BIT % 64};
+
+	std::uint64_t bits{words[FIRST_BIT / 64] >> SHIFT};
+
+	// The row continues in the next word
+	if constexpr (SHIFT + RowWidth > 64)
+	{
+		bits |= words[FIRST_BIT / 64 + 1] << (64 - SHIFT);
+	}
+
+	return bits & (~std::uint64_t{0} >> (64 - RowWidth));
+}
+
+// Pack rows of bits into a bitfield, row after row (the words must be zeroed.)
+//  - Unrolled at compile time (one packBitRow() per row), so every shift is a constant
+template <int RowWidth, typename RowBits, int... Rows>
+static void packBitRows(std::uint64_t words[], const RowBits rows[], std::integer_sequence<int, Rows...>)
+{
+	(packBitRow<RowWidth, Rows>(words, static_cast<std::uint64_t>(rows[Rows])), ...);
+}
+
+// Unpack the rows of bits of a bitfield (see packBitRows().)
+template <int RowWidth, typename RowBits, int... Rows>
+static void unpackBitRows(const std::uint64_t words[], RowBits rows[], std::integer_sequence<int, Rows...>)
+{
+	((rows[Rows] = static_cast<RowBits>(unpackBitRow<RowWidth, Rows>(words))), ...);
+}
+
 
 // Constructor ------------------------------------------------------------
 
-Gameboard::Gameboard()
+template <int Width, int Height, int HiddenRows>
+Gameboard<Width, Height, HiddenRows>::Gameboard()
 {
 	empty();
 }
@@ -16,62 +146,266 @@ Gameboard::Gameboard()
 
 // Getters ---------------------------------
 
-int Gameboard::getContent(const Point& point) const
+template <int Width, int Height, int HiddenRows>
+int Gameboard<Width, Height, HiddenRows>::getContent(const Point& point) const
 {
 	assert(isValidPoint(point) && "Invalid Point."); // Invalid Point
 
-	return grid[point.getY()][point.getX()];
+	return grid[storageRow(point.getY())][point.getX()];
 }
 
-int Gameboard::getContent(const int x, const int y) const
+template <int Width, int Height, int HiddenRows>
+int Gameboard<Width, Height, HiddenRows>::getContent(const int x, const int y) const
 {
 	assert(isValidPoint(x,y) && "Invalid Point."); // Invalid Point
 
-	return grid[y][x];
+	return grid[storageRow(y)][x];
+}
+
+template <int Width, int Height, int HiddenRows>
+int Gameboard<Width, Height, HiddenRows>::getColumnHeight(const int x) const
+{
+	assert(isValidPoint(x, 0) && "Invalid Column Index."); // Invalid Column Index
+
+	return columnHeight[x];
+}
+
+template <int Width, int Height, int HiddenRows>
+int Gameboard<Width, Height, HiddenRows>::getRowFillCount(const int y) const
+{
+	assert(isValidPoint(0, y) && "Invalid Row Index."); // Invalid Row Index
+
+	return static_cast<int>(std::bitset<MAX_X>(rowMask[storageRow(y)]).count());
+}
+
+template <int Width, int Height, int HiddenRows>
+int Gameboard<Width, Height, HiddenRows>::getDropDistance(const int x, const int y) const
+{
+	assert(isValidPoint(x, 0) && "Invalid Column Index."); // Invalid Column Index
+
+	// Only keep the blocks strictly below y
+	const int row{storageRow(y)};
+	const ColumnMask blocksBelow{(row < 0) ? columnMask[x] : columnMask[x] & ~((ColumnMask{2} << row) - 1)};
+
+	if (blocksBelow == 0)
+	{
+		return MAX_Y - 1 - y;
+	}
+
+	return lowestSetBit(blocksBelow) - row - 1;
 }
 
 
 // Setters ---------------------------------
 
-void Gameboard::setContent(const Point& point, const int content)
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::setContent(const Point& point, const int content)
 {
 	if (isValidPoint(point))
 	{
-		grid[point.getY()][point.getX()] = content;
+		setBlock(point.getX(), point.getY(), content);
 	}
 }
 
-void Gameboard::setContent(const int x, const int y, const int content)
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::setContent(const int x, const int y, const int content)
 {
 	if (isValidPoint(x, y))
 	{
-		grid[y][x] = content;
+		setBlock(x, y, content);
 	}
 }
 
-void Gameboard::setContent(const std::vector<Point>& locs, const int content)
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::setContent(const Point locs[], const int count, const int content)
 {
-	for (int i{0}; i < static_cast<int>(locs.size()); i++)
+	for (int i{0}; i < count; i++)
 	{
 		if (isValidPoint(locs[i].getX(), locs[i].getY()))
 		{
-			grid[locs[i].getY()][locs[i].getX()] = content;
+			setBlock(locs[i].getX(), locs[i].getY(), content);
+		}
+	}
+}
+
+
+// Serialization ---------------------------------
+
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::pack(PackedBoard& packed) const
+{
+	// The row masks are the occupancy already
+	packRowMasks(rowMask, packed);
+}
+
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::pack(PackedBoard& packed, PackedColors& colors) const
+{
+	pack(packed);
+
+	// The color masks are the planes already
+	colors = PackedColors{};
+
+	for (int bit{0}; bit < COLOR_BITS; bit++)
+	{
+		packBitRows<MAX_X>(colors.planes[bit], colorMask[bit], std::make_integer_sequence<int, TOTAL_ROWS>{});
+	}
+}
+
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::unpack(const PackedBoard& packed, const int content)
+{
+	// Every non-empty block has the same content bits
+	PackedColors colors;
+
+	for (int bit{0}; bit < COLOR_BITS; bit++)
+	{
+		const std::uint64_t bitSet{((content >> bit) & 1) != 0 ? ~std::uint64_t{0} : 0};
+
+		for (int i{0}; i < PACKED_WORDS; i++)
+		{
+			colors.planes[bit][i] = packed.occupancy[i] & bitSet;
 		}
 	}
+
+	unpackRows(packed, colors);
+}
+
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::unpack(const PackedBoard& packed, const PackedColors& colors)
+{
+	unpackRows(packed, colors);
+}
+
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::packRowMasks(const RowMask rowMasks[TOTAL_ROWS], PackedBoard& packed)
+{
+	packed = PackedBoard{};
+
+	packBitRows<MAX_X>(packed.occupancy, rowMasks, std::make_integer_sequence<int, TOTAL_ROWS>{});
+}
+
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::unpackRowMasks(const PackedBoard& packed, RowMask rowMasks[TOTAL_ROWS])
+{
+	unpackBitRows<MAX_X>(packed.occupancy, rowMasks, std::make_integer_sequence<int, TOTAL_ROWS>{});
+}
+
+template <int Width, int Height, int HiddenRows>
+std::string Gameboard<Width, Height, HiddenRows>::toText() const
+{
+	std::string text;
+
+	// From the highest non-empty row down
+	int row{0};
+
+	while ((row < TOTAL_ROWS) && (rowMask[row] == 0))
+	{
+		row++;
+	}
+
+	for (; row < TOTAL_ROWS; row++)
+	{
+		for (int x{0}; x < MAX_X; x++)
+		{
+			text += (grid[row][x] == EMPTY_BLOCK) ? EMPTY_LETTER : BLOCK_LETTERS[grid[row][x] & 7];
+		}
+
+		if (row < TOTAL_ROWS - 1)
+		{
+			text += '/';
+		}
+	}
+
+	return text;
+}
+
+template <int Width, int Height, int HiddenRows>
+bool Gameboard<Width, Height, HiddenRows>::fromText(const std::string& text)
+{
+	std::vector<std::string> rows;
+	std::string row;
+
+	for (std::size_t i{0}; i <= text.size(); i++)
+	{
+		if ((i == text.size()) || (text[i] == '/') || (text[i] == '\n'))
+		{
+			if (!row.empty())
+			{
+				rows.push_back(row);
+			}
+
+			row.clear();
+		}
+		else if (text[i] != '\r')
+		{
+			row += text[i];
+		}
+	}
+
+	if (static_cast<int>(rows.size()) > TOTAL_ROWS)
+	{
+		return false;
+	}
+
+	// The rows given are the bottom rows
+	Gameboard parsed;
+	const int firstRow{MAX_Y - static_cast<int>(rows.size())};
+	const std::string letters{BLOCK_LETTERS};
+
+	for (int i{0}; i < static_cast<int>(rows.size()); i++)
+	{
+		if (static_cast<int>(rows[i].size()) != MAX_X)
+		{
+			return false;
+		}
+
+		for (int x{0}; x < MAX_X; x++)
+		{
+			const std::size_t content{letters.find(rows[i][x])};
+
+			if (content != std::string::npos)
+			{
+				parsed.setBlock(x, firstRow + i, static_cast<int>(content));
+			}
+			else if (rows[i][x] != EMPTY_LETTER)
+			{
+				return false;
+			}
+		}
+	}
+
+	*this = parsed;
+
+	return true;
 }
 
 
 // Other Methods ---------------------------------
 
-void Gameboard::empty()
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::empty()
 {
-	for (int i{ 0 }; i < MAX_Y; i++)
+	for (int i{ -HIDDEN_ROWS }; i < MAX_Y; i++)
 	{
 		fillRow(i, EMPTY_BLOCK);
+		rowMask[storageRow(i)] = 0;
+
+		for (int bit{0}; bit < COLOR_BITS; bit++)
+		{
+			colorMask[bit][storageRow(i)] = 0;
+		}
+	}
+
+	for (int i{ 0 }; i < MAX_X; i++)
+	{
+		columnHeight[i] = 0;
+		columnMask[i] = 0;
 	}
 }
 
-bool Gameboard::areAllLocsEmpty(const std::vector<Point>& locs) const
+template <int Width, int Height, int HiddenRows>
+bool Gameboard<Width, Height, HiddenRows>::areAllLocsEmpty(const std::vector<Point>& locs) const
 {
 	for (int i{0}; i < static_cast<int>(locs.size()); i++)
 	{
@@ -85,35 +419,137 @@ bool Gameboard::areAllLocsEmpty(const std::vector<Point>& locs) const
 }
 
 
-int Gameboard::removeCompletedRows()
+template <int Width, int Height, int HiddenRows>
+int Gameboard<Width, Height, HiddenRows>::removeCompletedRows()
 {
-	const std::vector<int> completedRows = getCompletedRowIndices();
+	const ColumnMask completedRows{getCompletedRows()};
 
 	removeRows(completedRows);
 
-	return static_cast<int>(completedRows.size());
+	return static_cast<int>(std::bitset<TOTAL_ROWS>(completedRows).count());
 }
 
+template <int Width, int Height, int HiddenRows>
+int Gameboard<Width, Height, HiddenRows>::removeCompletedRows(const Point touchedLocs[], const int count)
+{
+	ColumnMask removedRows;
+
+	return removeCompletedRows(touchedLocs, count, removedRows);
+}
 
-Point Gameboard::getSpawnLoc() const
+template <int Width, int Height, int HiddenRows>
+int Gameboard<Width, Height, HiddenRows>::removeCompletedRows(const Point touchedLocs[], const int count, ColumnMask& removedRows)
 {
-	return spawnLoc;
+	removedRows = getCompletedRows(touchedLocs, count);
+
+	removeRows(removedRows);
+
+	return static_cast<int>(std::bitset<TOTAL_ROWS>(removedRows).count());
 }
 
 
-void Gameboard::printToConsole() const
+template <int Width, int Height, int HiddenRows>
+bool Gameboard<Width, Height, HiddenRows>::insertGarbageRows(int rows, const int holeColumn, const int content)
 {
-	for (int y{0}; y < MAX_Y; y++)
+	assert(isValidPoint(holeColumn, 0) && "Invalid Column Index."); // Invalid Column Index
+
+	rows = std::min(rows, TOTAL_ROWS);
+
+	if (rows <= 0)
+	{
+		return true;
+	}
+
+	// The top rows are pushed off the board
+	bool blocksLost{false};
+
+	for (int i{0}; i < rows; i++)
+	{
+		blocksLost = blocksLost || (rowMask[i] != 0);
+	}
+
+	// Shift the stored rows up (towards index 0)
+	std::copy(&grid[rows][0], &grid[0][0] + TOTAL_ROWS * MAX_X, &grid[0][0]);
+	std::copy(rowMask + rows, rowMask + TOTAL_ROWS, rowMask);
+
+	for (int bit{0}; bit < COLOR_BITS; bit++)
+	{
+		std::copy(colorMask[bit] + rows, colorMask[bit] + TOTAL_ROWS, colorMask[bit]);
+	}
+
+	const RowMask garbageRowMask{static_cast<RowMask>(FULL_ROW_MASK & ~(RowMask{1} << holeColumn))};
+
+	for (int row{TOTAL_ROWS - rows}; row < TOTAL_ROWS; row++)
+	{
+		std::fill(grid[row], grid[row] + MAX_X, static_cast<Block>(content));
+		grid[row][holeColumn] = EMPTY_BLOCK;
+		rowMask[row] = garbageRowMask;
+
+		for (int bit{0}; bit < COLOR_BITS; bit++)
+		{
+			colorMask[bit][row] = ((content >> bit) & 1) != 0 ? garbageRowMask : RowMask{0};
+		}
+	}
+
+	// Column bit row + HIDDEN_ROWS moves to bit row + HIDDEN_ROWS - rows, and the garbage fills the bottom bits
+	//  (a shift by the full mask width is undefined, so it is done as two shifts)
+	const ColumnMask allRows{~ColumnMask{0} >> (sizeof(ColumnMask) * 8 - TOTAL_ROWS)};
+	const ColumnMask garbageBits{allRows & ~((allRows >> (rows - 1)) >> 1)};
+
+	for (int x{0}; x < MAX_X; x++)
 	{
+		columnMask[x] = ((columnMask[x] >> (rows - 1)) >> 1) | ((x == holeColumn) ? ColumnMask{0} : garbageBits);
+
+		if (columnHeight[x] + rows > TOTAL_ROWS)
+		{
+			updateColumnHeight(x, -HIDDEN_ROWS);
+		}
+		else if (columnHeight[x] > 0)
+		{
+			columnHeight[x] += rows;
+		}
+		else if (x != holeColumn)
+		{
+			columnHeight[x] = rows;
+		}
+	}
+
+	return !blocksLost;
+}
+
+template <int Width, int Height, int HiddenRows>
+Point Gameboard<Width, Height, HiddenRows>::getSpawnLoc() const
+{
+	return Point{MAX_X / 2, 0};
+}
+
+template <int Width, int Height, int HiddenRows>
+bool Gameboard<Width, Height, HiddenRows>::isHiddenRow(const int y)
+{
+	return y < 0;
+}
+
+
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::printToConsole() const
+{
+	for (int y{-HIDDEN_ROWS}; y < MAX_Y; y++)
+	{
+		// Separate the hidden rows from the visible board
+		if ((y == 0) && (HIDDEN_ROWS > 0))
+		{
+			std::cout << std::string(MAX_X * 2, '-') << "\n";
+		}
+
 		for (int x{0}; x < MAX_X; x++)
 		{
-			if (grid[y][x] == EMPTY_BLOCK)
+			if (getContent(x, y) == EMPTY_BLOCK)
 			{
 				std::cout << "." << std::setw(2);
 			}
 			else
 			{
-				std::cout << grid[y][x] << std::setw(2);
+				std::cout << getContent(x, y) << std::setw(2);
 			}
 		}
 
@@ -124,89 +560,310 @@ void Gameboard::printToConsole() const
 
 // PRIVATE METHODS --------------------------------------------------------
 
-bool Gameboard::isValidPoint(const Point& point) const
+template <int Width, int Height, int HiddenRows>
+bool Gameboard<Width, Height, HiddenRows>::isValidPoint(const Point& point) const
 {
 	if (((point.getX() < 0) || (point.getX() >= MAX_X)) ||
-		((point.getY() < 0) || (point.getY() >= MAX_Y)))
+		((point.getY() < -HIDDEN_ROWS) || (point.getY() >= MAX_Y)))
 	{
 		return false;
 	}
 	return true;
 }
 
-bool Gameboard::isValidPoint(const int x, const int y) const
+template <int Width, int Height, int HiddenRows>
+bool Gameboard<Width, Height, HiddenRows>::isValidPoint(const int x, const int y) const
 {
 	if (((x < 0) || (x >= MAX_X)) ||
-		((y < 0) || (y >= MAX_Y)))
+		((y < -HIDDEN_ROWS) || (y >= MAX_Y)))
 	{
 		return false;
 	}
 	return true;
 }
 
+template <int Width, int Height, int HiddenRows>
+int Gameboard<Width, Height, HiddenRows>::storageRow(const int y)
+{
+	return y + HIDDEN_ROWS;
+}
+
 
-bool Gameboard::isRowCompleted(const int rowIndex) const
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::setBlock(const int x, const int y, const int content)
 {
-	assert(isValidPoint(0, rowIndex) && "Invalid Row Index."); // Invalid Row Index
+	const int row{storageRow(y)};
+	const bool wasEmpty{grid[row][x] == EMPTY_BLOCK};
+	const bool isEmpty{content == EMPTY_BLOCK};
 
-	for (int i{0}; i < MAX_X; i++)
+	grid[row][x] = static_cast<Block>(content);
+
+	// Clear the block's content bits, and set the new ones
+	const RowMask blockBit{static_cast<RowMask>(RowMask{1} << x)};
+
+	for (int bit{0}; bit < COLOR_BITS; bit++)
 	{
-		if (grid[rowIndex][i] == EMPTY_BLOCK)
+		const bool bitSet{!isEmpty && (((content >> bit) & 1) != 0)};
+
+		colorMask[bit][row] = static_cast<RowMask>((colorMask[bit][row] & ~blockBit) | (bitSet ? blockBit : RowMask{0}));
+	}
+
+	if (wasEmpty && !isEmpty)
+	{
+		rowMask[row] |= static_cast<RowMask>(RowMask{1} << x);
+		columnHeight[x] = std::max(columnHeight[x], MAX_Y - y);
+		columnMask[x] |= ColumnMask{1} << row;
+	}
+	else if (!wasEmpty && isEmpty)
+	{
+		rowMask[row] &= static_cast<RowMask>(~(RowMask{1} << x));
+		columnMask[x] &= ~(ColumnMask{1} << row);
+
+		// The highest block of the column was removed, find the next one down
+		if (columnHeight[x] == MAX_Y - y)
 		{
-			return false;
+			updateColumnHeight(x, y + 1);
 		}
 	}
+}
 
-	return true;
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::unpackRows(const PackedBoard& packed, const PackedColors& colors)
+{
+	// Empty blocks have no content bits
+	PackedColors planes;
+
+	for (int bit{0}; bit < COLOR_BITS; bit++)
+	{
+		for (int i{0}; i < PACKED_WORDS; i++)
+		{
+			planes.planes[bit][i] = colors.planes[bit][i] & packed.occupancy[i];
+		}
+	}
+
+	unpackRowMasks(packed, rowMask);
+
+	for (int bit{0}; bit < COLOR_BITS; bit++)
+	{
+		unpackBitRows<MAX_X>(planes.planes[bit], colorMask[bit], std::make_integer_sequence<int, TOTAL_ROWS>{});
+	}
+
+	// The grid is stored in the bitfields' block order (n = row * MAX_X + x), so it is filled
+	//  straight from them, 8 blocks (one byte of each bitfield) at a time
+	std::uint8_t* const blocks{reinterpret_cast<std::uint8_t*>(&grid[0][0])};
+
+	for (int i{0}; i < PACKED_WORDS; i++)
+	{
+		std::uint64_t occupied{packed.occupancy[i]};
+		std::uint64_t plane0{planes.planes[0][i]};
+		std::uint64_t plane1{planes.planes[1][i]};
+		std::uint64_t plane2{planes.planes[2][i]};
+
+		for (int firstBlock{i * 64}; firstBlock < std::min(i * 64 + 64, PACKED_BITS); firstBlock += 8)
+		{
+			const std::uint64_t occupiedLanes{SPREAD_TABLE.lanes[occupied & 0xFF]};
+
+			// Empty blocks are EMPTY_BLOCK (-1, every bit set)
+			const std::uint64_t lanes{SPREAD_TABLE.lanes[plane0 & 0xFF] | (SPREAD_TABLE.lanes[plane1 & 0xFF] << 1)
+			                          | (SPREAD_TABLE.lanes[plane2 & 0xFF] << 2) | ((occupiedLanes ^ BYTE_LANES) * 0xFF)};
+
+			if (firstBlock + 8 <= PACKED_BITS)
+			{
+				storeLanes(blocks + firstBlock, lanes);
+			}
+			else
+			{
+				// The last blocks do not fill a word
+				std::uint8_t lastBlocks[8];
+				storeLanes(lastBlocks, lanes);
+				std::memcpy(blocks + firstBlock, lastBlocks, static_cast<std::size_t>(PACKED_BITS - firstBlock));
+			}
+
+			occupied >>= 8;
+			plane0 >>= 8;
+			plane1 >>= 8;
+			plane2 >>= 8;
+		}
+	}
+
+	rebuildColumns();
+}
+
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::rebuildColumns()
+{
+	// 8 rows of 8 columns at a time, so the column masks are built 8 bits (one byte lane) at a time
+	for (int firstRow{0}; firstRow < TOTAL_ROWS; firstRow += 8)
+	{
+		const int endRow{std::min(firstRow + 8, TOTAL_ROWS)};
+
+		for (int word{0}; word < NUM_BLOCK_WORDS; word++)
+		{
+			// Bit row - firstRow of lane x - word * 8 is the block at [x, row] (the last row is shifted the most)
+			std::uint64_t columnLanes{0};
+
+			for (int row{endRow - 1}; row >= firstRow; row--)
+			{
+				columnLanes = (columnLanes << 1) | spreadByte(rowMask[row], word * 8);
+			}
+
+			for (int x{word * 8}; x < std::min(word * 8 + 8, MAX_X); x++)
+			{
+				const ColumnMask rows{static_cast<ColumnMask>(columnLanes & 0xFF)};
+
+				columnMask[x] = (firstRow == 0) ? rows : static_cast<ColumnMask>(columnMask[x] | (rows << firstRow));
+				columnLanes >>= 8;
+			}
+		}
+	}
+
+	// The highest block of each column is its lowest column mask bit
+	for (int x{0}; x < MAX_X; x++)
+	{
+		columnHeight[x] = (columnMask[x] != 0) ? TOTAL_ROWS - lowestSetBit(columnMask[x]) : 0;
+	}
 }
 
-void Gameboard::fillRow(const int rowIndex, const int content)
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::updateColumnHeight(const int x, const int fromRow)
+{
+	for (int y{fromRow}; y < MAX_Y; y++)
+	{
+		if (grid[storageRow(y)][x] != EMPTY_BLOCK)
+		{
+			columnHeight[x] = MAX_Y - y;
+
+			return;
+		}
+	}
+
+	columnHeight[x] = 0;
+}
+
+
+template <int Width, int Height, int HiddenRows>
+bool Gameboard<Width, Height, HiddenRows>::isRowCompleted(const int rowIndex) const
+{
+	assert(isValidPoint(0, rowIndex) && "Invalid Row Index."); // Invalid Row Index
+
+	return rowMask[storageRow(rowIndex)] == FULL_ROW_MASK;
+}
+
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::fillRow(const int rowIndex, const int content)
 {
 	for (int i{0}; i < MAX_X; i++)
 	{
-		grid[rowIndex][i] = content;
+		grid[storageRow(rowIndex)][i] = static_cast<Block>(content);
 	}
 }
 
-std::vector<int> Gameboard::getCompletedRowIndices() const
+template <int Width, int Height, int HiddenRows>
+typename Gameboard<Width, Height, HiddenRows>::ColumnMask Gameboard<Width, Height, HiddenRows>::getCompletedRows() const
 {
-	std::vector<int> completedRows;
+	ColumnMask completedRows{0};
 
-	for (int y = 0; y < MAX_Y; y++)
+	for (int y = -HIDDEN_ROWS; y < MAX_Y; y++)
 	{
 		if (isRowCompleted(y))
 		{
-			completedRows.push_back(y);
+			completedRows |= ColumnMask{1} << storageRow(y);
+		}
+	}
+
+	return completedRows;
+}
+
+template <int Width, int Height, int HiddenRows>
+typename Gameboard<Width, Height, HiddenRows>::ColumnMask Gameboard<Width, Height, HiddenRows>::getCompletedRows(const Point touchedLocs[], const int count) const
+{
+	// A mask, so a row touched by several points is only counted once
+	ColumnMask completedRows{0};
+
+	for (int i{0}; i < count; i++)
+	{
+		const int y{touchedLocs[i].getY()};
+
+		if (isValidPoint(0, y) && isRowCompleted(y))
+		{
+			completedRows |= ColumnMask{1} << storageRow(y);
 		}
 	}
 
 	return completedRows;
 }
 
-void Gameboard::copyRowIntoRow(const int sourceRow, const int targetRow)
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::copyRowIntoRow(const int sourceRow, const int targetRow)
 {
 	for (int y{0}; y < MAX_X; y++)
 	{
-		grid[targetRow][y] = getContent(y, sourceRow);
+		grid[storageRow(targetRow)][y] = grid[storageRow(sourceRow)][y];
 	}
 }
 
-void Gameboard::removeRow(int rowIndex)
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::removeRow(int rowIndex)
 {
 	assert(isValidPoint(0, rowIndex) && "Invalid Row Index."); // Invalid Row Index
 
-	for (int y{--rowIndex}; y >= 0; y--)
+	// Shift the column masks of every row above the removed row down by one
+	const ColumnMask removedRow{ColumnMask{1} << storageRow(rowIndex)};
+	const ColumnMask rowsAbove{removedRow - 1};
+
+	for (int x{0}; x < MAX_X; x++)
+	{
+		columnMask[x] = (columnMask[x] & ~(rowsAbove | removedRow)) | ((columnMask[x] & rowsAbove) << 1);
+	}
+
+	for (int y{--rowIndex}; y >= -HIDDEN_ROWS; y--)
 	{
 		copyRowIntoRow(y, y + 1);
+		rowMask[storageRow(y + 1)] = rowMask[storageRow(y)];
+
+		for (int bit{0}; bit < COLOR_BITS; bit++)
+		{
+			colorMask[bit][storageRow(y + 1)] = colorMask[bit][storageRow(y)];
+		}
 	}
 
-	fillRow(0, EMPTY_BLOCK);
+	fillRow(-HIDDEN_ROWS, EMPTY_BLOCK);
+	rowMask[storageRow(-HIDDEN_ROWS)] = 0;
+
+	for (int bit{0}; bit < COLOR_BITS; bit++)
+	{
+		colorMask[bit][storageRow(-HIDDEN_ROWS)] = 0;
+	}
 }
 
-void Gameboard::removeRows(const std::vector<int>& rowIndices)
+template <int Width, int Height, int HiddenRows>
+void Gameboard<Width, Height, HiddenRows>::removeRows(ColumnMask rows)
 {
-	for (int i{0}; i < static_cast<int>(rowIndices.size()); i++)
+	if (rows == 0)
 	{
-		removeRow(rowIndices[i]);
+		return;
+	}
+
+	// Top row first (removing a row only moves the rows above it)
+	for (; rows != 0; rows &= rows - 1)
+	{
+		removeRow(lowestSetBit(rows) - HIDDEN_ROWS);
+	}
+
+	// Rows only ever move down, so each column's new highest block is at or below its old one
+	for (int x{0}; x < MAX_X; x++)
+	{
+		updateColumnHeight(x, MAX_Y - columnHeight[x]);
 	}
 }
+
+
+// EXPLICIT INSTANTIATIONS ------------------------------------------------
+template class Gameboard<10, 19>;
+template class Gameboard<10, 20>;
+template class Gameboard<10, 40>;
+template class Gameboard<4, 20>;
+template class Gameboard<16, 20>;
+
+static_assert(Gameboard<10, 20>::FULL_ROW_MASK == 0x3FF, "A completed row has exactly one bit per column");
+static_assert(Gameboard<16, 20>::FULL_ROW_MASK == 0xFFFF, "A completed row has exactly one bit per column");
@@ -1,29 +1,98 @@
 // The Gameboard class encapsulates the functionality of the Tetris game board.
+//  - The board dimensions are template parameters, so row storage, masks and
+//     loops are sized at compile time. The member definitions live in
+//     Gameboard.cpp, which explicitly instantiates the supported board sizes.
+//  - Above the visible rows (y >= 0) are HiddenRows buffer rows (y < 0) that
+//     Tetrominos spawn into. They take part in collisions and row removal,
+//     but are not drawn.
 
 #ifndef GAMEBOARD_H
 #define GAMEBOARD_H
 
+#include <cstdint>
+#include <string>
+#include <type_traits>
 #include <vector>
 #include "Point.h"
 
 
+template <int Width, int Height, int HiddenRows = 4>
 class Gameboard
 {
+	static_assert((Width > 0) && (Width <= 64), "Gameboard width must be in [1, 64]");
+	static_assert((Height > 0) && (HiddenRows >= 0) && (Height + HiddenRows <= 64),
+		"Gameboard height (including hidden rows) must be in [1, 64]");
+
 public:
 	// CONSTANTS
-	static constexpr int MAX_Y{19};			// Gameboard y (rows) dimension
-	static constexpr int MAX_X{10};			// Gameboard x (cols) dimension
-	static constexpr int EMPTY_BLOCK{-1};	// Contents of an empty block
+	static constexpr int MAX_Y{Height};					// Gameboard y (visible rows) dimension
+	static constexpr int MAX_X{Width};					// Gameboard x (cols) dimension
+	static constexpr int HIDDEN_ROWS{HiddenRows};		// Rows above the visible board (y in [-HIDDEN_ROWS, 0))
+	static constexpr int TOTAL_ROWS{Height + HiddenRows};	// Visible and hidden rows
+	static constexpr int EMPTY_BLOCK{-1};				// Contents of an empty block
+
+	// Stored content of one block (EMPTY_BLOCK or a small color index), one byte so
+	//  whole boards are cheap to copy (such as rollback snapshots)
+	using Block = std::int8_t;
+
+	// Smallest unsigned types that can hold one bit per column (RowMask) and
+	// one bit per row (ColumnMask)
+	using RowMask = std::conditional_t<(Width <= 16), std::uint16_t,
+		std::conditional_t<(Width <= 32), std::uint32_t, std::uint64_t>>;
+	using ColumnMask = std::conditional_t<(TOTAL_ROWS <= 32), std::uint32_t, std::uint64_t>;
+
+	// A row mask with every column set (a completed row)
+	//  - Complemented as the mask type, since a uint16 is promoted to a signed int first
+	static constexpr RowMask FULL_ROW_MASK{static_cast<RowMask>(static_cast<RowMask>(~RowMask{0}) >> (sizeof(RowMask) * 8 - Width))};
+
+	// Packed board formats (see pack()/ unpack())
+	//  - Bit n of a bitfield is block n, counted row by row from the top left hidden block
+	//     (n = (y + HIDDEN_ROWS) * MAX_X + x), in 64 bit words (least significant bit first)
+	static constexpr int PACKED_BITS{TOTAL_ROWS * MAX_X};			// Bits of a bitfield (one per block)
+	static constexpr int PACKED_WORDS{(PACKED_BITS + 63) / 64};		// 64 bit words of a bitfield
+	static constexpr int COLOR_BITS{3};								// Bits of a packed content (contents 0 - 7)
+	static constexpr int NUM_BLOCK_WORDS{(MAX_X + 7) / 8};			// 64 bit words of a row's blocks (8 per word)
+
+	// The occupancy of every block (bit set if the block is non-empty)
+	struct PackedBoard
+	{
+		std::uint64_t occupancy[PACKED_WORDS];
+	};
+
+	// The content of every block, one bitfield per content bit (0 for empty blocks)
+	struct PackedColors
+	{
+		std::uint64_t planes[COLOR_BITS][PACKED_WORDS];
+	};
+
+	// The text form's letter of each content 0 - 7 (Tetromino::TetColor order, then
+	// garbage, as in fumen), and of an empty block
+	static constexpr char BLOCK_LETTERS[]{"ZLOSIJTX"};
+	static constexpr char EMPTY_LETTER{'.'};
 
 private:
 	// MEMBER VARIABLES -------------------------------------------------------
 
-	// The gameboard - a grid of Y (rows) and X (cols) offsets
-	//  ([0][0] is top left, [MAX_Y-1][MAX_X-1] is bottom right) 
-	int grid[MAX_Y][MAX_X];
+	// The gameboard - a grid of Y (rows) and X (cols) offsets, stored from the top hidden row down
+	//  ([0][0] is the top left hidden block [0, -HIDDEN_ROWS],
+	//   [TOTAL_ROWS-1][MAX_X-1] is the bottom right block [MAX_X-1, MAX_Y-1]) 
+	Block grid[TOTAL_ROWS][MAX_X];
+
+	// Occupancy bitmask of each stored row (bit x is set if the block at [x, y] is non-empty)
+	RowMask rowMask[TOTAL_ROWS];
+
+	// Content bitmasks of each stored row, one per content bit (bit x of colorMask[bit] is
+	//  that bit of the content at [x, y], 0 for an empty block), kept like rowMask so the
+	//  contents are packed without reading the grid
+	RowMask colorMask[COLOR_BITS][TOTAL_ROWS];
+
+	// Height of each column, measured from the bottom of the board up to (and
+	//  including) its highest non-empty block (0 for an empty column, more than
+	//  MAX_Y if the column reaches into the hidden rows)
+	int columnHeight[MAX_X];
 
-	// The gameboard offset to spawn a new Tetromino at
-	const Point spawnLoc{MAX_X / 2, 0};
+	// Occupancy bitmask of each column (bit y + HIDDEN_ROWS is set if the block at [x, y] is non-empty)
+	ColumnMask columnMask[MAX_X];
 
 public:
 	// Constructor ------------------------------------------------------------
@@ -52,6 +121,32 @@ public:
 	// - return: an int, the content from the grid at the specified XY
 	int getContent(int x, int y) const;
 
+	// Get the height of a column (maintained incrementally, O(1).)
+	//  - Assert the column index is valid
+	//
+	// - param 1: an int for X (cols)
+	// - return: an int, the number of rows from the bottom of the board up to
+	//           the highest non-empty block in the column (0 if the column is empty)
+	int getColumnHeight(int x) const;
+
+	// Get the number of non-empty blocks in a row (bit count of the row mask, O(1).)
+	//  - Assert the row index is valid
+	//
+	// - param 1: an int for Y (row)
+	// - return: an int, the count of non-empty blocks in the row
+	int getRowFillCount(int y) const;
+
+	// Get how many rows a block at a given XY location can fall before it
+	// lands on a non-empty block or the bottom of the board.
+	//  - A single lookup in the column's occupancy mask (no row-by-row testing)
+	//  - Rows above the hidden rows (y < -HIDDEN_ROWS) are treated as empty
+	//  - Assert the column index is valid
+	//
+	// - param 1: an int for X (cols)
+	// - param 2: an int for Y (row)
+	// - return: an int, the number of empty rows directly below the block
+	int getDropDistance(int x, int y) const;
+
 
 	// Setters ---------------------------------
 
@@ -69,10 +164,75 @@ public:
 	void setContent(int x, int y, int content);
 
 	// Set the content for a set of points (ignores invalid points.)
+	//  - Takes an array (such as a Tetromino's mapped block locs), so locking needs no allocation
+	//
+	// - param 1: a Point array representing locations
+	// - param 2: an int, the number of locations
+	// - param 3: an int representing the content we want to set.
+	void setContent(const Point locs[], int count, int content);
+
+
+	// Serialization ---------------------------------
+	//  - pack() and unpack() have no branches on the board contents (every block is
+	//     handled the same way, a row or 8 blocks at a time), so they run at a fixed speed
+	//  - The contents must be in [0, 7] (3 bits, only the low 3 bits are kept)
+
+	// Pack the occupancy of the board.
+	//
+	// - param 1: PackedBoard, filled with the occupancy
+	void pack(PackedBoard& packed) const;
+
+	// Pack the occupancy and the contents of the board.
+	//  - Packs the row masks and color masks, so it costs about four times pack() above
+	//
+	// - param 1: PackedBoard, filled with the occupancy
+	// - param 2: PackedColors, filled with the contents
+	void pack(PackedBoard& packed, PackedColors& colors) const;
+
+	// Replace the board with a packed occupancy, every non-empty block set to one content.
+	//  - Also rebuilds every block's content byte, the column masks and the column heights,
+	//     which costs several times the bits themselves (millions of boards a second, not
+	//     tens of millions). Readers that only need the occupancy should use unpackRowMasks()
+	//
+	// - param 1: PackedBoard, the occupancy
+	// - param 2: int, the content of the non-empty blocks (such as garbage)
+	void unpack(const PackedBoard& packed, int content);
+
+	// Replace the board with a packed occupancy and contents (see unpack() above.)
+	//
+	// - param 1: PackedBoard, the occupancy
+	// - param 2: PackedColors, the contents
+	void unpack(const PackedBoard& packed, const PackedColors& colors);
+
+	// Pack row masks into an occupancy, without a board (see pack().)
 	//
-	// - param 1: a vector of Points representing locations
-	// - param 2: an int representing the content we want to set.
-	void setContent(const std::vector<Point>& locs, int content);
+	// - param 1: RowMask array, the occupancy of each stored row (the top hidden row first)
+	// - param 2: PackedBoard, filled with the occupancy
+	static void packRowMasks(const RowMask rowMasks[TOTAL_ROWS], PackedBoard& packed);
+
+	// Unpack an occupancy into row masks only, without a board.
+	//  - Nothing derived is rebuilt (no contents, column masks or heights), so it runs at the
+	//     speed of pack(). For code that works on the row masks (such as GameState)
+	//
+	// - param 1: PackedBoard, the occupancy
+	// - param 2: RowMask array, filled with the occupancy of each stored row (the top hidden row first)
+	static void unpackRowMasks(const PackedBoard& packed, RowMask rowMasks[TOTAL_ROWS]);
+
+	// Get the board as text (for test cases and logs.)
+	//  - One letter per block (see BLOCK_LETTERS, EMPTY_LETTER), rows separated by '/',
+	//     from the highest non-empty row down to the bottom row (an empty board is "")
+	//  - Such as "......Z.../XXXX.XXXXX" for a Z block above a garbage row
+	//
+	// - return: string, the text form
+	std::string toText() const;
+
+	// Replace the board with a text form (see toText().)
+	//  - The rows given are the bottom rows, the rows above them are empty
+	//  - Rows may also be separated by new lines, empty rows (such as a last new line) are skipped
+	//
+	// - param 1: string, the text form
+	// - return: bool, false if the text is invalid (the board is then not changed)
+	bool fromText(const std::string& text);
 
 
 	// Other Methods ---------------------------------
@@ -91,32 +251,100 @@ public:
 	// - return: the count of completed rows removed
 	int removeCompletedRows();
 
-	// Get the spawn location.
+	// Removes the completed rows among the rows touched by a set of points
+	// (such as the block locs of the Tetromino that was just locked.)
+	//  - Only the touched rows are checked, the rest of the board is not scanned
+	//
+	// - param 1: a Point array, the locations that were last set
+	// - param 2: an int, the number of locations
+	// - return: the count of completed rows removed
+	int removeCompletedRows(const Point touchedLocs[], int count);
+
+	// Removes the completed rows among the rows touched by a set of points, and
+	// reports which rows they were (such as for a spectator delta.)
+	//
+	// - param 1: a Point array, the locations that were last set
+	// - param 2: an int, the number of locations
+	// - param 3: ColumnMask, set to the removed rows (bit y + HIDDEN_ROWS, as in the column masks)
+	// - return: the count of completed rows removed
+	int removeCompletedRows(const Point touchedLocs[], int count, ColumnMask& removedRows);
+
+	// Push every row up, and add rows of garbage at the bottom.
+	//  - Rows are moved as whole rows (grid rows and row masks shifted, column masks
+	//     shifted by the row count), not block by block
+	//  - Every garbage block is filled except the hole column
+	//  - Blocks pushed above the top hidden row are lost
+	//  - Assert the hole column is valid
+	//
+	// - param 1: int, the rows of garbage to add (at most TOTAL_ROWS)
+	// - param 2: int, the hole column (x) left empty in every garbage row
+	// - param 3: int, the content of the garbage blocks
+	// - return: bool, false if a non-empty block was pushed off the top of the board
+	bool insertGarbageRows(int rows, int holeColumn, int content);
+
+	// Get the spawn location (the gameboard offset to spawn a new Tetromino at.)
 	//
-	// - returns: spawnLoc
+	// - returns: Point, [MAX_X / 2, 0]
 	Point getSpawnLoc() const;
 
+	// Determine if a given row is above the visible board (one of the hidden rows.)
+	//
+	// - param 1: an int for Y (row)
+	// - return: true if y < 0, false otherwise
+	static bool isHiddenRow(int y);
+
 
-	// Prints the grid contents to the console (for debugging purposes.)
+	// Prints the grid contents to the console, hidden rows first (for debugging purposes.)
 	void printToConsole() const;
 
 
 private:
 	// PRIVATE METHODS --------------------------------------------------------
 
-	// Determine if a given Point is a valid grid location.
+	// Determine if a given Point is a valid grid location (visible or hidden.)
 	//
 	// - param 1: a Point object
 	// - return: true if the point is a valid grid location, false otherwise
 	bool isValidPoint(const Point& point) const;
 
-	// Determine if a given XY is a valid grid location.
+	// Determine if a given XY is a valid grid location (visible or hidden.)
 	//
 	// - param 1: an int representing x
 	// - param 2: an int representing y
 	// - return: true if the x,y is a valid grid location, false otherwise
 	bool isValidPoint(int x, int y) const;
 
+	// Convert a board row (y) into its index in the stored rows.
+	//
+	// - param 1: an int for Y (row), in [-HIDDEN_ROWS, MAX_Y)
+	// - return: an int, the index into grid and rowMask (also the column mask bit)
+	static int storageRow(int y);
+
+
+	// Set the content at a valid XY location, and update the row mask, column
+	// mask and column height for that location.
+	//
+	// - param 1: an int for X (cols)
+	// - param 2: an int for Y (row)
+	// - param 3: an int representing the content we want to set at this location
+	void setBlock(int x, int y, int content);
+
+	// Replace the board with a packed occupancy and contents (see unpack().)
+	//
+	// - param 1: PackedBoard, the occupancy
+	// - param 2: PackedColors, the contents (only read for the non-empty blocks)
+	void unpackRows(const PackedBoard& packed, const PackedColors& colors);
+
+	// Rebuild the column masks and the column heights from the row masks (after unpack().)
+	void rebuildColumns();
+
+	// Recalculate the height of a column by scanning down from a given row.
+	//  - All rows above the given row must be empty in this column
+	//
+	// - param 1: an int for X (cols)
+	// - param 2: an int for Y (row), the row to start scanning from
+	void updateColumnHeight(int x, int fromRow);
+
 
 	// Return a bool indicating if a given row is full (no EMPTY_BLOCK in the row.)
 	//  - Assert the row index is valid
@@ -133,8 +361,15 @@ private:
 
 	// Scan the board for completed rows.
 	//
-	// - return: a vector of completed row indices (integers).
-	std::vector<int> getCompletedRowIndices() const;
+	// - return: ColumnMask, bit y + HIDDEN_ROWS set for each completed row
+	ColumnMask getCompletedRows() const;
+
+	// Check the rows touched by a set of points for completed rows.
+	//
+	// - param 1: a Point array, the locations to take the rows from
+	// - param 2: an int, the number of locations
+	// - return: ColumnMask, bit y + HIDDEN_ROWS set for each completed row
+	ColumnMask getCompletedRows(const Point touchedLocs[], int count) const;
 
 	// Copy a source row's contents into a target row.
 	//
@@ -148,10 +383,20 @@ private:
 	// - param 1: an int representing a row index
 	void removeRow(int rowIndex);
 
-	// Given a vector of row indices, remove them.
+	// Remove a set of rows.
+	//  - Removed from the top (lowest bit) down, so the rows still to remove do not move
+	//  - Updates the column heights once all rows are removed
 	//
-	// - param 1: a vector of integers representing row indices to remove
-	void removeRows(const std::vector<int>& rowIndices);
+	// - param 1: ColumnMask, bit y + HIDDEN_ROWS set for each row to remove
+	void removeRows(ColumnMask rows);
 };
 
+
+// Supported board sizes (instantiated in Gameboard.cpp) ----------------------
+extern template class Gameboard<10, 19>;	// Tetris v2.0 board (matches background_v2.0.png)
+extern template class Gameboard<10, 20>;	// Guideline standard board
+extern template class Gameboard<10, 40>;	// Tall board (garbage modes)
+extern template class Gameboard<4, 20>;		// Narrow board (4-wide)
+extern template class Gameboard<16, 20>;	// Wide board (party modes)
+
 #endif /* GAMEBOARD_H */
@@ -0,0 +1,77 @@
+#include "GarbageQueue.h"
+
+#include <algorithm>
+
+
+// METHODS ----------------------------------------------------------------
+
+void GarbageQueue::push(const int rows, const int holeColumn)
+{
+	if (rows <= 0)
+	{
+		return;
+	}
+
+	if (numBatches == MAX_BATCHES)
+	{
+		batches[numBatches - 1].rows += rows;
+	}
+	else
+	{
+		batches[numBatches++] = Batch{rows, holeColumn};
+	}
+
+	pendingRows += rows;
+}
+
+int GarbageQueue::cancel(int rows)
+{
+	int cancelledBatches{0};
+
+	while ((rows > 0) && (cancelledBatches < numBatches))
+	{
+		Batch& batch{batches[cancelledBatches]};
+		const int cancelled{std::min(rows, batch.rows)};
+
+		batch.rows -= cancelled;
+		pendingRows -= cancelled;
+		rows -= cancelled;
+
+		if (batch.rows == 0)
+		{
+			cancelledBatches++;
+		}
+	}
+
+	// Drop the fully cancelled batches from the front
+	std::copy(batches + cancelledBatches, batches + numBatches, batches);
+	numBatches -= cancelledBatches;
+
+	return rows;
+}
+
+bool GarbageQueue::pop(Batch& batch)
+{
+	if (numBatches == 0)
+	{
+		return false;
+	}
+
+	batch = batches[0];
+	std::copy(batches + 1, batches + numBatches, batches);
+	numBatches--;
+	pendingRows -= batch.rows;
+
+	return true;
+}
+
+int GarbageQueue::getPendingRows() const
+{
+	return pendingRows;
+}
+
+void GarbageQueue::clear()
+{
+	numBatches = 0;
+	pendingRows = 0;
+}
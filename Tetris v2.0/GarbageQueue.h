@@ -0,0 +1,61 @@
+// The GarbageQueue class holds the garbage rows sent to a player that have not been
+// added to their board yet.
+//  - Garbage arrives in batches, each with one hole column shared by all its rows
+//  - Rows the player clears can cancel queued garbage (oldest batch first) before
+//     any attack is sent back
+//  - Fixed size (never allocates), a batch that does not fit is merged into the newest one
+
+#ifndef GARBAGEQUEUE_H
+#define GARBAGEQUEUE_H
+
+
+class GarbageQueue
+{
+public:
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int MAX_BATCHES{16};	// Batches that can be queued at once
+
+	// A batch of garbage rows
+	struct Batch
+	{
+		int rows;			// Rows of garbage
+		int holeColumn;		// The column left empty in every row
+	};
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+	Batch batches[MAX_BATCHES];	// Queued batches, oldest first
+	int numBatches{0};			// Number of queued batches
+	int pendingRows{0};			// Total rows in all queued batches
+
+public:
+	// METHODS ----------------------------------------------------------------
+
+	// Queue a batch of garbage.
+	//
+	// - param 1: int, rows of garbage (ignored if not > 0)
+	// - param 2: int, the hole column
+	void push(int rows, int holeColumn);
+
+	// Cancel queued garbage with an attack, oldest batch first.
+	//
+	// - param 1: int, rows of attack
+	// - return: int, the rows of attack left after cancelling (to send to the opponent)
+	int cancel(int rows);
+
+	// Remove the oldest batch.
+	//
+	// - param 1: Batch, filled with the oldest batch
+	// - return: bool, false if the queue is empty
+	bool pop(Batch& batch);
+
+	// Get the total rows of queued garbage.
+	//
+	// - return: int, rows in all queued batches
+	int getPendingRows() const;
+
+	// Remove all queued garbage
+	void clear();
+};
+
+#endif /* GARBAGEQUEUE_H */
@@ -0,0 +1,59 @@
+#include "GravityCurve.h"
+
+#include <array>
+#include <cassert>
+
+
+namespace
+{
+	using FramesPerRowTable = std::array<std::int32_t, GravityCurve::NUM_LEVELS>;
+
+	// Generate a curve's table at compile time
+	constexpr FramesPerRowTable makeTable(const GravityCurve::Curve curve)
+	{
+		FramesPerRowTable table{};
+
+		for (int i{0}; i < GravityCurve::NUM_LEVELS; i++)
+		{
+			table[i] = (curve == GravityCurve::Curve::GUIDELINE) ? GravityCurve::guidelineFramesPerRow(i + 1)
+			                                                     : GravityCurve::nesFramesPerRow(i + 1);
+		}
+
+		return table;
+	}
+
+	constexpr FramesPerRowTable GUIDELINE_TABLE{makeTable(GravityCurve::Curve::GUIDELINE)};
+	constexpr FramesPerRowTable NES_TABLE{makeTable(GravityCurve::Curve::NES)};
+
+	static_assert(GUIDELINE_TABLE[0] == 60 * GravityCurve::FIXED_ONE, "Guideline level 1 is 1 second per row.");
+	static_assert(GUIDELINE_TABLE[GravityCurve::NUM_LEVELS - 1] == GravityCurve::INSTANT_FRAMES_PER_ROW,
+	              "Guideline gravity must reach 20G.");
+	static_assert((NES_TABLE[0] == 48 * GravityCurve::FIXED_ONE) && (NES_TABLE[9] == 6 * GravityCurve::FIXED_ONE)
+	              && (NES_TABLE[18] == 3 * GravityCurve::FIXED_ONE) && (NES_TABLE[29] == GravityCurve::FIXED_ONE),
+	              "NES frames per row.");
+
+	const FramesPerRowTable& getTable(const GravityCurve::Curve curve)
+	{
+		return (curve == GravityCurve::Curve::GUIDELINE) ? GUIDELINE_TABLE : NES_TABLE;
+	}
+}
+
+
+// STATIC METHODS ---------------------------------------------------------
+
+std::int32_t GravityCurve::getFramesPerRow(const Curve curve, const int level)
+{
+	assert((level >= 1) && "Invalid level.");
+
+	return getTable(curve)[((level < NUM_LEVELS) ? level : NUM_LEVELS) - 1];
+}
+
+double GravityCurve::getSecondsPerRow(const Curve curve, const int level)
+{
+	return static_cast<double>(getFramesPerRow(curve, level)) / (static_cast<double>(FIXED_ONE) * FRAMES_PER_SECOND);
+}
+
+bool GravityCurve::isInstant(const Curve curve, const int level)
+{
+	return getFramesPerRow(curve, level) <= INSTANT_FRAMES_PER_ROW;
+}
@@ -0,0 +1,109 @@
+// The GravityCurve class holds the gravity (fall speed) of every level, generated at compile time:
+//  - GUIDELINE - seconds per row = (0.8 - (level - 1) * 0.007) ^ (level - 1), capped at 20G
+//  - NES       - the NES frames per row (48 at level 1, down to 1 at level 30)
+//
+// Gravity is stored as fixed point frames (1/60 second ticks) per row, so 1G (one
+// row per frame) is FIXED_ONE, and 20G (the shape lands instantly) is FIXED_ONE / 20.
+
+#ifndef GRAVITYCURVE_H
+#define GRAVITYCURVE_H
+
+#include <cstdint>
+
+
+class GravityCurve
+{
+public:
+	// TYPES ------------------------------------------------------------------
+
+	// The selectable gravity curves
+	enum class Curve
+	{
+		GUIDELINE,
+		NES
+	};
+
+
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int NUM_LEVELS{30};			// Levels 1 - NUM_LEVELS
+	static constexpr int FRAMES_PER_SECOND{60};		// Frames (ticks) per second the curves are defined in
+	static constexpr int FIXED_SHIFT{16};			// Fractional bits of a fixed point frame count
+	static constexpr std::int32_t FIXED_ONE{1 << FIXED_SHIFT};	// One frame per row (1G)
+	static constexpr int MAX_ROWS_PER_FRAME{20};	// 20G, the fastest gravity (the shape lands instantly)
+	static constexpr std::int32_t INSTANT_FRAMES_PER_ROW{FIXED_ONE / MAX_ROWS_PER_FRAME};
+
+
+	// STATIC METHODS ---------------------------------------------------------
+
+	// Get the fixed point frames per row of a level (looked up in the compile time table).
+	//  - Levels past NUM_LEVELS use the last level
+	//
+	// - param 1: Curve curve
+	// - param 2: int level (1 - NUM_LEVELS)
+	// - return: int32_t, fixed point frames per row
+	static std::int32_t getFramesPerRow(Curve curve, int level);
+
+	// Get the seconds per row of a level.
+	//
+	// - param 1: Curve curve
+	// - param 2: int level (1 - NUM_LEVELS)
+	// - return: double, seconds per row
+	static double getSecondsPerRow(Curve curve, int level);
+
+	// Determine if a level is 20G (the shape lands as soon as it spawns or moves).
+	//
+	// - param 1: Curve curve
+	// - param 2: int level (1 - NUM_LEVELS)
+	// - return: bool, true if the level is 20G
+	static bool isInstant(Curve curve, int level);
+
+	// The guideline formula, in fixed point frames per row (capped at 20G).
+	//
+	// - param 1: int level (1 or more)
+	// - return: int32_t, fixed point frames per row
+	static constexpr std::int32_t guidelineFramesPerRow(const int level)
+	{
+		const double base{0.8 - (level - 1) * 0.007};
+		double secondsPerRow{1.0};
+
+		for (int i{1}; i < level; i++)
+		{
+			secondsPerRow *= base;
+		}
+
+		const auto framesPerRow{static_cast<std::int32_t>(secondsPerRow * FRAMES_PER_SECOND * FIXED_ONE + 0.5)};
+
+		return (framesPerRow > INSTANT_FRAMES_PER_ROW) ? framesPerRow : INSTANT_FRAMES_PER_ROW;
+	}
+
+	// The NES frames per row, in fixed point (level 1 is NES level 0).
+	//
+	// - param 1: int level (1 or more)
+	// - return: int32_t, fixed point frames per row
+	static constexpr std::int32_t nesFramesPerRow(const int level)
+	{
+		const int nesLevel{level - 1};
+		int frames{1};
+
+		if (nesLevel <= 8)
+		{
+			frames = 48 - (5 * nesLevel);
+		}
+		else if (nesLevel == 9)
+		{
+			frames = 6;
+		}
+		else if (nesLevel <= 18)
+		{
+			frames = 5 - ((nesLevel - 10) / 3);
+		}
+		else if (nesLevel <= 28)
+		{
+			frames = 2;
+		}
+
+		return frames * FIXED_ONE;
+	}
+};
+
+#endif /* GRAVITYCURVE_H */
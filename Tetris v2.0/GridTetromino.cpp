@@ -49,13 +49,13 @@ void GridTetromino::move(const int xOffset, const int yOffset)
 	gridLoc.setXY(gridLoc.getX() + xOffset, gridLoc.getY() + yOffset);
 }
 
-std::vector<Point> GridTetromino::getBlockLocsMappedToGrid() const
+std::array<Point, Tetromino::NUM_BLOCKS> GridTetromino::getBlockLocsMappedToGrid() const
 {
-	std::vector<Point> mappedBlockLocs;
+	std::array<Point, NUM_BLOCKS> mappedBlockLocs;
 
 	for (int i{0}; i < static_cast<int>(blockLocs.size()); i++)
 	{
-		mappedBlockLocs.emplace_back(blockLocs[i].getX() + gridLoc.getX(), blockLocs[i].getY() + gridLoc.getY());
+		mappedBlockLocs[i].setXY(blockLocs[i].getX() + gridLoc.getX(), blockLocs[i].getY() + gridLoc.getY());
 	}
 
 	return mappedBlockLocs;
@@ -3,6 +3,7 @@
 #ifndef GRIDTETROMINO_H
 #define GRIDTETROMINO_H
 
+#include <array>
 #include "Tetromino.h"
 
 
@@ -66,11 +67,12 @@ public:
 	// - param 2: int yOffset, the y (rows) offset (distance) to move
 	void move(int xOffset, int yOffset);
 
-	// Build and return a vector of Points to represent the inherited
-	// blockLocs vector mapped to the gridLoc of this object instance.
+	// Build and return an array of Points to represent the inherited
+	// blockLocs mapped to the gridLoc of this object instance.
+	//  - A fixed size array, so locking a shape needs no allocation
 	//
-	//  - return: a vector of Point objects.
-	std::vector<Point> getBlockLocsMappedToGrid() const;
+	//  - return: an array of NUM_BLOCKS Point objects.
+	std::array<Point, NUM_BLOCKS> getBlockLocsMappedToGrid() const;
 };
 
 #endif /* GRIDTETROMINO_H */
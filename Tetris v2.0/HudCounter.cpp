@@ -0,0 +1,173 @@
+#include "HudCounter.h"
+
+#include <algorithm>
+
+
+// METHODS ----------------------------------------------------------------
+
+void HudCounter::setup(const sf::Font& font, const unsigned int characterSize, const sf::Color& color,
+                       const Point& anchor)
+{
+	static constexpr char CHARACTERS[NUM_GLYPHS]{'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '-'};
+
+	this->characterSize = characterSize;
+	this->color = color;
+	this->anchor = anchor;
+
+	// Cache every glyph first (adding a glyph can grow the font's texture)
+	for (int i{0}; i < NUM_GLYPHS; i++)
+	{
+		const sf::Glyph& glyph{font.getGlyph(static_cast<sf::Uint32>(CHARACTERS[i]), characterSize, false)};
+
+		glyphs[i] = GlyphGeometry{glyph.advance, glyph.bounds, glyph.textureRect};
+	}
+
+	for (int i{0}; i < NUM_GLYPHS; i++)
+	{
+		for (int j{0}; j < NUM_GLYPHS; j++)
+		{
+			kerning[i][j] = font.getKerning(static_cast<sf::Uint32>(CHARACTERS[i]),
+			                                static_cast<sf::Uint32>(CHARACTERS[j]), characterSize);
+		}
+	}
+
+	texture = &font.getTexture(characterSize);
+
+	if (hasValue)
+	{
+		layout();
+	}
+}
+
+void HudCounter::setValue(const int value)
+{
+	if (hasValue && (value == this->value))
+	{
+		return;
+	}
+
+	this->value = value;
+	hasValue = true;
+
+	layout();
+}
+
+void HudCounter::draw(sf::RenderTarget& target) const
+{
+	if (!texture || (numVertices == 0))
+	{
+		return;
+	}
+
+	sf::RenderStates states;
+	states.texture = texture;
+	states.transform.translate(position);
+
+	target.draw(vertices, static_cast<std::size_t>(numVertices), sf::Triangles, states);
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+int HudCounter::getGlyphIndex(const char character)
+{
+	return (character == '-') ? NUM_GLYPHS - 1 : character - '0';
+}
+
+void HudCounter::layout()
+{
+	numVertices = 0;
+
+	if (!texture)
+	{
+		return;
+	}
+
+	// Format the value into a fixed buffer (digits are written from the end)
+	char text[MAX_CHARS];
+	int start{MAX_CHARS};
+	long long remaining{value};
+	const bool negative{remaining < 0};
+
+	if (negative)
+	{
+		remaining = -remaining;
+	}
+
+	do
+	{
+		text[--start] = static_cast<char>('0' + (remaining % 10));
+		remaining /= 10;
+	} while (remaining > 0);
+
+	if (negative)
+	{
+		text[--start] = '-';
+	}
+
+	// Build the quads (as sf::Text does, with 1 pixel of padding), and their bounds
+	constexpr float padding{1.f};
+	const float baseline{static_cast<float>(characterSize)};
+
+	float x{0.f};
+	float minX{0.f};
+	float minY{0.f};
+	float maxX{0.f};
+	float maxY{0.f};
+	int previous{-1};
+
+	for (int i{start}; i < MAX_CHARS; i++)
+	{
+		const int index{getGlyphIndex(text[i])};
+		const GlyphGeometry& glyph{glyphs[index]};
+
+		if (previous >= 0)
+		{
+			x += kerning[previous][index];
+		}
+
+		const float left{x + glyph.bounds.left};
+		const float top{baseline + glyph.bounds.top};
+		const float right{left + glyph.bounds.width};
+		const float bottom{top + glyph.bounds.height};
+
+		if (i == start)
+		{
+			minX = left;
+			minY = top;
+			maxX = right;
+			maxY = bottom;
+		}
+		else
+		{
+			minX = std::min(minX, left);
+			minY = std::min(minY, top);
+			maxX = std::max(maxX, right);
+			maxY = std::max(maxY, bottom);
+		}
+
+		const float u1{static_cast<float>(glyph.textureRect.left) - padding};
+		const float v1{static_cast<float>(glyph.textureRect.top) - padding};
+		const float u2{static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + padding};
+		const float v2{static_cast<float>(glyph.textureRect.top + glyph.textureRect.height) + padding};
+
+		const sf::Vertex topLeft{sf::Vector2f(left - padding, top - padding), color, sf::Vector2f(u1, v1)};
+		const sf::Vertex topRight{sf::Vector2f(right + padding, top - padding), color, sf::Vector2f(u2, v1)};
+		const sf::Vertex bottomLeft{sf::Vector2f(left - padding, bottom + padding), color, sf::Vector2f(u1, v2)};
+		const sf::Vertex bottomRight{sf::Vector2f(right + padding, bottom + padding), color, sf::Vector2f(u2, v2)};
+
+		vertices[numVertices++] = topLeft;
+		vertices[numVertices++] = topRight;
+		vertices[numVertices++] = bottomLeft;
+		vertices[numVertices++] = bottomLeft;
+		vertices[numVertices++] = topRight;
+		vertices[numVertices++] = bottomRight;
+
+		x += glyph.advance;
+		previous = index;
+	}
+
+	// Center on the anchor, as the displays always have (centered on X, bottom on Y)
+	position = sf::Vector2f(static_cast<float>(anchor.getX()) - ((maxX - minX) / 2),
+	                        static_cast<float>(anchor.getY()) - (maxY - minY));
+}
@@ -0,0 +1,84 @@
+// The HudCounter class draws a number on the HUD (such as the score), centered on an anchor.
+//  - Only re-lays out the text when the value changes
+//  - Formats the number into a fixed buffer, and builds its quads into a fixed vertex
+//     array, so updating and drawing never allocate (unlike sf::Text::setString())
+//  - The glyph geometry of every character a number can use is cached by setup()
+
+#ifndef HUDCOUNTER_H
+#define HUDCOUNTER_H
+
+#include <SFML/Graphics.hpp>
+#include "Point.h"
+
+
+class HudCounter
+{
+public:
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int MAX_CHARS{11};		// Longest int ("-2147483648")
+	static constexpr int NUM_GLYPHS{11};	// '0' - '9' and '-'
+
+private:
+	// TYPES ------------------------------------------------------------------
+
+	// The cached geometry of one character
+	struct GlyphGeometry
+	{
+		float advance;			// Horizontal distance to the next character
+		sf::FloatRect bounds;	// Quad, relative to the baseline
+		sf::IntRect textureRect;// Texture coordinates (in pixels) in the font's texture
+	};
+
+
+	// MEMBER VARIABLES -------------------------------------------------------
+
+	const sf::Texture* texture{nullptr};	// The font's texture for the character size (nullptr before setup())
+	GlyphGeometry glyphs[NUM_GLYPHS]{};		// Geometry of each character, by getGlyphIndex()
+	float kerning[NUM_GLYPHS][NUM_GLYPHS]{};// Kerning between each pair of characters
+	unsigned int characterSize{0};			// Character size in pixels
+	sf::Color color;						// Fill color
+	Point anchor;							// Pixel X center, and pixel Y of the bottom of the text
+
+	int value{0};				// The value shown
+	bool hasValue{false};		// False until the first setValue()
+	sf::Vector2f position;		// Pixel top left of the laid out text
+	sf::Vertex vertices[MAX_CHARS * 6];	// Two triangles per character (local coordinates)
+	int numVertices{0};					// Vertices in use
+
+public:
+	// METHODS ----------------------------------------------------------------
+
+	// Set the look and position, and cache the glyph geometry.
+	//
+	// - param 1: the Font (must outlive the counter, and be loaded)
+	// - param 2: unsigned int, the character size in pixels
+	// - param 3: Color, the fill color
+	// - param 4: Point, the pixel X center, and pixel Y of the bottom of the text
+	void setup(const sf::Font& font, unsigned int characterSize, const sf::Color& color, const Point& anchor);
+
+	// Set the value to show.
+	//  - Lays out the text only if the value changed
+	//
+	// - param 1: int, the value
+	void setValue(int value);
+
+	// Draw the value.
+	//
+	// - param 1: the RenderTarget to draw on
+	void draw(sf::RenderTarget& target) const;
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// Get the index into glyphs for a character.
+	//
+	// - param 1: char, '0' - '9' or '-'
+	// - return: int, the index
+	static int getGlyphIndex(char character);
+
+	// Format value and build the vertices, centered on the anchor.
+	void layout();
+};
+
+#endif /* HUDCOUNTER_H */
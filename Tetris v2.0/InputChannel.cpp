@@ -0,0 +1,301 @@
+#include "InputChannel.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "TetrisSimulation.h"
+
+
+static_assert(static_cast<int>(Action::COUNT) <= 8, "Actions are sent as 8 bits");
+
+static constexpr sf::Uint8 PACKET_INPUTS{1};				// The only packet type (for future ones)
+static constexpr sf::Uint32 NO_HASH{0xFFFFFFFFu};			// Hash tick sent when there is no hash yet
+
+
+// NetworkError -----------------------------------------------------------
+
+NetworkError::NetworkError(const std::string& message)
+	: std::runtime_error("Network error: " + message)
+{
+}
+
+
+// Constructor ------------------------------------------------------------
+
+InputChannel::InputChannel(const unsigned short localPort, const sf::IpAddress& remoteAddress,
+                           const unsigned short remotePort, const std::int64_t firstTick)
+	: remoteAddress(remoteAddress), remotePort(remotePort), nextLocalTick(firstTick),
+	  remoteTicksReceived(firstTick), remoteTicksAcked(firstTick)
+{
+	if (socket.bind(localPort) != sf::Socket::Done)
+	{
+		throw NetworkError("could not bind UDP port " + std::to_string(localPort));
+	}
+
+	socket.setBlocking(false);
+
+	std::fill(hashTicks, hashTicks + NUM_HASHES, -1);
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+void InputChannel::addLocalActions(const ActionFrame& frame)
+{
+	addActions(pendingActions, deferredReleases, frame);
+}
+
+void InputChannel::finalizeLocalTick()
+{
+	assert((nextLocalTick < remoteTicksAcked + WINDOW_TICKS) && "The tick would overwrite unacknowledged actions.");
+
+	localFrames[nextLocalTick % WINDOW_TICKS] = pendingActions;
+	nextLocalTick++;
+
+	unsentActions = unsentActions || !pendingActions.pressed.isEmpty() || !pendingActions.released.isEmpty();
+
+	pendingActions = ActionFrame{};
+	pendingActions.released = deferredReleases;
+	deferredReleases.clear();
+}
+
+void InputChannel::receive(const std::int64_t oldestNeededTick)
+{
+	sf::Packet packet;
+	sf::IpAddress sender;
+	unsigned short senderPort;
+
+	while (socket.receive(packet, sender, senderPort) == sf::Socket::Done)
+	{
+		if ((sender == remoteAddress) && (senderPort == remotePort))
+		{
+			readPacket(packet, oldestNeededTick);
+		}
+	}
+}
+
+void InputChannel::sendIfDue(const Clock::time_point now)
+{
+	const Clock::duration sendInterval{std::chrono::microseconds(1000000 * SEND_INTERVAL_TICKS / TetrisSimulation::TICKS_PER_SECOND)};
+
+	if (!started)
+	{
+		started = true;
+		startTime = now;
+		lastSendTime = now;
+		sendCreditTime = now - sendInterval;
+	}
+
+	// Credit is saved up for at most SEND_BURST_PACKETS packets
+	sendCreditTime = std::max(sendCreditTime, now - SEND_BURST_PACKETS * sendInterval);
+
+	// A packet is due every send interval (and then there is always credit for it)
+	if ((now - sendCreditTime >= sendInterval) && (unsentActions || (now - lastSendTime >= sendInterval)))
+	{
+		lastSendTime = now;
+		sendCreditTime += sendInterval;
+		unsentActions = false;
+		sendInputs(now);
+	}
+
+	while (!delayedPackets.empty() && (delayedPackets.front().first <= now))
+	{
+		sendPacket(delayedPackets.front().second);
+		delayedPackets.pop_front();
+	}
+}
+
+void InputChannel::recordHash(const std::int64_t tick, const std::uint32_t hash)
+{
+	const int index{static_cast<int>((tick / HASH_INTERVAL_TICKS) % NUM_HASHES)};
+
+	hashes[index] = hash;
+	hashTicks[index] = tick;
+	latestHashIndex = index;
+}
+
+void InputChannel::checkHash(const std::int64_t hashedUpToTick)
+{
+	if ((remoteHashTick < 0) || (remoteHashTick > hashedUpToTick))
+	{
+		return;
+	}
+
+	const int index{static_cast<int>((remoteHashTick / HASH_INTERVAL_TICKS) % NUM_HASHES)};
+
+	if ((hashTicks[index] == remoteHashTick) && (hashes[index] != remoteHash) && !desynced)
+	{
+		desynced = true;
+		desyncTick = remoteHashTick;
+	}
+
+	remoteHashTick = -1;
+}
+
+void InputChannel::setSimulatedLatency(const Clock::duration latency)
+{
+	simulatedLatency = latency;
+}
+
+const ActionFrame& InputChannel::getLocalFrame(const std::int64_t tick) const
+{
+	assert((tick < nextLocalTick) && (tick >= nextLocalTick - WINDOW_TICKS) && "The local tick is not final or too old.");
+
+	return localFrames[tick % WINDOW_TICKS];
+}
+
+const ActionFrame& InputChannel::getRemoteFrame(const std::int64_t tick) const
+{
+	assert((tick < remoteTicksReceived) && (tick >= remoteTicksReceived - WINDOW_TICKS) && "The remote tick is not known or too old.");
+
+	return remoteFrames[tick % WINDOW_TICKS];
+}
+
+std::int64_t InputChannel::getNextLocalTick() const
+{
+	return nextLocalTick;
+}
+
+std::int64_t InputChannel::getRemoteTicksReceived() const
+{
+	return remoteTicksReceived;
+}
+
+std::int64_t InputChannel::getRemoteTicksAcked() const
+{
+	return remoteTicksAcked;
+}
+
+bool InputChannel::isDesynced() const
+{
+	return desynced;
+}
+
+std::int64_t InputChannel::getDesyncTick() const
+{
+	return desyncTick;
+}
+
+double InputChannel::getBytesSentPerSecond(const Clock::time_point now) const
+{
+	const double seconds{std::chrono::duration<double>(now - startTime).count()};
+
+	return (started && (seconds > 0.0)) ? static_cast<double>(bytesSent) / seconds : 0.0;
+}
+
+std::int64_t InputChannel::getPacketsSent() const
+{
+	return packetsSent;
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+void InputChannel::sendInputs(const Clock::time_point now)
+{
+	// The latest local hash
+	const bool hasHash{latestHashIndex >= 0};
+
+	sf::Packet packet;
+	packet << PACKET_INPUTS
+		<< static_cast<sf::Uint32>(remoteTicksReceived)	// Acknowledges the peer's actions
+		<< static_cast<sf::Uint32>(remoteTicksAcked)		// First tick sent
+		<< static_cast<sf::Uint32>(nextLocalTick)			// One past the last tick sent
+		<< (hasHash ? static_cast<sf::Uint32>(hashTicks[latestHashIndex]) : NO_HASH)
+		<< (hasHash ? static_cast<sf::Uint32>(hashes[latestHashIndex]) : sf::Uint32{0});
+
+	// Only ticks with actions are sent, the others had none
+	sf::Uint8 numFrames{0};
+
+	for (std::int64_t tick{remoteTicksAcked}; tick < nextLocalTick; tick++)
+	{
+		const ActionFrame& frame{localFrames[tick % WINDOW_TICKS]};
+		numFrames += !frame.pressed.isEmpty() || !frame.released.isEmpty();
+	}
+
+	packet << numFrames;
+
+	for (std::int64_t tick{remoteTicksAcked}; tick < nextLocalTick; tick++)
+	{
+		const ActionFrame& frame{localFrames[tick % WINDOW_TICKS]};
+
+		if (!frame.pressed.isEmpty() || !frame.released.isEmpty())
+		{
+			packet << static_cast<sf::Uint8>(tick - remoteTicksAcked)
+				<< static_cast<sf::Uint8>(frame.pressed.getBits())
+				<< static_cast<sf::Uint8>(frame.released.getBits());
+		}
+	}
+
+	if (simulatedLatency > Clock::duration::zero())
+	{
+		delayedPackets.emplace_back(now + simulatedLatency, packet);
+	}
+	else
+	{
+		sendPacket(packet);
+	}
+}
+
+void InputChannel::sendPacket(sf::Packet& packet)
+{
+	if (socket.send(packet, remoteAddress, remotePort) == sf::Socket::Done)
+	{
+		bytesSent += static_cast<std::int64_t>(packet.getDataSize()) + UDP_IP_HEADER_BYTES;
+		packetsSent++;
+	}
+}
+
+void InputChannel::readPacket(sf::Packet& packet, const std::int64_t oldestNeededTick)
+{
+	sf::Uint8 type;
+	sf::Uint32 ack, firstTick, endTick, hashTick, hash;
+	sf::Uint8 numFrames;
+
+	if (!(packet >> type >> ack >> firstTick >> endTick >> hashTick >> hash >> numFrames) || (type != PACKET_INPUTS))
+	{
+		return;
+	}
+
+	// Packets may arrive out of order, only move forward
+	remoteTicksAcked = std::max<std::int64_t>(remoteTicksAcked, std::min<std::int64_t>(ack, nextLocalTick));
+
+	if (hashTick != NO_HASH)
+	{
+		remoteHashTick = hashTick;
+		remoteHash = hash;
+	}
+
+	// New ticks must follow the ones already received, and fit in the window
+	const std::int64_t newEnd{std::min<std::int64_t>(endTick, oldestNeededTick + WINDOW_TICKS)};
+
+	if ((firstTick > remoteTicksReceived) || (newEnd <= remoteTicksReceived))
+	{
+		return;
+	}
+
+	ActionFrame frames[WINDOW_TICKS];	// The packet's actions, by tick - firstTick
+	const std::int64_t numTicks{std::min<std::int64_t>(newEnd - firstTick, WINDOW_TICKS)};
+
+	for (int i{0}; i < numFrames; i++)
+	{
+		sf::Uint8 offset, pressed, released;
+
+		if (!(packet >> offset >> pressed >> released))
+		{
+			return;
+		}
+
+		if (offset < numTicks)
+		{
+			frames[offset] = ActionFrame{ActionSet{pressed}, ActionSet{released}};
+		}
+	}
+
+	for (std::int64_t tick{remoteTicksReceived}; tick < firstTick + numTicks; tick++)
+	{
+		remoteFrames[tick % WINDOW_TICKS] = frames[tick - firstTick];
+	}
+
+	remoteTicksReceived = firstTick + numTicks;
+}
@@ -0,0 +1,204 @@
+// The InputChannel class exchanges the players' actions of a VersusMatch with a remote
+// peer over UDP (the transport shared by LockstepSession and RollbackSession.)
+//  - Each local action is made final for one tick (see finalizeLocalTick()), and the
+//     peer's actions arrive as final ticks in order (see getRemoteTicksReceived())
+//  - Every packet repeats the actions the peer has not acknowledged yet, so lost packets
+//     need no retransmit timers (ticks with no actions are not sent at all)
+//  - The latest local state hash is sent along, and compared with the local hash of the
+//     same tick to detect a desync
+//  - Packets are sent at most once per SEND_INTERVAL_TICKS on average (15 per second),
+//     22 bytes each plus 3 per unacknowledged tick with actions, and 28 bytes of UDP/IP
+//     headers. A tick with actions is sent as soon as it is final while the send credit
+//     allows it (up to SEND_BURST_PACKETS early), later ones wait for the next packet.
+//     Random bots tapping about 25 times a second send about 0.83 KB/s each on loopback,
+//     and 0.88 KB/s with a 100 ms round trip (headers included)
+//  - Non-blocking: nothing waits for the network
+//  - For testing, outgoing packets can be held back by a simulated latency
+
+#ifndef INPUTCHANNEL_H
+#define INPUTCHANNEL_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <SFML/Network.hpp>
+#include "Actions.h"
+
+
+// Thrown when a network session can not be set up
+class NetworkError : public std::runtime_error
+{
+public:
+	// Constructor
+	//
+	// - param 1: string, what failed
+	explicit NetworkError(const std::string& message);
+};
+
+
+class InputChannel
+{
+public:
+	// TYPES ------------------------------------------------------------------
+	using Clock = std::chrono::steady_clock;
+
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int WINDOW_TICKS{128};				// Ticks of actions kept (for stepping and resending)
+	static constexpr int SEND_INTERVAL_TICKS{4};		// Time between packets (15 packets per second)
+	static constexpr int SEND_BURST_PACKETS{2};			// Send credit saved up while idle (for early packets)
+	static constexpr int UDP_IP_HEADER_BYTES{28};		// IPv4 and UDP headers of each packet
+	static constexpr int HASH_INTERVAL_TICKS{60};		// Ticks between state hashes (one per second)
+	static constexpr int NUM_HASHES{8};					// Local hashes kept to compare with late remote ones
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+	sf::UdpSocket socket;					// Non-blocking socket bound to the local port
+	const sf::IpAddress remoteAddress;		// The peer's address
+	const unsigned short remotePort;		// The peer's port
+
+	// Actions of each tick, by tick % WINDOW_TICKS
+	ActionFrame localFrames[WINDOW_TICKS];
+	ActionFrame remoteFrames[WINDOW_TICKS];
+
+	std::int64_t nextLocalTick;			// Local actions are final for the ticks before this one
+	std::int64_t remoteTicksReceived;	// The remote actions are known for the ticks before this one
+	std::int64_t remoteTicksAcked;		// The peer has the local actions for the ticks before this one
+
+	ActionFrame pendingActions;		// Local actions for nextLocalTick
+	ActionSet deferredReleases;		// Releases of actions pressed in the same tick (applied the tick after)
+	bool unsentActions{false};		// True if a tick with actions was made final since the last packet
+
+	// Local state hashes, by (tick / HASH_INTERVAL_TICKS) % NUM_HASHES
+	std::uint32_t hashes[NUM_HASHES]{};
+	std::int64_t hashTicks[NUM_HASHES]{};
+	int latestHashIndex{-1};			// Index of the latest local hash (-1 if none)
+	std::int64_t remoteHashTick{-1};	// Tick of the remote hash not compared yet (-1 if none)
+	std::uint32_t remoteHash{0};		// The remote hash not compared yet
+	bool desynced{false};				// True once a remote hash did not match
+	std::int64_t desyncTick{-1};		// The tick of the first mismatched hash
+
+	bool started{false};				// False until the first sendIfDue()
+	Clock::time_point startTime;		// The time of the first sendIfDue()
+	Clock::time_point lastSendTime;		// When the last packet was sent
+	Clock::time_point sendCreditTime;	// One packet can be sent per send interval past this time
+	std::int64_t bytesSent{0};			// Bytes sent (UDP/IP headers included)
+	std::int64_t packetsSent{0};		// Packets sent
+
+	Clock::duration simulatedLatency{0};						// Time outgoing packets are held back (0 to send at once)
+	std::deque<std::pair<Clock::time_point, sf::Packet>> delayedPackets;	// Held back packets, by send time
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//  - Binds the local port, throws a NetworkError if it can not
+	//
+	// - param 1: unsigned short, the local UDP port
+	// - param 2: IpAddress, the peer's address
+	// - param 3: unsigned short, the peer's UDP port
+	// - param 4: int64_t, the first tick with actions (the ticks before it have none, on both peers)
+	InputChannel(unsigned short localPort, const sf::IpAddress& remoteAddress, unsigned short remotePort,
+	             std::int64_t firstTick);
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Add local actions (made final for nextLocalTick by finalizeLocalTick().)
+	//  - A press and release of the same action are never final in one tick, the
+	//     release is moved to the tick after (so it is not applied first)
+	//
+	// - param 1: ActionFrame, the released and pressed actions
+	void addLocalActions(const ActionFrame& frame);
+
+	// Make the pending local actions final for nextLocalTick, and move to the next tick.
+	void finalizeLocalTick();
+
+	// Read every packet waiting on the socket.
+	//  - Remote ticks that would overwrite actions still needed are dropped (the peer resends them)
+	//
+	// - param 1: int64_t, the oldest tick whose remote actions are still needed
+	void receive(std::int64_t oldestNeededTick);
+
+	// Send a packet if one is due, or if a tick with actions was made final and there is
+	// send credit left (and any held back packets whose simulated latency has passed.)
+	//  - Each packet uses one send interval of credit, so early packets are paid for by
+	//     sending the next ones later, and the rate stays one per SEND_INTERVAL_TICKS
+	//
+	// - param 1: time_point, the current time
+	void sendIfDue(Clock::time_point now);
+
+	// Keep a local state hash to send and compare (call it only with final states.)
+	//
+	// - param 1: int64_t, the tick of the state (a multiple of HASH_INTERVAL_TICKS)
+	// - param 2: uint32_t, the state hash
+	void recordHash(std::int64_t tick, std::uint32_t hash);
+
+	// Compare the remote hash with the local hash of the same tick (once it is known.)
+	//
+	// - param 1: int64_t, the local hashes are recorded for the ticks up to this one
+	void checkHash(std::int64_t hashedUpToTick);
+
+	// Hold back every outgoing packet for a time (to test on loopback as if over a slow link.)
+	//
+	// - param 1: duration, the one way latency to add (0 to send at once)
+	void setSimulatedLatency(Clock::duration latency);
+
+	// Getters ---------------------------------
+
+	// Get the final local actions of a tick.
+	//  - Assert the tick is final and still in the window
+	//
+	// - param 1: int64_t, the tick
+	// - return: ActionFrame, the local actions
+	const ActionFrame& getLocalFrame(std::int64_t tick) const;
+
+	// Get the remote actions of a tick.
+	//  - Assert the tick was received
+	//
+	// - param 1: int64_t, the tick
+	// - return: ActionFrame, the remote actions
+	const ActionFrame& getRemoteFrame(std::int64_t tick) const;
+
+	std::int64_t getNextLocalTick() const;			// Local actions are final for the ticks before this one
+	std::int64_t getRemoteTicksReceived() const;	// The remote actions are known for the ticks before this one
+	std::int64_t getRemoteTicksAcked() const;		// The peer has the local actions for the ticks before this one
+	bool isDesynced() const;						// True once the peers' states differed
+	std::int64_t getDesyncTick() const;				// Get the tick of the first mismatched hash (-1 if none)
+
+	// Get the bytes sent per second since the first sendIfDue().
+	//
+	// - param 1: time_point, the current time
+	// - return: double, bytes per second (UDP/IP headers included)
+	double getBytesSentPerSecond(Clock::time_point now) const;
+
+	// Get the packets sent since the first sendIfDue().
+	//
+	// - return: int64_t, the number of packets
+	std::int64_t getPacketsSent() const;
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// Send the local actions the peer has not acknowledged, the acknowledgement of its
+	// actions, and the latest local hash.
+	//
+	// - param 1: time_point, the current time
+	void sendInputs(Clock::time_point now);
+
+	// Send a packet on the socket, and count it.
+	//
+	// - param 1: Packet, the packet to send
+	void sendPacket(sf::Packet& packet);
+
+	// Read one packet from the peer.
+	//
+	// - param 1: Packet, the received packet
+	// - param 2: int64_t, the oldest tick whose remote actions are still needed
+	void readPacket(sf::Packet& packet, std::int64_t oldestNeededTick);
+};
+
+#endif /* INPUTCHANNEL_H */
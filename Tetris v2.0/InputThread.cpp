@@ -0,0 +1,65 @@
+#include "InputThread.h"
+
+#include <SFML/System/Sleep.hpp>
+
+
+// Constructor ------------------------------------------------------------
+
+InputThread::InputThread(const std::vector<sf::Keyboard::Key>& keys)
+	: keys(keys), keysDown(keys.size(), false)
+{
+	running = true;
+	thread = std::thread(&InputThread::run, this);
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+bool InputThread::poll(InputEvent& event)
+{
+	return events.pop(event);
+}
+
+void InputThread::setFocused(const bool focused)
+{
+	this->focused = focused;
+}
+
+
+// Destructor -------------------------------------------------------------
+
+InputThread::~InputThread()
+{
+	running = false;
+
+	if (thread.joinable())
+	{
+		thread.join();
+	}
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+void InputThread::run()
+{
+	while (running)
+	{
+		const Clock::time_point now{Clock::now()};
+		const bool hasFocus{focused};
+
+		for (int i{0}; i < static_cast<int>(keys.size()); i++)
+		{
+			const bool isDown{hasFocus && sf::Keyboard::isKeyPressed(keys[i])};
+
+			// Only queue changes, and retry a full queue on the next sample
+			if ((isDown != keysDown[i]) && events.push(InputEvent{keys[i], isDown, now}))
+			{
+				keysDown[i] = isDown;
+			}
+		}
+
+		// sf::sleep() raises the Windows timer resolution, so this is ~1 ms, not ~16 ms
+		sf::sleep(sf::microseconds(SAMPLE_INTERVAL_MICROSECONDS));
+	}
+}
@@ -0,0 +1,90 @@
+// The InputThread class samples the keyboard on its own thread and queues
+// timestamped key presses/ releases for the game loop.
+//  - Keys are sampled much faster than the frame rate, so the game loop can
+//     apply each key change at the time it actually happened
+//  - SFML window events can only be polled on the window's thread, so the
+//     keyboard state is read directly (sf::Keyboard::isKeyPressed())
+
+#ifndef INPUTTHREAD_H
+#define INPUTTHREAD_H
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <SFML/Window/Keyboard.hpp>
+#include "SpscQueue.h"
+
+
+class InputThread
+{
+public:
+	// TYPES ------------------------------------------------------------------
+	using Clock = std::chrono::steady_clock;
+
+	// A key press or release, and when it was sampled
+	struct InputEvent
+	{
+		sf::Keyboard::Key key;	// The key that changed
+		bool pressed;			// True if the key went down, false if it went up
+		Clock::time_point time;	// When the change was sampled
+	};
+
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int SAMPLE_INTERVAL_MICROSECONDS{1000};	// Time between keyboard samples
+	static constexpr std::size_t QUEUE_CAPACITY{256};			// Max queued events between game loops
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+	std::vector<sf::Keyboard::Key> keys;	// The keys to sample
+	std::vector<bool> keysDown;				// Last sampled state of each key (input thread only)
+
+	SpscQueue<InputEvent, QUEUE_CAPACITY> events;	// Key changes waiting for the game loop
+
+	std::atomic<bool> focused{true};	// Keys are only sampled while the window has focus
+	std::atomic<bool> running{false};	// False to stop the thread
+	std::thread thread;					// The sampling thread
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//  - Starts the sampling thread
+	//
+	// - param 1: a vector of the keys to sample
+	explicit InputThread(const std::vector<sf::Keyboard::Key>& keys);
+
+	// The thread can not be copied
+	InputThread(const InputThread&) = delete;
+	InputThread& operator=(const InputThread&) = delete;
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Get the next queued key change (game loop thread only.)
+	//
+	// - param 1: an InputEvent to fill with the next key change
+	// - return: true if there was a key change, false if the queue is empty
+	bool poll(InputEvent& event);
+
+	// Set if the window has focus.
+	//  - While unfocused, all held keys are released and no keys are sampled
+	//
+	// - param 1: bool, true if the window has focus
+	void setFocused(bool focused);
+
+
+	// Destructor -------------------------------------------------------------
+
+	// Stops and joins the sampling thread
+	~InputThread();
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// The sampling loop, run on the input thread.
+	void run();
+};
+
+#endif /* INPUTTHREAD_H */
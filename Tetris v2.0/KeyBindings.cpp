@@ -0,0 +1,120 @@
+#include "KeyBindings.h"
+
+
+// Constructor ------------------------------------------------------------
+
+KeyBindings::KeyBindings()
+{
+	unbindAll();
+
+	bind(sf::Keyboard::Up, Action::ROTATE_CLOCKWISE);
+	bind(sf::Keyboard::X, Action::ROTATE_CLOCKWISE);
+	bind(sf::Keyboard::Z, Action::ROTATE_COUNTERCLOCKWISE);
+	bind(sf::Keyboard::A, Action::ROTATE_180);
+	bind(sf::Keyboard::Left, Action::MOVE_LEFT);
+	bind(sf::Keyboard::Down, Action::SOFT_DROP);
+	bind(sf::Keyboard::Right, Action::MOVE_RIGHT);
+	bind(sf::Keyboard::Space, Action::HARD_DROP);
+	bind(sf::Keyboard::C, Action::HOLD);
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+void KeyBindings::bind(const sf::Keyboard::Key key, const Action action)
+{
+	if (isValidKey(key))
+	{
+		actionForKey[key] = static_cast<int>(action);
+	}
+}
+
+void KeyBindings::unbind(const sf::Keyboard::Key key)
+{
+	if (isValidKey(key))
+	{
+		actionForKey[key] = UNBOUND;
+	}
+}
+
+void KeyBindings::unbindAll()
+{
+	for (int i{0}; i < sf::Keyboard::KeyCount; i++)
+	{
+		actionForKey[i] = UNBOUND;
+		keyDown[i] = false;
+	}
+
+	for (int i{0}; i < static_cast<int>(Action::COUNT); i++)
+	{
+		keysDownPerAction[i] = 0;
+	}
+
+	heldActions.clear();
+}
+
+std::vector<sf::Keyboard::Key> KeyBindings::getBoundKeys() const
+{
+	std::vector<sf::Keyboard::Key> keys;
+
+	for (int i{0}; i < sf::Keyboard::KeyCount; i++)
+	{
+		if (actionForKey[i] != UNBOUND)
+		{
+			keys.push_back(static_cast<sf::Keyboard::Key>(i));
+		}
+	}
+
+	return keys;
+}
+
+ActionSet KeyBindings::getHeldActions() const
+{
+	return heldActions;
+}
+
+bool KeyBindings::onKeyChanged(const sf::Keyboard::Key key, const bool pressed, ActionFrame& frame)
+{
+	if (!isValidKey(key) || (actionForKey[key] == UNBOUND) || (keyDown[key] == pressed))
+	{
+		return false;
+	}
+
+	keyDown[key] = pressed;
+
+	const int actionIndex{actionForKey[key]};
+	const auto action{static_cast<Action>(actionIndex)};
+
+	if (pressed)
+	{
+		// Only the first key bound to an action presses it
+		if (keysDownPerAction[actionIndex]++ == 0)
+		{
+			heldActions.add(action);
+			frame.pressed.add(action);
+
+			return true;
+		}
+	}
+	else
+	{
+		// Only the last key bound to an action releases it
+		if (--keysDownPerAction[actionIndex] == 0)
+		{
+			heldActions.remove(action);
+			frame.released.add(action);
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+bool KeyBindings::isValidKey(const sf::Keyboard::Key key)
+{
+	return (key >= 0) && (key < sf::Keyboard::KeyCount);
+}
@@ -0,0 +1,84 @@
+// The KeyBindings class maps keyboard keys to gameplay actions, and tracks
+// which actions are held down.
+//  - A table lookup per key change, remappable at runtime
+//  - Several keys may be bound to the same action, the action is held while
+//     any of them is down
+
+#ifndef KEYBINDINGS_H
+#define KEYBINDINGS_H
+
+#include <vector>
+#include <SFML/Window/Keyboard.hpp>
+#include "Actions.h"
+
+
+class KeyBindings
+{
+public:
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int UNBOUND{-1}; // Table entry for a key with no action
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+	int actionForKey[sf::Keyboard::KeyCount];				// Action (or UNBOUND) for each key
+	bool keyDown[sf::Keyboard::KeyCount];					// True while a key is held down
+	int keysDownPerAction[static_cast<int>(Action::COUNT)];	// Number of held keys bound to each action
+	ActionSet heldActions;									// Actions with at least one key held down
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//  - Sets up the default bindings:
+	//     Up/ X - rotate clockwise, Z - rotate counter-clockwise, A - rotate 180,
+	//     Left/ Right - move, Down - soft drop, Space - hard drop, C - hold
+	KeyBindings();
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Bind a key to an action (replacing the key's previous action.)
+	//  - Bindings should be changed while no keys are held down
+	//
+	// - param 1: the key
+	// - param 2: the action
+	void bind(sf::Keyboard::Key key, Action action);
+
+	// Remove a key's binding.
+	//
+	// - param 1: the key
+	void unbind(sf::Keyboard::Key key);
+
+	// Remove all bindings.
+	void unbindAll();
+
+	// Get the keys that are bound to an action (such as the keys to sample.)
+	//
+	// - return: a vector of keys
+	std::vector<sf::Keyboard::Key> getBoundKeys() const;
+
+	// Get the actions that are currently held down
+	ActionSet getHeldActions() const;
+
+	// Update the key state for a key press/ release, and record any resulting
+	// action change in a frame.
+	//  - Unbound keys and repeated presses are ignored
+	//
+	// - param 1: the key
+	// - param 2: bool, true if the key went down, false if it went up
+	// - param 3: an ActionFrame to add the pressed/ released action to
+	// - return: true if an action was pressed or released
+	bool onKeyChanged(sf::Keyboard::Key key, bool pressed, ActionFrame& frame);
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// Determine if a key can index the tables.
+	//
+	// - param 1: the key
+	// - return: true if the key is in [0, KeyCount)
+	static bool isValidKey(sf::Keyboard::Key key);
+};
+
+#endif /* KEYBINDINGS_H */
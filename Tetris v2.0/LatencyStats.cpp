@@ -0,0 +1,80 @@
+#include "LatencyStats.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+
+// METHODS ----------------------------------------------------------------
+
+void LatencyStats::addSample(const double seconds)
+{
+	const double milliseconds{std::max(seconds * 1000.0, 0.0)};
+
+	count++;
+	totalMilliseconds += milliseconds;
+	maxMilliseconds = std::max(maxMilliseconds, milliseconds);
+
+	buckets[std::min(static_cast<int>(milliseconds / BUCKET_MILLISECONDS), NUM_BUCKETS - 1)]++;
+}
+
+void LatencyStats::addSamples(const LatencyStats& other)
+{
+	count += other.count;
+	totalMilliseconds += other.totalMilliseconds;
+	maxMilliseconds = std::max(maxMilliseconds, other.maxMilliseconds);
+
+	for (int i{0}; i < NUM_BUCKETS; i++)
+	{
+		buckets[i] += other.buckets[i];
+	}
+}
+
+long long LatencyStats::getCount() const
+{
+	return count;
+}
+
+double LatencyStats::getMeanMilliseconds() const
+{
+	if (count == 0)
+	{
+		return 0.0;
+	}
+
+	return totalMilliseconds / static_cast<double>(count);
+}
+
+double LatencyStats::getMaxMilliseconds() const
+{
+	return maxMilliseconds;
+}
+
+double LatencyStats::getPercentileMilliseconds(const double percentile) const
+{
+	const double target{static_cast<double>(count) * percentile / 100.0};
+	long long seen{0};
+
+	for (int i{0}; i < NUM_BUCKETS - 1; i++)
+	{
+		seen += buckets[i];
+
+		if ((seen > 0) && (static_cast<double>(seen) >= target))
+		{
+			return (i + 1) * BUCKET_MILLISECONDS;
+		}
+	}
+
+	return maxMilliseconds;
+}
+
+void LatencyStats::printToConsole(const std::string& name) const
+{
+	std::cout << std::fixed << std::setprecision(2)
+		<< name << ": " << count << " samples"
+		<< ", mean " << getMeanMilliseconds() << " ms"
+		<< ", p50 " << getPercentileMilliseconds(50) << " ms"
+		<< ", p95 " << getPercentileMilliseconds(95) << " ms"
+		<< ", p99 " << getPercentileMilliseconds(99) << " ms"
+		<< ", max " << getMaxMilliseconds() << " ms\n";
+}
@@ -0,0 +1,59 @@
+// The LatencyStats class collects latency samples (such as input-to-photon
+// latency) into a fixed size histogram and reports them.
+//  - Adding a sample never allocates, so it can be called every frame
+
+#ifndef LATENCYSTATS_H
+#define LATENCYSTATS_H
+
+#include <string>
+
+
+class LatencyStats
+{
+public:
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int NUM_BUCKETS{400};				// Number of histogram buckets
+	static constexpr double BUCKET_MILLISECONDS{0.25};	// Width of each bucket (the last bucket holds all larger samples)
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+	long long count{0};				// Number of samples
+	double totalMilliseconds{0.0};	// Sum of all samples
+	double maxMilliseconds{0.0};	// Largest sample
+	long long buckets[NUM_BUCKETS]{};	// Histogram of samples
+
+public:
+	// METHODS ----------------------------------------------------------------
+
+	// Add a sample.
+	//
+	// - param 1: double, the latency in seconds
+	void addSample(double seconds);
+
+	// Add every sample of another LatencyStats (to combine the stats of several sources.)
+	//
+	// - param 1: LatencyStats, the samples to add
+	void addSamples(const LatencyStats& other);
+
+	// Get the number of samples
+	long long getCount() const;
+
+	// Get the mean of all samples, in milliseconds (0 if there are none)
+	double getMeanMilliseconds() const;
+
+	// Get the largest sample, in milliseconds
+	double getMaxMilliseconds() const;
+
+	// Get a percentile of the samples from the histogram.
+	//
+	// - param 1: double, the percentile in [0, 100]
+	// - return: double, the upper bound of the bucket holding the percentile, in milliseconds
+	double getPercentileMilliseconds(double percentile) const;
+
+	// Print the count, mean, p50, p95, p99 and max to the console.
+	//
+	// - param 1: a string, the name of the statistic
+	void printToConsole(const std::string& name) const;
+};
+
+#endif /* LATENCYSTATS_H */
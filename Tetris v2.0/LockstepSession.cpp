@@ -0,0 +1,122 @@
+#include "LockstepSession.h"
+
+#include <algorithm>
+#include <cassert>
+
+
+static_assert(InputChannel::WINDOW_TICKS > 2 * LockstepSession::MAX_INPUT_DELAY_TICKS + InputChannel::SEND_INTERVAL_TICKS,
+              "The window must hold every tick that can be waiting to be stepped or acknowledged");
+
+
+// Constructor ------------------------------------------------------------
+
+LockstepSession::LockstepSession(const int localPlayer, const unsigned short localPort, const sf::IpAddress& remoteAddress,
+                                 const unsigned short remotePort, const std::uint32_t seed, const int inputDelayTicks)
+	: match(seed), localPlayer(localPlayer), inputDelay(std::clamp(inputDelayTicks, 1, MAX_INPUT_DELAY_TICKS)),
+	  channel(localPort, remoteAddress, remotePort, inputDelay)	// The first inputDelay ticks have no actions (on both peers)
+{
+	assert((localPlayer >= 0) && (localPlayer < VersusMatch::NUM_PLAYERS) && "Invalid player.");
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+void LockstepSession::addLocalActions(const ActionFrame& frame)
+{
+	channel.addLocalActions(frame);
+}
+
+void LockstepSession::update(const Clock::time_point now)
+{
+	if (!started)
+	{
+		started = true;
+		startTime = now;
+	}
+
+	channel.receive(match.getTick());
+
+	// Ticks of real time since the start (the match may not run ahead of it)
+	const std::int64_t clockTicks{std::chrono::duration_cast<std::chrono::microseconds>(now - startTime).count()
+	                              * TetrisSimulation::TICKS_PER_SECOND / 1000000};
+
+	for (bool progressed{true}; progressed;)
+	{
+		progressed = false;
+
+		// Local actions are final for a tick once it is due, and at most inputDelay ticks
+		// ahead of the match (and within the resend window)
+		const std::int64_t nextLocalTick{channel.getNextLocalTick()};
+
+		if ((nextLocalTick - inputDelay < clockTicks) && (nextLocalTick <= match.getTick() + inputDelay)
+			&& (nextLocalTick < channel.getRemoteTicksAcked() + InputChannel::WINDOW_TICKS))
+		{
+			channel.finalizeLocalTick();
+			progressed = true;
+		}
+
+		if ((match.getTick() < clockTicks) && (match.getTick() < channel.getNextLocalTick())
+			&& (match.getTick() < channel.getRemoteTicksReceived()) && !match.isOver())
+		{
+			stepMatch();
+			progressed = true;
+		}
+	}
+
+	channel.checkHash(match.getTick());
+	channel.sendIfDue(now);
+}
+
+const VersusMatch& LockstepSession::getMatch() const
+{
+	return match;
+}
+
+int LockstepSession::getLocalPlayer() const
+{
+	return localPlayer;
+}
+
+bool LockstepSession::isDesynced() const
+{
+	return channel.isDesynced();
+}
+
+std::int64_t LockstepSession::getDesyncTick() const
+{
+	return channel.getDesyncTick();
+}
+
+bool LockstepSession::isWaitingForRemote() const
+{
+	return !match.isOver() && (match.getTick() >= channel.getRemoteTicksReceived());
+}
+
+double LockstepSession::getBytesSentPerSecond(const Clock::time_point now) const
+{
+	return channel.getBytesSentPerSecond(now);
+}
+
+std::int64_t LockstepSession::getPacketsSent() const
+{
+	return channel.getPacketsSent();
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+void LockstepSession::stepMatch()
+{
+	const std::int64_t tick{match.getTick()};
+
+	VersusMatch::TickActions actions;
+	actions.players[localPlayer] = channel.getLocalFrame(tick);
+	actions.players[1 - localPlayer] = channel.getRemoteFrame(tick);
+
+	match.step(actions);
+
+	if (match.getTick() % InputChannel::HASH_INTERVAL_TICKS == 0)
+	{
+		channel.recordHash(match.getTick(), match.getStateHash());
+	}
+}
@@ -0,0 +1,101 @@
+// The LockstepSession class plays a VersusMatch against a remote peer over UDP.
+//  - Both peers run the whole (deterministic) match, only the players' actions are sent
+//     (see InputChannel): each local action is scheduled inputDelay ticks ahead, and a
+//     tick is only stepped once both players' actions for it are known
+//  - Every InputChannel::HASH_INTERVAL_TICKS ticks the match state hash is sent, and
+//     compared with the local one to detect a desync
+//  - Non-blocking: update() never waits for the network, it stalls the match instead
+//  - Input delay hides the latency below about inputDelay ticks of round trip, above it
+//     the match stalls (see RollbackSession for high latency links)
+//
+// Note: peers must use the same seed, and the same build (the simulation's timers use doubles).
+
+#ifndef LOCKSTEPSESSION_H
+#define LOCKSTEPSESSION_H
+
+#include <chrono>
+#include <cstdint>
+#include "Actions.h"
+#include "InputChannel.h"
+#include "VersusMatch.h"
+
+
+class LockstepSession
+{
+public:
+	// TYPES ------------------------------------------------------------------
+	using Clock = InputChannel::Clock;
+
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int DEFAULT_INPUT_DELAY_TICKS{6};	// Local actions are applied this many ticks later (100 ms)
+	static constexpr int MAX_INPUT_DELAY_TICKS{30};		// Largest allowed input delay
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+	VersusMatch match;			// The match, stepped in lockstep with the peer
+	const int localPlayer;		// The player index controlled here
+	const int inputDelay;		// Ticks between an action and the tick it is applied on
+
+	InputChannel channel;		// Sends the local actions, and receives the peer's
+
+	bool started{false};				// False until the first update()
+	Clock::time_point startTime;		// The time of the first update() (tick 0)
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//  - Binds the local port, throws a NetworkError if it can not
+	//
+	// - param 1: int, the local player index (0 or 1, the peer must use the other one)
+	// - param 2: unsigned short, the local UDP port
+	// - param 3: IpAddress, the peer's address
+	// - param 4: unsigned short, the peer's UDP port
+	// - param 5: uint32_t, the match seed (the same on both peers)
+	// - param 6: int, the input delay in ticks (the same on both peers)
+	LockstepSession(int localPlayer, unsigned short localPort, const sf::IpAddress& remoteAddress,
+	                unsigned short remotePort, std::uint32_t seed, int inputDelayTicks = DEFAULT_INPUT_DELAY_TICKS);
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Add local actions (applied on the next local tick, inputDelay ticks ahead.)
+	//
+	// - param 1: ActionFrame, the released and pressed actions
+	void addLocalActions(const ActionFrame& frame);
+
+	// Receive the peer's packets, finalize the local ticks that are due, step the
+	// match as far as both players' actions are known, and send a packet if one is due.
+	//  - The match never runs ahead of real time (TetrisSimulation::TICKS_PER_SECOND)
+	//
+	// - param 1: time_point, the current time
+	void update(Clock::time_point now);
+
+	// Getters ---------------------------------
+
+	const VersusMatch& getMatch() const;	// Get the match
+	int getLocalPlayer() const;				// Get the local player index
+	bool isDesynced() const;				// True once the peers' states differed
+	std::int64_t getDesyncTick() const;		// Get the tick of the first mismatched hash (-1 if none)
+	bool isWaitingForRemote() const;		// True if the match is stalled on the peer's actions
+
+	// Get the bytes sent per second since the first update().
+	//
+	// - param 1: time_point, the current time
+	// - return: double, bytes per second (UDP/IP headers included)
+	double getBytesSentPerSecond(Clock::time_point now) const;
+
+	// Get the packets sent since the first update().
+	//
+	// - return: int64_t, the number of packets
+	std::int64_t getPacketsSent() const;
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// Step the match one tick with both players' actions, and keep its hash if one is due.
+	void stepMatch();
+};
+
+#endif /* LOCKSTEPSESSION_H */
@@ -1,14 +1,778 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 #include <SFML/Graphics.hpp>
 
+#include "AssetManager.h"
+#include "BotClient.h"
+#include "GameRenderer.h"
+#include "InputThread.h"
+#include "KeyBindings.h"
+#include "LockstepSession.h"
+#include "MatchServer.h"
+#include "Random.h"
+#include "RenderThread.h"
+#include "RollbackSession.h"
+#include "RolloutEvaluator.h"
+#include "SpectatorClient.h"
+#include "SpectatorServer.h"
 #include "TetrisGame.h"
+#include "TrainingExporter.h"
 
 
-int main()
+// Play a versus match between two random bots, each in its own LockstepSession talking
+// to the other over loopback UDP (headless), and report the bandwidth and any desync.
+//
+// - param 1: double, the longest time to play for (seconds)
+// - return: int, EXIT_SUCCESS if the peers stayed in sync
+static int runLockstepLoopback(const double seconds)
 {
+	const std::uint32_t seed{static_cast<std::uint32_t>(LockstepSession::Clock::now().time_since_epoch().count())};
+
+	std::unique_ptr<LockstepSession> peers[VersusMatch::NUM_PLAYERS];
+
+	try
+	{
+		peers[0] = std::make_unique<LockstepSession>(0, 53001, sf::IpAddress::LocalHost, 53002, seed);
+		peers[1] = std::make_unique<LockstepSession>(1, 53002, sf::IpAddress::LocalHost, 53001, seed);
+	}
+	catch (const NetworkError& error)
+	{
+		std::cerr << error.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	Random bots[VersusMatch::NUM_PLAYERS]{Random{seed + 1}, Random{seed + 2}};
+
+	const LockstepSession::Clock::time_point start{LockstepSession::Clock::now()};
+	LockstepSession::Clock::time_point now{start};
+
+	while ((std::chrono::duration<double>(now - start).count() < seconds)
+		&& !(peers[0]->getMatch().isOver() && peers[1]->getMatch().isOver()))
+	{
+		for (int i{0}; i < VersusMatch::NUM_PLAYERS; i++)
+		{
+			// Tap a random action now and then
+			if (bots[i].nextInt(40) == 0)
+			{
+				ActionFrame tap;
+				tap.pressed.add(static_cast<Action>(bots[i].nextInt(static_cast<int>(Action::COUNT))));
+				tap.released = tap.pressed;
+
+				peers[i]->addLocalActions(tap);
+			}
+
+			peers[i]->update(now);
+		}
+
+		sf::sleep(sf::milliseconds(1));
+		now = LockstepSession::Clock::now();
+	}
+
+	bool inSync{true};
+
+	for (int i{0}; i < VersusMatch::NUM_PLAYERS; i++)
+	{
+		const VersusMatch& match{peers[i]->getMatch()};
+
+		std::cout << "Peer " << i + 1 << ": tick " << match.getTick()
+			<< (!match.isOver() ? " (running)" : (match.getWinner() == VersusMatch::NO_WINNER) ? " (draw)"
+			    : " (player " + std::to_string(match.getWinner() + 1) + " won)")
+			<< ", state hash " << match.getStateHash()
+			<< ", " << peers[i]->getPacketsSent() << " packets, "
+			<< peers[i]->getBytesSentPerSecond(now) << " bytes/s"
+			<< (peers[i]->isDesynced() ? ", DESYNC at tick " + std::to_string(peers[i]->getDesyncTick()) : "") << '\n';
+
+		inSync = inSync && !peers[i]->isDesynced();
+	}
+
+	return inSync ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+// Time saving and restoring the whole match state (what a rollback copies every tick.)
+//
+// - param 1: uint32_t, the match seed
+static void benchmarkSnapshots(const std::uint32_t seed)
+{
+	constexpr int ITERATIONS{1000000};
+	constexpr int NUM_SAVED{16};
+
+	// Play a while, so the boards are not empty
+	VersusMatch match{seed};
+	Random bot{seed};
+
+	for (int i{0}; (i < 600) && !match.isOver(); i++)
+	{
+		VersusMatch::TickActions actions;
+		actions.players[i % VersusMatch::NUM_PLAYERS].pressed.add(static_cast<Action>(bot.nextInt(static_cast<int>(Action::COUNT))));
+		actions.players[(i + 1) % VersusMatch::NUM_PLAYERS].released = actions.players[i % VersusMatch::NUM_PLAYERS].pressed;
+
+		match.step(actions);
+	}
+
+	std::vector<VersusMatch::State> saved(NUM_SAVED, match.getState());
+
+	const auto start{std::chrono::steady_clock::now()};
+
+	for (int i{0}; i < ITERATIONS; i++)
+	{
+		saved[i % NUM_SAVED] = match.getState();
+	}
+
+	const auto saveEnd{std::chrono::steady_clock::now()};
+
+	for (int i{0}; i < ITERATIONS; i++)
+	{
+		match.restoreState(saved[(i * 7) % NUM_SAVED]);
+	}
+
+	const auto restoreEnd{std::chrono::steady_clock::now()};
+
+	std::cout << "Snapshot of " << VersusMatch::NUM_PLAYERS << " players: " << sizeof(VersusMatch::State) << " bytes, save "
+		<< std::chrono::duration<double, std::nano>(saveEnd - start).count() / ITERATIONS << " ns, restore "
+		<< std::chrono::duration<double, std::nano>(restoreEnd - saveEnd).count() / ITERATIONS << " ns (state hash "
+		<< match.getStateHash() << ")\n";
+}
+
+// Play a versus match between two random bots, each in its own RollbackSession talking
+// to the other over loopback UDP with an added latency (headless), and report the
+// rollbacks made and any desync.
+//
+// - param 1: double, the longest time to play for (seconds)
+// - param 2: int, the round trip time to add (milliseconds, half on each peer's packets)
+// - return: int, EXIT_SUCCESS if the peers stayed in sync
+static int runRollbackLoopback(const double seconds, const int roundTripMs)
+{
+	const std::uint32_t seed{static_cast<std::uint32_t>(RollbackSession::Clock::now().time_since_epoch().count())};
+
+	benchmarkSnapshots(seed);
+
+	std::unique_ptr<RollbackSession> peers[VersusMatch::NUM_PLAYERS];
+
+	try
+	{
+		peers[0] = std::make_unique<RollbackSession>(0, 53001, sf::IpAddress::LocalHost, 53002, seed);
+		peers[1] = std::make_unique<RollbackSession>(1, 53002, sf::IpAddress::LocalHost, 53001, seed);
+	}
+	catch (const NetworkError& error)
+	{
+		std::cerr << error.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	for (const auto& peer : peers)
+	{
+		peer->setSimulatedLatency(std::chrono::microseconds(roundTripMs * 500));
+	}
+
+	Random bots[VersusMatch::NUM_PLAYERS]{Random{seed + 1}, Random{seed + 2}};
+
+	const RollbackSession::Clock::time_point start{RollbackSession::Clock::now()};
+	RollbackSession::Clock::time_point now{start};
+	std::int64_t stalledUpdates{0};
+
+	while ((std::chrono::duration<double>(now - start).count() < seconds)
+		&& !(peers[0]->getMatch().isOver() && peers[1]->getMatch().isOver()))
+	{
+		for (int i{0}; i < VersusMatch::NUM_PLAYERS; i++)
+		{
+			// Tap a random action now and then
+			if (bots[i].nextInt(40) == 0)
+			{
+				ActionFrame tap;
+				tap.pressed.add(static_cast<Action>(bots[i].nextInt(static_cast<int>(Action::COUNT))));
+				tap.released = tap.pressed;
+
+				peers[i]->addLocalActions(tap);
+			}
+
+			peers[i]->update(now);
+			stalledUpdates += peers[i]->isWaitingForRemote();
+		}
+
+		sf::sleep(sf::milliseconds(1));
+		now = RollbackSession::Clock::now();
+	}
+
+	bool inSync{true};
+
+	for (int i{0}; i < VersusMatch::NUM_PLAYERS; i++)
+	{
+		const VersusMatch& match{peers[i]->getMatch()};
+		const RollbackSession::Stats& stats{peers[i]->getStats()};
+
+		std::cout << "Peer " << i + 1 << ": tick " << match.getTick()
+			<< (!match.isOver() ? " (running)" : (match.getWinner() == VersusMatch::NO_WINNER) ? " (draw)"
+			    : " (player " + std::to_string(match.getWinner() + 1) + " won)")
+			<< ", confirmed " << peers[i]->getConfirmedTick()
+			<< ", " << stats.rollbacks << " rollbacks ("
+			<< ((stats.rollbacks > 0) ? static_cast<double>(stats.ticksResimulated) / stats.rollbacks : 0.0)
+			<< " ticks on average, longest " << stats.longestRollbackTicks << " ticks in "
+			<< stats.longestRollbackSeconds * 1000000.0 << " us), "
+			<< peers[i]->getBytesSentPerSecond(now) << " bytes/s"
+			<< (peers[i]->isDesynced() ? ", DESYNC at tick " + std::to_string(peers[i]->getDesyncTick()) : "") << '\n';
+
+		inSync = inSync && !peers[i]->isDesynced();
+	}
+
+	std::cout << "Updates stalled on the prediction limit: " << stalledUpdates << '\n';
+
+	return inSync ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Stream a versus match between two random bots to many spectators, all on this machine
+// over loopback TCP (headless), and check every spectator rebuilt the same boards.
+//  - A new match starts whenever one ends
+//
+// - param 1: int, the spectators to connect
+// - param 2: double, the time to play for (seconds)
+// - return: int, EXIT_SUCCESS if every spectator followed the stream
+static int runSpectatorLoopback(const int numSpectators, const double seconds)
+{
+	constexpr unsigned short PORT{53100};
+
+	std::uint32_t seed{static_cast<std::uint32_t>(RollbackSession::Clock::now().time_since_epoch().count())};
+
+	std::unique_ptr<SpectatorServer> server;
+	std::vector<std::unique_ptr<SpectatorClient>> spectators;
+
+	try
+	{
+		server = std::make_unique<SpectatorServer>(PORT, VersusMatch::NUM_PLAYERS);
+
+		for (int i{0}; i < numSpectators; i++)
+		{
+			spectators.push_back(std::make_unique<SpectatorClient>(sf::IpAddress::LocalHost, PORT));
+
+			// Accept now and then, so the listen backlog never fills
+			if (i % 32 == 31)
+			{
+				server->update(sf::Time::Zero);
+			}
+		}
+	}
+	catch (const NetworkError& error)
+	{
+		std::cerr << error.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	VersusMatch match{seed};
+	Random bots{seed + 1};
+	std::int64_t tick{0};		// Ticks streamed (over every match)
+
+	using Clock = RollbackSession::Clock;
+	const Clock::time_point start{Clock::now()};
+	Clock::duration longestServerUpdate{0};
+	bool playing{true};
+
+	// Play, then let the spectators catch up
+	for (Clock::time_point now{start}; std::chrono::duration<double>(now - start).count() < seconds + 1.0; now = Clock::now())
+	{
+		playing = std::chrono::duration<double>(now - start).count() < seconds;
+
+		const std::int64_t clockTicks{std::chrono::duration_cast<std::chrono::microseconds>(now - start).count()
+		                              * TetrisSimulation::TICKS_PER_SECOND / 1000000};
+
+		const Clock::time_point updateStart{Clock::now()};
+		bool stepped{false};
+
+		for (; playing && (tick < clockTicks); tick++)
+		{
+			if (match.isOver())
+			{
+				match = VersusMatch{++seed};
+			}
+
+			// Each bot taps a random action about 6 times a second, and hard drops every half second
+			VersusMatch::TickActions actions;
+
+			for (ActionFrame& frame : actions.players)
+			{
+				if (tick % 30 == 29)
+				{
+					frame.pressed.add(Action::HARD_DROP);
+				}
+				else if (bots.nextInt(10) == 0)
+				{
+					frame.pressed.add(static_cast<Action>(bots.nextInt(static_cast<int>(Action::COUNT))));
+				}
+
+				frame.released = frame.pressed;
+			}
+
+			match.step(actions);
+
+			const TetrisSimulation* const games[VersusMatch::NUM_PLAYERS]{&match.getPlayer(0), &match.getPlayer(1)};
+			server->publish(tick, games);
+			stepped = true;
+		}
+
+		server->update(sf::Time::Zero);
+		longestServerUpdate = std::max(longestServerUpdate, Clock::now() - updateStart);
+
+		// The spectators read once a tick
+		if (stepped || !playing)
+		{
+			for (const auto& spectator : spectators)
+			{
+				spectator->update();
+			}
+		}
+
+		sf::sleep(sf::milliseconds(1));
+	}
+
+	// Every spectator must have rebuilt the boards of the last tick
+	int spectatorsInSync{0};
+	SpectatorClient::Stats totals;
+
+	for (const auto& spectator : spectators)
+	{
+		bool inSync{true};
+
+		for (int board{0}; board < VersusMatch::NUM_PLAYERS; board++)
+		{
+			const TetrisSimulation::Board& gameboard{match.getPlayer(board).getBoard()};
+
+			inSync = inSync && spectator->isSynced(board) && (spectator->getScore(board) == match.getPlayer(board).getLastLock().score);
+
+			for (int y{-TetrisSimulation::Board::HIDDEN_ROWS}; inSync && (y < TetrisSimulation::Board::MAX_Y); y++)
+			{
+				for (int x{0}; x < TetrisSimulation::Board::MAX_X; x++)
+				{
+					inSync = inSync && (spectator->getBoard(board).getContent(x, y) == gameboard.getContent(x, y));
+				}
+			}
+		}
+
+		spectatorsInSync += inSync;
+		totals.keyframes += spectator->getStats().keyframes;
+		totals.deltas += spectator->getStats().deltas;
+		totals.mismatches += spectator->getStats().mismatches;
+	}
+
+	const SpectatorServer::Stats& stats{server->getStats()};
+
+	std::cout << "Server: " << server->getSpectatorCount() << " spectators, " << tick << " ticks, "
+		<< stats.deltasSent << " deltas, " << stats.keyframesSent << " keyframes queued, " << stats.overflows << " overflows, "
+		<< static_cast<double>(stats.bytesSent) / std::max(1, numSpectators) / seconds << " bytes/s per spectator, "
+		<< SpectatorServer::getBytesPerSpectator() << " bytes of memory per spectator, longest update "
+		<< std::chrono::duration<double, std::micro>(longestServerUpdate).count() << " us\n";
+	std::cout << "Spectators: " << spectatorsInSync << " of " << numSpectators << " in sync, " << totals.keyframes
+		<< " keyframes and " << totals.deltas << " deltas applied, " << totals.mismatches << " mismatches\n";
+
+	return ((spectatorsInSync == numSpectators) && (totals.mismatches == 0)) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Run a headless match server until the process is ended, printing its metrics every
+// 10 seconds.
+//
+// - param 1: unsigned short, the TCP port to listen on
+// - param 2: int, the pool's workers (0 for one per hardware thread)
+// - return: int, EXIT_FAILURE if the server could not start
+static int runMatchServer(const unsigned short port, const int numWorkers)
+{
+	std::unique_ptr<MatchServer> server;
+
+	try
+	{
+		server = std::make_unique<MatchServer>(port, numWorkers,
+		                                       static_cast<std::uint32_t>(MatchServer::Clock::now().time_since_epoch().count()));
+	}
+	catch (const NetworkError& error)
+	{
+		std::cerr << error.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "Match server on port " << port << " with " << server->getNumWorkers() << " workers\n";
+
+	MatchServer::Clock::time_point nextReport{MatchServer::Clock::now() + std::chrono::seconds(10)};
+
+	for (;;)
+	{
+		const MatchServer::Clock::time_point now{MatchServer::Clock::now()};
+
+		server->update(now);
+
+		if (now >= nextReport)
+		{
+			server->printMetrics(5);
+			nextReport += std::chrono::seconds(10);
+		}
+
+		sf::sleep(sf::milliseconds(1));
+	}
+}
+
+// Connect scripted bots to a match server, and play for a while.
+//  - The bots are updated every few milliseconds on the calling thread
+//
+// - param 1: IpAddress, the server's address
+// - param 2: unsigned short, the server's TCP port
+// - param 3: int, the bots to connect (two per match)
+// - param 4: double, the time to play for (seconds)
+// - return: int, EXIT_SUCCESS if every bot stayed connected and played
+static int runBots(const sf::IpAddress& address, const unsigned short port, const int numBots, const double seconds)
+{
+	std::vector<std::unique_ptr<BotClient>> bots;
+
+	try
+	{
+		for (int i{0}; i < numBots; i++)
+		{
+			bots.push_back(std::make_unique<BotClient>(address, port, static_cast<std::uint32_t>(i + 1)));
+		}
+	}
+	catch (const NetworkError& error)
+	{
+		std::cerr << error.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	const BotClient::Clock::time_point start{BotClient::Clock::now()};
+	int disconnected{0};
+
+	for (BotClient::Clock::time_point now{start}; std::chrono::duration<double>(now - start).count() < seconds; now = BotClient::Clock::now())
+	{
+		for (auto& bot : bots)
+		{
+			if (bot && !bot->update(now))
+			{
+				bot.reset();
+				disconnected++;
+			}
+		}
+
+		sf::sleep(sf::milliseconds(4));
+	}
+
+	BotClient::Stats totals;
+	int botsPlaying{0};
+
+	for (const auto& bot : bots)
+	{
+		if (bot)
+		{
+			totals.actionsSent += bot->getStats().actionsSent;
+			totals.statesReceived += bot->getStats().statesReceived;
+			totals.roundsPlayed += bot->getStats().roundsPlayed;
+			botsPlaying += (bot->getStats().statesReceived > 0);
+		}
+	}
+
+	std::cout << "Bots: " << botsPlaying << " of " << numBots << " played, " << disconnected << " disconnected, "
+		<< totals.actionsSent << " actions sent, " << totals.statesReceived << " states and "
+		<< totals.roundsPlayed << " round ends received\n";
+
+	return ((botsPlaying == numBots) && (disconnected == 0)) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Host many matches on a headless match server, played by scripted bots over loopback TCP
+// (the bots run on their own thread), and report the server's metrics.
+//
+// - param 1: int, the matches to host (two bots each)
+// - param 2: double, the time to play for (seconds)
+// - return: int, EXIT_SUCCESS if every bot played
+static int runServerLoopback(const int numMatches, const double seconds)
+{
+	constexpr unsigned short PORT{53200};
+
+	std::unique_ptr<MatchServer> server;
+
+	try
+	{
+		server = std::make_unique<MatchServer>(PORT, 0, static_cast<std::uint32_t>(MatchServer::Clock::now().time_since_epoch().count()));
+	}
+	catch (const NetworkError& error)
+	{
+		std::cerr << error.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	int botsResult{EXIT_FAILURE};
+	std::thread botThread([&botsResult, numMatches, seconds]()
+	{
+		botsResult = runBots(sf::IpAddress::LocalHost, PORT, numMatches * VersusMatch::NUM_PLAYERS, seconds);
+	});
+
+	// Serve until the bots are done (and a little longer, so they can leave)
+	const MatchServer::Clock::time_point start{MatchServer::Clock::now()};
+
+	for (MatchServer::Clock::time_point now{start}; std::chrono::duration<double>(now - start).count() < seconds + 5.0; now = MatchServer::Clock::now())
+	{
+		server->update(now);
+		sf::sleep(sf::milliseconds(1));
+	}
+
+	botThread.join();
+	server->printMetrics(5);
+
+	return botsResult;
+}
+
+// Play headless games with a placement policy, write the training data shards, and report
+// the throughput.
+//  - Throws a std::invalid_argument if the settings can not export anything (before any
+//     game is played)
+//
+// - param 1: Settings, what to export
+// - return: int, EXIT_SUCCESS if every shard was written
+static int runExport(const TrainingExporter::Settings& settings)
+{
+	TrainingExporter exporter(settings);
+	TrainingExporter::Result result;
+
+	try
+	{
+		result = exporter.run();
+	}
+	catch (const ExportError& error)
+	{
+		std::cerr << error.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "Exported " << result.records << " records of " << result.games << " games to " << result.shards
+		<< " shards (" << result.bytes / (1024.0 * 1024.0) << " MB) in " << result.seconds << " s: "
+		<< result.records / std::max(result.seconds, 1e-9) << " records/s, "
+		<< result.bytes / (1024.0 * 1024.0) / std::max(result.seconds, 1e-9) << " MB/s\n";
+
+	return EXIT_SUCCESS;
+}
+
+// Play a headless game that picks every placement by rollouts, and report the rollout
+// throughput.
+//
+// - param 1: Settings, how to evaluate each placement
+// - param 2: int, the placements to make
+// - return: int, EXIT_SUCCESS
+static int runRolloutBenchmark(const RolloutEvaluator::Settings& settings, const int placements)
+{
+	RolloutEvaluator evaluator(settings);
+	TetrisSimulation simulation{settings.seed};
+
+	std::int64_t playouts{0};
+	std::int64_t rolloutPlacements{0};
+	std::int64_t minPlayouts{-1};
+	double seconds{0.0};
+	int placed{0};
+
+	for (; (placed < placements) && !simulation.isGameOver(); placed++)
+	{
+		const RolloutEvaluator::Result result{evaluator.evaluate(simulation)};
+
+		if (result.best < 0)
+		{
+			break;
+		}
+
+		for (const RolloutEvaluator::Candidate& candidate : result.candidates)
+		{
+			minPlayouts = (minPlayouts < 0) ? candidate.playouts : std::min(minPlayouts, candidate.playouts);
+		}
+
+		playouts += result.playouts;
+		rolloutPlacements += result.placements;
+		seconds += result.seconds;
+
+		simulation.place(result.candidates[result.best].placement);
+	}
+
+	std::cout << "Placed " << placed << " shapes by rollouts on " << evaluator.getNumWorkers() << " workers: score "
+		<< simulation.getScore() << ", " << simulation.getLines() << " lines" << (simulation.isGameOver() ? " (game over)" : "") << '\n'
+		<< "Rollouts: " << playouts << " (at least " << std::max<std::int64_t>(minPlayouts, 0) << " per candidate), "
+		<< playouts / std::max(seconds, 1e-9) << " rollouts/s, " << rolloutPlacements / std::max(seconds, 1e-9) << " placements/s\n";
+
+	return EXIT_SUCCESS;
+}
+
+// Update a network session, report a new desync, and publish the local player's game.
+//
+// - param 1: Session, a LockstepSession or RollbackSession
+// - param 2: RenderThread, to publish the local player's snapshot to
+template <typename Session>
+static void updateSession(Session& session, RenderThread& renderThread)
+{
+	const bool wasDesynced{session.isDesynced()};
+
+	session.update(Session::Clock::now());	// Step the match as far as the actions are known (or predicted)
+
+	if (session.isDesynced() && !wasDesynced)
+	{
+		std::cerr << "Desync detected at tick " << session.getDesyncTick() << '\n';
+	}
+
+	// Hand the render thread a snapshot of the local player (never waits for drawing)
+	renderThread.publish(session.getMatch().getPlayer(session.getLocalPlayer()));
+}
+
+
+int main(int argc, char* argv[])
+{
+	const RenderThread::Clock::time_point startTime{RenderThread::Clock::now()}; // For the time to first frame
+
 	// _CrtMemDumpAllObjectsSince(NULL); // For detecting memory leaks
 
-	// Seeding the randomizer
-	srand(static_cast<unsigned int>(time(nullptr)));  // NOLINT(cert-msc51-cpp)
+	// Command line modes:
+	//  --lockstep-loopback [seconds]
+	//      Headless bot match between two lockstep peers on this machine
+	//  --rollback-loopback [seconds] [round trip ms]
+	//      Snapshot benchmark, and a headless bot match between two rollback peers on this
+	//      machine with an added latency (100 ms round trip by default)
+	//  --spectator-loopback [spectators] [seconds]
+	//      Headless bot match streamed to many spectators on this machine (1000 by default)
+	//  --server [port] [workers]
+	//      Headless match server (port 53200 and one worker per hardware thread by default)
+	//  --bots <address> <port> <bots> [seconds]
+	//      Scripted bots playing on a match server (two per match)
+	//  --server-loopback [matches] [seconds]
+	//      Headless match server with bots on this machine (200 matches by default)
+	//  --export <path prefix> [records] [random|greedy] [shard MB] [workers]
+	//      Headless games played by a placement policy, written as columnar training data
+	//      shards (1000000 greedy records in 32 MB shards by default)
+	//  --rollout-benchmark [random|greedy] [seconds per placement] [placements] [workers]
+	//      Headless game that picks every placement by Monte Carlo rollouts (random rollouts,
+	//      1 second and 100 placements by default)
+	//  --versus <player 1|2> <local port> <remote address> <remote port> [seed]
+	//      Online versus with rollback (both peers must use the same seed), the window shows the local player
+	//  --versus-lockstep <player 1|2> <local port> <remote address> <remote port> [seed]
+	//      Online versus with input delay only (for low latency links)
+	const std::vector<std::string> args(argv + 1, argv + argc);
+	std::unique_ptr<RollbackSession> session;
+	std::unique_ptr<LockstepSession> lockstepSession;
+
+	try
+	{
+		if (!args.empty() && (args[0] == "--lockstep-loopback"))
+		{
+			return runLockstepLoopback((args.size() > 1) ? std::stod(args[1]) : 10.0);
+		}
+
+		if (!args.empty() && (args[0] == "--rollback-loopback"))
+		{
+			return runRollbackLoopback((args.size() > 1) ? std::stod(args[1]) : 10.0, (args.size() > 2) ? std::stoi(args[2]) : 100);
+		}
+
+		if (!args.empty() && (args[0] == "--spectator-loopback"))
+		{
+			return runSpectatorLoopback((args.size() > 1) ? std::stoi(args[1]) : 1000, (args.size() > 2) ? std::stod(args[2]) : 10.0);
+		}
+
+		if (!args.empty() && (args[0] == "--server"))
+		{
+			return runMatchServer((args.size() > 1) ? static_cast<unsigned short>(std::stoi(args[1])) : 53200,
+			                      (args.size() > 2) ? std::stoi(args[2]) : 0);
+		}
+
+		if (!args.empty() && (args[0] == "--bots"))
+		{
+			if (args.size() < 4)
+			{
+				std::cerr << "Usage: --bots <address> <port> <bots> [seconds]\n";
+				return EXIT_FAILURE;
+			}
+
+			return runBots(sf::IpAddress{args[1]}, static_cast<unsigned short>(std::stoi(args[2])), std::stoi(args[3]),
+			               (args.size() > 4) ? std::stod(args[4]) : 30.0);
+		}
+
+		if (!args.empty() && (args[0] == "--server-loopback"))
+		{
+			return runServerLoopback((args.size() > 1) ? std::stoi(args[1]) : 200, (args.size() > 2) ? std::stod(args[2]) : 10.0);
+		}
+
+		if (!args.empty() && (args[0] == "--export"))
+		{
+			TrainingExporter::Settings settings;
+
+			if ((args.size() < 2) || ((args.size() > 3) && !PlacementPolicy::parseKind(args[3], settings.policy)))
+			{
+				std::cerr << "Usage: --export <path prefix> [records] [random|greedy] [shard MB] [workers]\n";
+				return EXIT_FAILURE;
+			}
+
+			settings.pathPrefix = args[1];
+			settings.records = (args.size() > 2) ? std::stoll(args[2]) : settings.records;
+			settings.shardBytes = (args.size() > 4) ? std::stoll(args[4]) << 20 : settings.shardBytes;
+			settings.numWorkers = (args.size() > 5) ? std::stoi(args[5]) : 0;
+
+			return runExport(settings);
+		}
+
+		if (!args.empty() && (args[0] == "--rollout-benchmark"))
+		{
+			RolloutEvaluator::Settings settings;
+			settings.policy = PlacementPolicy::Kind::RANDOM;
+
+			if ((args.size() > 1) && !PlacementPolicy::parseKind(args[1], settings.policy))
+			{
+				std::cerr << "Usage: --rollout-benchmark [random|greedy] [seconds per placement] [placements] [workers]\n";
+				return EXIT_FAILURE;
+			}
+
+			settings.seconds = (args.size() > 2) ? std::stod(args[2]) : 1.0;
+			settings.numWorkers = (args.size() > 4) ? std::stoi(args[4]) : 0;
+
+			return runRolloutBenchmark(settings, (args.size() > 3) ? std::stoi(args[3]) : 100);
+		}
+
+		if (!args.empty() && ((args[0] == "--versus") || (args[0] == "--versus-lockstep")))
+		{
+			if (args.size() < 5)
+			{
+				std::cerr << "Usage: " << args[0] << " <player 1|2> <local port> <remote address> <remote port> [seed]\n";
+				return EXIT_FAILURE;
+			}
+
+			const int localPlayer{std::stoi(args[1]) - 1};
+			const auto localPort{static_cast<unsigned short>(std::stoi(args[2]))};
+			const sf::IpAddress remoteAddress{args[3]};
+			const auto remotePort{static_cast<unsigned short>(std::stoi(args[4]))};
+			const std::uint32_t seed{(args.size() > 5) ? static_cast<std::uint32_t>(std::stoul(args[5])) : 1};
+
+			if (args[0] == "--versus")
+			{
+				session = std::make_unique<RollbackSession>(localPlayer, localPort, remoteAddress, remotePort, seed);
+			}
+			else
+			{
+				lockstepSession = std::make_unique<LockstepSession>(localPlayer, localPort, remoteAddress, remotePort, seed);
+			}
+		}
+	}
+	catch (const std::exception& error)	// NetworkError, or an invalid number
+	{
+		std::cerr << error.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	// Start loading (decoding) all images, the font and audio on worker threads
+	AssetManager assets;
+
+	// Create the game window (while the assets load)
+	sf::RenderWindow window(sf::VideoMode(983, 799), "Tetris Game Window");
+
+	window.setFramerateLimit(30); // Set a max frame rate of 30 FPS
+	window.setKeyRepeatEnabled(false); // Held keys are timed by the game (DAS/ ARR), not by OS key repeat
+
+	// Only wait for what the first frame needs, the audio keeps loading
+	try
+	{
+		assets.waitForFirstFrameAssets();
+	}
+	catch (const AssetError& error)
+	{
+		std::cerr << error.what() << '\n';
+		return EXIT_FAILURE;
+	}
 
 	// Declaring SFML sprite and textures
 	sf::Sprite blockSprite;			// The Tetromino block sprite
@@ -16,17 +780,16 @@ int main()
 	sf::Sprite backgroundSprite;	// The Background sprite
 	sf::Texture backgroundTexture;	// The Background texture
 
-	// Load images
-	backgroundTexture.loadFromFile("images/background_v2.0.png");	// Load the background image
-	backgroundSprite.setTexture(backgroundTexture);							// Set background image
-
-	blockTexture.loadFromFile("images/tiles.png");				// Load the Tetris block image
-	blockSprite.setTexture(blockTexture);									// Set the Tetris sprite
-
-	// Create the game window
-	sf::RenderWindow window(sf::VideoMode(983, 799), "Tetris Game Window");
+	// Create the textures from the decoded images
+	if (!backgroundTexture.loadFromImage(assets.getImage(AssetManager::ImageId::BACKGROUND))
+		|| !blockTexture.loadFromImage(assets.getImage(AssetManager::ImageId::TILES)))
+	{
+		std::cerr << "Could not create the textures\n";
+		return EXIT_FAILURE;
+	}
 
-	window.setFramerateLimit(30); // Set a max frame rate of 30 FPS
+	backgroundSprite.setTexture(backgroundTexture);	// Set background image
+	blockSprite.setTexture(blockTexture);			// Set the Tetris sprite
 
 	// Set pixel offset - Website to find pixel location: https://pixspy.com/
 	const Point gameboardOffset{332, 135};				// The pixel offset of the top left of the game board 
@@ -38,48 +801,126 @@ int main()
 
 	for (int i = 1; i < TetrisGame::NUM_NEXT_SHAPES; i++)
 	{
-		nextShapeCenter[i] = Point{802, nextShapeCenter[0].getY() + (TetrisGame::NEXT_SHAPE_Y_SPACE * i)};
+		nextShapeCenter[i] = Point{802, nextShapeCenter[0].getY() + (GameRenderer::NEXT_SHAPE_Y_SPACE * i)};
 	}
 
 
-	// Set up a tetris game
-	TetrisGame game(window, blockSprite, gameboardOffset, nextShapeCenter, holdShapeCenter);
+	// Set up a tetris game, and the renderer to draw its snapshots
+	TetrisGame game;
+	GameRenderer renderer(window, blockSprite, backgroundSprite, assets.getFont(), gameboardOffset, nextShapeCenter,
+	                      holdShapeCenter);
+
+	// Map keys to gameplay actions (default bindings)
+	KeyBindings keyBindings;
 
-	// Set up a clock so we can determine seconds per game loop
-	sf::Clock clock;
+	// Sample the bound keys on their own thread, with timestamps
+	InputThread inputThread(keyBindings.getBoundKeys());
 
-	// // Create an event for handling userInput from the GUI (graphical user interface)
-	// sf::Event guiEvent;
+	// Draw and display on a render thread, so the game loop never waits for vsync or the driver
+	window.setActive(false);
+	RenderThread renderThread(window, renderer, startTime);
+	renderThread.publish(game.getSimulation());	// Show the first frame now
+
+	// The game needs its audio from here on
+	try
+	{
+		assets.waitForAll();
+	}
+	catch (const AssetError& error)
+	{
+		std::cerr << error.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	game.setAudio(assets);
+
+	// The time the game has been processed up to
+	InputThread::Clock::time_point gameTime{InputThread::Clock::now()};
+
+	// Advance the game to a point in time
+	auto processGameUntil = [&game, &gameTime](const InputThread::Clock::time_point time)
+	{
+		if (time > gameTime)
+		{
+			game.processGameLoop(std::chrono::duration<float>(time - gameTime).count());
+			gameTime = time;
+		}
+	};
 
 	// The main game loop
 	while (window.isOpen())
 	{
-		// How long since the last loop (fraction of a second)		
-		float elapsedTime = clock.getElapsedTime().asSeconds();
-		clock.restart();
-
-		// Handle any window or keyboard events that have occurred since the last game loop
+		// Handle any window events that have occurred since the last game loop
 		sf::Event event;
 		while (window.pollEvent(event))
 		{
 			if (event.type == sf::Event::Closed) // Handle close button clicked
 			{
+				renderThread.stop();	// Stop drawing before the window closes
 				window.close();
 			}
-			else if (event.type == sf::Event::KeyPressed)
+			else if (event.type == sf::Event::Resized)
+			{
+				renderer.invalidateStaticLayer();	// Re-rasterize the background and titles at the new size
+			}
+			else if (event.type == sf::Event::LostFocus)
+			{
+				inputThread.setFocused(false);	// The input thread also releases the held keys
+			}
+			else if (event.type == sf::Event::GainedFocus)
 			{
-				game.onKeyPressed(event); // Handle key press
+				inputThread.setFocused(true);
 			}
 		}
 
-		game.processGameLoop(elapsedTime); // Handle tetris game logic in here.
+		// Handle the key changes sampled since the last game loop, each at the time it happened
+		InputThread::InputEvent input;
+		while (inputThread.poll(input))
+		{
+			ActionFrame actions;
+
+			if (keyBindings.onKeyChanged(input.key, input.pressed, actions))
+			{
+				if (session)
+				{
+					session->addLocalActions(actions);	// Sent to the peer, applied inputDelay ticks later
+				}
+				else if (lockstepSession)
+				{
+					lockstepSession->addLocalActions(actions);
+				}
+				else
+				{
+					processGameUntil(input.time);
+					game.applyActions(actions); // Handle the pressed/ released action
+				}
 
-		// Draw the game to the screen
-		window.clear(sf::Color::White); // Clear the entire window
-		window.draw(backgroundSprite);	// Draw the background (onto the window) 				
-		game.draw();					// Draw the game (onto the window)
-		window.display();				// Re-display the entire window
+				renderThread.addInputTime(input.time);	// Input-to-photon latency is measured once it is displayed
+			}
+		}
+
+		if (session)
+		{
+			updateSession(*session, renderThread);
+		}
+		else if (lockstepSession)
+		{
+			updateSession(*lockstepSession, renderThread);
+		}
+		else
+		{
+			processGameUntil(InputThread::Clock::now()); // Handle tetris game logic in here.
+
+			// Hand the render thread a snapshot of the game (never waits for drawing)
+			renderThread.publish(game.getSimulation());
+		}
+
+		// Run the game loop at the input sampling rate, not the frame rate
+		sf::sleep(sf::microseconds(InputThread::SAMPLE_INTERVAL_MICROSECONDS));
 	}
 
+	renderThread.stop();
+	renderThread.getInputLatency().printToConsole("Input-to-photon latency");
+
 	return 0;
 }
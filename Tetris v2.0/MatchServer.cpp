@@ -0,0 +1,529 @@
+#include "MatchServer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+
+static constexpr int HEADER_BYTES{2};	// The uint16 payload size before each message
+static constexpr int ACTIONS_BYTES{5};	// Type, pressed and released actions
+
+static constexpr ActionSet::Bits ACTION_BITS{static_cast<ActionSet::Bits>((1u << static_cast<int>(Action::COUNT)) - 1)};
+
+
+// Append an unsigned value to a message, in little endian order.
+//
+// - param 1: vector of bytes, the message
+// - param 2: uint32_t, the value
+// - param 3: int, the bytes to write (1, 2 or 4)
+static void writeUint(std::vector<std::uint8_t>& message, const std::uint32_t value, const int bytes)
+{
+	for (int i{0}; i < bytes; i++)
+	{
+		message.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+	}
+}
+
+// Write the payload size at the start of a message.
+//
+// - param 1: vector of bytes, the whole message
+static void writeSize(std::vector<std::uint8_t>& message)
+{
+	const auto size{static_cast<std::uint16_t>(message.size() - HEADER_BYTES)};
+	message[0] = static_cast<std::uint8_t>(size);
+	message[1] = static_cast<std::uint8_t>(size >> 8);
+}
+
+// Get the ticks of a fixed timestep due in a time.
+//
+// - param 1: duration, the time since tick 0
+// - return: int64_t, the number of ticks
+static std::int64_t getTicksDue(const MatchServer::Clock::duration time)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(time).count() * TetrisSimulation::TICKS_PER_SECOND / 1000000;
+}
+
+
+// Constructor ------------------------------------------------------------
+
+MatchServer::MatchServer(const unsigned short port, const int numWorkers, const std::uint32_t seed)
+	: nextSeed(seed), pool(numWorkers)
+{
+	if (listener.listen(port) != sf::Socket::Done)
+	{
+		throw NetworkError("could not listen on TCP port " + std::to_string(port));
+	}
+
+	listener.setBlocking(false);
+
+	matches.reserve(MAX_MATCHES);
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+void MatchServer::update(const Clock::time_point now)
+{
+	for (std::size_t i{0}; i < matches.size();)
+	{
+		Match& match{*matches[i]};
+
+		// A task owns the match until it is done
+		if (match.running.load(std::memory_order_acquire))
+		{
+			i++;
+			continue;
+		}
+
+		if (match.started)
+		{
+			// A state is due every STATE_INTERVAL_TICKS ticks, and at the end of a round
+			if ((match.match.getTick() >= match.stateSentTick + STATE_INTERVAL_TICKS)
+				|| (match.match.isOver() && (match.stateSentTick != match.match.getTick())))
+			{
+				queueState(match);
+			}
+
+			if (match.match.isOver())
+			{
+				match.metrics.rounds++;
+				startRound(match, now);
+			}
+		}
+		else
+		{
+			// Only to notice the waiting player leaving, the actions are dropped
+			match.closing = match.closing || !receiveActions(match, 0);
+			clearActions(match);
+		}
+
+		for (const auto& client : match.clients)
+		{
+			match.closing = match.closing || (client && !flush(*client));
+		}
+
+		if (match.closing)
+		{
+			for (const auto& client : match.clients)
+			{
+				if (client)
+				{
+					client->socket.disconnect();
+				}
+			}
+
+			finishedMetrics.push_back(match.metrics);
+
+			if (waitingMatch == &match)
+			{
+				waitingMatch = nullptr;
+			}
+
+			// The last match takes its place
+			matches[i] = std::move(matches.back());
+			matches.pop_back();
+			continue;
+		}
+
+		// Read the actions for the tick, and step it on the pool
+		if (match.started && (getTicksDue(now - match.startTime) > match.match.getTick()))
+		{
+			for (int player{0}; player < VersusMatch::NUM_PLAYERS; player++)
+			{
+				match.closing = match.closing || !receiveActions(match, player);
+			}
+
+			match.running.store(true, std::memory_order_relaxed);	// Published to the worker by submit()
+			pool.submit([this, &match]() { stepMatch(match); });
+		}
+
+		i++;
+	}
+
+	acceptClients(now);
+
+	const int queueDepth{pool.getQueueDepth()};
+
+	queueDepthSamples++;
+	totalQueueDepth += queueDepth;
+	maxQueueDepth = std::max(maxQueueDepth, queueDepth);
+}
+
+void MatchServer::printMetrics(const int numMatches)
+{
+	std::vector<MatchMetrics> allMetrics{getMatchMetrics()};
+
+	std::int64_t ticks{0};
+	std::int64_t rounds{0};
+	std::int64_t lateTicks{0};
+	double totalTickSeconds{0.0};
+	double maxTickSeconds{0.0};
+	int maxActionQueueDepth{0};
+	LatencyStats tickLatency;
+
+	for (const MatchMetrics& metrics : allMetrics)
+	{
+		ticks += metrics.ticks;
+		rounds += metrics.rounds;
+		lateTicks += metrics.lateTicks;
+		totalTickSeconds += metrics.totalTickSeconds;
+		maxTickSeconds = std::max(maxTickSeconds, metrics.maxTickSeconds);
+		maxActionQueueDepth = std::max(maxActionQueueDepth, metrics.maxActionQueueDepth);
+		tickLatency.addSamples(metrics.tickLatency);
+	}
+
+	std::cout << std::fixed << std::setprecision(2)
+		<< "Server: " << getMatchCount() << " matches (" << allMetrics.size() << " hosted), " << getClientCount()
+		<< " players, " << getNumWorkers() << " workers, " << ticks << " ticks and " << rounds << " rounds played\n"
+		<< "Tick time: mean " << totalTickSeconds * 1000000.0 / static_cast<double>(std::max<std::int64_t>(ticks, 1))
+		<< " us, max " << maxTickSeconds * 1000000.0 << " us, " << lateTicks << " late ticks (over one tick period)\n"
+		<< "Queue depth: pool mean " << static_cast<double>(totalQueueDepth) / static_cast<double>(std::max<std::int64_t>(queueDepthSamples, 1))
+		<< ", pool max " << maxQueueDepth << ", match actions max " << maxActionQueueDepth << ", " << droppedStates << " states dropped\n";
+
+	tickLatency.printToConsole("Tick latency");
+
+	// The slowest matches
+	std::sort(allMetrics.begin(), allMetrics.end(), [](const MatchMetrics& a, const MatchMetrics& b)
+	{
+		return a.maxTickSeconds > b.maxTickSeconds;
+	});
+
+	for (int i{0}; i < std::min(numMatches, static_cast<int>(allMetrics.size())); i++)
+	{
+		const MatchMetrics& metrics{allMetrics[i]};
+
+		std::cout << "  Match " << metrics.id << ": " << metrics.ticks << " ticks, tick time mean "
+			<< metrics.totalTickSeconds * 1000000.0 / static_cast<double>(std::max<std::int64_t>(metrics.ticks, 1))
+			<< " us, max " << metrics.maxTickSeconds * 1000000.0 << " us, tick latency p99 "
+			<< metrics.tickLatency.getPercentileMilliseconds(99) << " ms, max " << metrics.tickLatency.getMaxMilliseconds()
+			<< " ms, " << metrics.lateTicks << " late, action queue max " << metrics.maxActionQueueDepth << '\n';
+	}
+}
+
+int MatchServer::getMatchCount() const
+{
+	return static_cast<int>(matches.size());
+}
+
+int MatchServer::getClientCount() const
+{
+	int count{0};
+
+	for (const auto& match : matches)
+	{
+		for (const auto& client : match->clients)
+		{
+			count += (client != nullptr);
+		}
+	}
+
+	return count;
+}
+
+int MatchServer::getNumWorkers() const
+{
+	return pool.getNumWorkers();
+}
+
+std::vector<MatchServer::MatchMetrics> MatchServer::getMatchMetrics()
+{
+	std::vector<MatchMetrics> allMetrics{finishedMetrics};
+
+	for (const auto& match : matches)
+	{
+		waitUntilIdle(*match);
+		allMetrics.push_back(match->metrics);
+	}
+
+	return allMetrics;
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+void MatchServer::acceptClients(const Clock::time_point now)
+{
+	for (;;)
+	{
+		auto client{std::make_unique<Client>()};
+
+		if (listener.accept(client->socket) != sf::Socket::Done)
+		{
+			return;
+		}
+
+		client->socket.setBlocking(false);
+
+		if (waitingMatch)
+		{
+			// The second player starts the match
+			waitingMatch->clients[1] = std::move(client);
+			waitingMatch->started = true;
+			startRound(*waitingMatch, now);
+
+			waitingMatch = nullptr;
+		}
+		else if (static_cast<int>(matches.size()) < MAX_MATCHES)
+		{
+			auto match{std::make_unique<Match>()};
+			match->id = nextMatchId++;
+			match->metrics.id = match->id;
+			match->clients[0] = std::move(client);
+
+			waitingMatch = match.get();
+			matches.push_back(std::move(match));
+		}
+		else
+		{
+			client->socket.disconnect();
+		}
+	}
+}
+
+void MatchServer::startRound(Match& match, const Clock::time_point now)
+{
+	const std::uint32_t seed{nextSeed++};
+
+	match.match = VersusMatch{seed};
+	match.startTime = now;
+	match.stateSentTick = -1;
+
+	clearActions(match);
+
+	for (int player{0}; player < VersusMatch::NUM_PLAYERS; player++)
+	{
+		message.clear();
+		writeUint(message, 0, HEADER_BYTES);
+		writeUint(message, static_cast<std::uint32_t>(MessageType::JOINED), 1);
+		writeUint(message, static_cast<std::uint32_t>(match.id), 4);
+		writeUint(message, static_cast<std::uint32_t>(player), 1);
+		writeUint(message, seed, 4);
+		writeSize(message);
+
+		queueMessage(*match.clients[player]);
+	}
+}
+
+void MatchServer::clearActions(Match& match)
+{
+	QueuedAction action;
+
+	while (match.actions.pop(action))
+	{
+	}
+
+	for (int player{0}; player < VersusMatch::NUM_PLAYERS; player++)
+	{
+		match.pendingActions[player] = ActionFrame{};
+		match.deferredReleases[player].clear();
+	}
+}
+
+bool MatchServer::receiveActions(Match& match, const int player)
+{
+	Client& client{*match.clients[player]};
+
+	for (;;)
+	{
+		// Queue the whole messages, and keep the rest for the next receive
+		int position{0};
+
+		while (client.receivedBytes - position >= HEADER_BYTES)
+		{
+			const std::uint8_t* const bytes{client.receiveBuffer + position};
+
+			if ((bytes[0] | (bytes[1] << 8)) != ACTIONS_BYTES)
+			{
+				return false;
+			}
+
+			if (client.receivedBytes - position < HEADER_BYTES + ACTIONS_BYTES)
+			{
+				break;
+			}
+
+			if (bytes[2] != static_cast<std::uint8_t>(MessageType::ACTIONS))
+			{
+				return false;
+			}
+
+			QueuedAction action;
+			action.player = player;
+			action.frame.pressed = ActionSet{static_cast<ActionSet::Bits>((bytes[3] | (bytes[4] << 8)) & ACTION_BITS)};
+			action.frame.released = ActionSet{static_cast<ActionSet::Bits>((bytes[5] | (bytes[6] << 8)) & ACTION_BITS)};
+
+			// The rest waits in the buffer (and the socket) while the queue is full
+			if (!match.actions.push(action))
+			{
+				break;
+			}
+
+			position += HEADER_BYTES + ACTIONS_BYTES;
+		}
+
+		std::memmove(client.receiveBuffer, client.receiveBuffer + position, static_cast<std::size_t>(client.receivedBytes - position));
+		client.receivedBytes -= position;
+
+		if (client.receivedBytes >= HEADER_BYTES + ACTIONS_BYTES)
+		{
+			return true;
+		}
+
+		std::size_t received{0};
+		const sf::Socket::Status status{client.socket.receive(client.receiveBuffer + client.receivedBytes,
+		                                                      static_cast<std::size_t>(RECEIVE_BUFFER_BYTES - client.receivedBytes), received)};
+
+		if ((status == sf::Socket::Disconnected) || (status == sf::Socket::Error))
+		{
+			return false;
+		}
+
+		if (received == 0)
+		{
+			return true;
+		}
+
+		client.receivedBytes += static_cast<int>(received);
+	}
+}
+
+void MatchServer::queueState(Match& match)
+{
+	const VersusMatch& versus{match.match};
+
+	message.clear();
+	writeUint(message, 0, HEADER_BYTES);
+	writeUint(message, static_cast<std::uint32_t>(MessageType::STATE), 1);
+	writeUint(message, static_cast<std::uint32_t>(versus.getTick()), 4);
+	writeUint(message, versus.isOver(), 1);
+	writeUint(message, static_cast<std::uint32_t>(versus.getWinner() + 1), 1);
+
+	for (int player{0}; player < VersusMatch::NUM_PLAYERS; player++)
+	{
+		const TetrisSimulation::LockDelta& lock{versus.getPlayer(player).getLastLock()};
+
+		writeUint(message, static_cast<std::uint32_t>(lock.score), 4);
+		writeUint(message, static_cast<std::uint32_t>(lock.lines), 2);
+	}
+
+	writeSize(message);
+
+	for (const auto& client : match.clients)
+	{
+		if (!queueMessage(*client))
+		{
+			droppedStates++;
+		}
+	}
+
+	match.stateSentTick = versus.getTick();
+}
+
+bool MatchServer::queueMessage(Client& client)
+{
+	const int size{static_cast<int>(message.size())};
+
+	// Move the queued bytes to the front to make room
+	if ((SEND_BUFFER_BYTES - client.sendEnd < size) && (client.sendStart > 0))
+	{
+		std::memmove(client.sendBuffer, client.sendBuffer + client.sendStart, static_cast<std::size_t>(client.sendEnd - client.sendStart));
+		client.sendEnd -= client.sendStart;
+		client.sendStart = 0;
+	}
+
+	if (SEND_BUFFER_BYTES - client.sendEnd < size)
+	{
+		return false;
+	}
+
+	std::memcpy(client.sendBuffer + client.sendEnd, message.data(), static_cast<std::size_t>(size));
+	client.sendEnd += size;
+
+	return true;
+}
+
+bool MatchServer::flush(Client& client)
+{
+	if (client.sendStart == client.sendEnd)
+	{
+		return true;
+	}
+
+	std::size_t sent{0};
+	const sf::Socket::Status status{client.socket.send(client.sendBuffer + client.sendStart,
+	                                                   static_cast<std::size_t>(client.sendEnd - client.sendStart), sent)};
+
+	client.sendStart += static_cast<int>(sent);
+
+	if (client.sendStart == client.sendEnd)
+	{
+		client.sendStart = 0;
+		client.sendEnd = 0;
+	}
+
+	return (status == sf::Socket::Done) || (status == sf::Socket::Partial) || (status == sf::Socket::NotReady);
+}
+
+void MatchServer::stepMatch(Match& match)
+{
+	using Seconds = std::chrono::duration<double>;
+
+	constexpr double TICK_SECONDS{1.0 / TetrisSimulation::TICKS_PER_SECOND};
+
+	const std::int64_t endTick{std::min(getTicksDue(Clock::now() - match.startTime), match.match.getTick() + MAX_TICKS_PER_TASK)};
+
+	// The actions received since the last task are applied on the first tick
+	match.metrics.maxActionQueueDepth = std::max(match.metrics.maxActionQueueDepth, static_cast<int>(match.actions.size()));
+
+	QueuedAction action;
+
+	while (match.actions.pop(action))
+	{
+		addActions(match.pendingActions[action.player], match.deferredReleases[action.player], action.frame);
+	}
+
+	while ((match.match.getTick() < endTick) && !match.match.isOver())
+	{
+		const std::int64_t tick{match.match.getTick()};
+		const Clock::time_point tickStart{Clock::now()};
+
+		VersusMatch::TickActions actions;
+
+		for (int player{0}; player < VersusMatch::NUM_PLAYERS; player++)
+		{
+			actions.players[player] = match.pendingActions[player];
+
+			match.pendingActions[player] = ActionFrame{};
+			match.pendingActions[player].released = match.deferredReleases[player];
+			match.deferredReleases[player].clear();
+		}
+
+		match.match.step(actions);
+
+		const Clock::time_point tickEnd{Clock::now()};
+		const double tickSeconds{Seconds(tickEnd - tickStart).count()};
+
+		// The tick was due once the clock reached its end
+		const double latencySeconds{Seconds(tickEnd - match.startTime).count() - static_cast<double>(tick + 1) * TICK_SECONDS};
+
+		MatchMetrics& metrics{match.metrics};
+		metrics.ticks++;
+		metrics.totalTickSeconds += tickSeconds;
+		metrics.maxTickSeconds = std::max(metrics.maxTickSeconds, tickSeconds);
+		metrics.tickLatency.addSample(latencySeconds);
+		metrics.lateTicks += (latencySeconds > TICK_SECONDS);
+	}
+
+	match.running.store(false, std::memory_order_release);
+}
+
+void MatchServer::waitUntilIdle(const Match& match)
+{
+	while (match.running.load(std::memory_order_acquire))
+	{
+		std::this_thread::yield();
+	}
+}
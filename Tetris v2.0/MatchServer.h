@@ -0,0 +1,236 @@
+// The MatchServer class hosts many VersusMatches at once, headless, for players that
+// connect over TCP (see BotClient for a scripted player.)
+//  - Players are paired into matches in the order they connect. The server is the single
+//     authority: players only send their actions, and get the match state back
+//  - Every match runs at its own fixed timestep (TetrisSimulation::TICKS_PER_SECOND from
+//     the time it started). When a tick is due, the match's actions are read from its
+//     players' sockets and the match is stepped by a task on a WorkStealingPool, so busy
+//     matches are spread over every core. A match is never stepped by two tasks at once
+//  - Tick latency is bounded: a task steps at most MAX_TICKS_PER_TASK ticks (so a match
+//     that fell behind can not hold a worker for long), and actions wait in a bounded
+//     per-match queue (a player that sends faster than the match steps is not read)
+//  - Metrics: per match tick time (stepping) and tick latency (from the time a tick was
+//     due to the time it was stepped), the depth of each match's action queue, and the
+//     depth of the pool's task queue (see printMetrics())
+//  - Non-blocking: update() never waits for the network, or for a match to finish
+//
+// Stream format (little endian), each message is a uint16 payload size, then the payload:
+//  - JOINED (server): uint8 type, uint32 match id, uint8 player, uint32 seed (sent again
+//     for every new round, a match restarts with a new seed when it is over)
+//  - STATE (server): uint8 type, uint32 tick, uint8 over, uint8 winner + 1 (0 for none),
+//     then per player: int32 score and uint16 lines (at the last lock)
+//  - ACTIONS (player): uint8 type, uint16 pressed actions, uint16 released actions
+
+#ifndef MATCHSERVER_H
+#define MATCHSERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <SFML/Network.hpp>
+#include "Actions.h"
+#include "InputChannel.h"
+#include "LatencyStats.h"
+#include "SpscQueue.h"
+#include "VersusMatch.h"
+#include "WorkStealingPool.h"
+
+
+class MatchServer
+{
+public:
+	// TYPES ------------------------------------------------------------------
+	using Clock = std::chrono::steady_clock;
+
+	// Message types of the stream
+	enum class MessageType : std::uint8_t
+	{
+		JOINED = 1,
+		STATE = 2,
+		ACTIONS = 3
+	};
+
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int MAX_MATCHES{512};				// Matches hosted at once (more players are closed)
+	static constexpr int MAX_TICKS_PER_TASK{4};			// Most ticks one task steps (when a match fell behind)
+	static constexpr int STATE_INTERVAL_TICKS{6};		// Ticks between states sent to the players (10 per second)
+	static constexpr int ACTION_QUEUE_SIZE{64};			// Actions queued per match, at most
+	static constexpr int RECEIVE_BUFFER_BYTES{64};		// Bytes of partly received messages kept per player
+	static constexpr int SEND_BUFFER_BYTES{256};		// Bytes queued per player, at most
+
+	// The metrics of one match (see getMatchMetrics())
+	struct MatchMetrics
+	{
+		int id{0};							// The match id
+		std::int64_t ticks{0};				// Ticks stepped
+		std::int64_t rounds{0};				// Rounds finished
+		double totalTickSeconds{0.0};		// Time spent stepping
+		double maxTickSeconds{0.0};			// Longest time one tick took to step
+		LatencyStats tickLatency;			// From the time each tick was due to the time it was stepped
+		std::int64_t lateTicks{0};			// Ticks stepped more than a tick period after they were due
+		int maxActionQueueDepth{0};			// Most actions queued when a task started
+	};
+
+private:
+	// A connected player
+	struct Client
+	{
+		sf::TcpSocket socket;									// Non-blocking connection
+		std::uint8_t receiveBuffer[RECEIVE_BUFFER_BYTES];		// Received bytes not read yet
+		int receivedBytes{0};									// Bytes in receiveBuffer
+		std::uint8_t sendBuffer[SEND_BUFFER_BYTES];				// Queued bytes, in [sendStart, sendEnd)
+		int sendStart{0};										// First queued byte not sent yet
+		int sendEnd{0};											// One past the last queued byte
+	};
+
+	// An action received from a player, queued for the match's next tick
+	struct QueuedAction
+	{
+		int player;
+		ActionFrame frame;
+	};
+
+	// A hosted match
+	//  - While running is true, a task owns the match (the server thread only pushes to
+	//     actions), otherwise the server thread does
+	struct Match
+	{
+		int id{0};												// Match id (for the players and the metrics)
+		std::unique_ptr<Client> clients[VersusMatch::NUM_PLAYERS];	// The players, by player index
+		bool started{false};									// True once both players joined
+		bool closing{false};									// True once a player left (the match is removed)
+
+		VersusMatch match{0};									// The current round
+		Clock::time_point startTime;							// The time the round started (tick 0)
+		std::int64_t stateSentTick{-1};							// The tick of the last state sent
+
+		ActionFrame pendingActions[VersusMatch::NUM_PLAYERS];	// Each player's actions for the next tick
+		ActionSet deferredReleases[VersusMatch::NUM_PLAYERS];	// Releases for the tick after (see addActions())
+
+		MatchMetrics metrics;									// Written by the tasks
+
+		SpscQueue<QueuedAction, ACTION_QUEUE_SIZE> actions;		// Pushed by the server thread, popped by the tasks
+		std::atomic<bool> running{false};						// True while a task steps the match
+	};
+
+	// MEMBER VARIABLES -------------------------------------------------------
+	sf::TcpListener listener;						// Accepts players (non-blocking)
+	std::vector<std::unique_ptr<Match>> matches;	// Hosted matches
+	Match* waitingMatch{nullptr};					// The match waiting for a second player (if any)
+	int nextMatchId{1};								// The id of the next match created
+	std::uint32_t nextSeed;							// The seed of the next round started
+
+	std::vector<MatchMetrics> finishedMetrics;		// The metrics of the matches removed
+
+	std::int64_t queueDepthSamples{0};				// Pool queue depth samples taken (one per update())
+	std::int64_t totalQueueDepth{0};				// Sum of the samples
+	int maxQueueDepth{0};							// Largest sample
+	std::int64_t droppedStates{0};					// States not sent to a player whose buffer was full
+	std::vector<std::uint8_t> message;				// The message being encoded (reused)
+
+	WorkStealingPool pool;							// Steps the matches (last, so it stops before the matches go)
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//  - Listens on the port, throws a NetworkError if it can not
+	//
+	// - param 1: unsigned short, the TCP port to listen on
+	// - param 2: int, the pool's workers (0 for one per hardware thread)
+	// - param 3: uint32_t, the seed of the first round (each new round uses the next seed)
+	MatchServer(unsigned short port, int numWorkers, std::uint32_t seed);
+
+	// The matches hold sockets, so the server can not be copied
+	MatchServer(const MatchServer&) = delete;
+	MatchServer& operator=(const MatchServer&) = delete;
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Accept new players, send the states due, read the actions of the matches that have
+	// a tick due and queue a task to step them, and remove the matches a player left.
+	//  - Call it often (about every millisecond), a tick is only scheduled from here
+	//
+	// - param 1: time_point, the current time
+	void update(Clock::time_point now);
+
+	// Print the server's metrics to the console, and the slowest matches' (by longest tick.)
+	//  - Waits for the running tasks to finish (only call it from the thread calling update())
+	//
+	// - param 1: int, the number of matches to print
+	void printMetrics(int numMatches);
+
+	// Getters ---------------------------------
+
+	int getMatchCount() const;		// Get the matches hosted (started or waiting for a player)
+	int getClientCount() const;		// Get the connected players
+	int getNumWorkers() const;		// Get the pool's workers
+
+	// Get the metrics of every match (removed ones too.)
+	//  - Waits for the running tasks to finish (only call it from the thread calling update())
+	//
+	// - return: vector of MatchMetrics, one per match
+	std::vector<MatchMetrics> getMatchMetrics();
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// Accept every waiting connection, pairing the players into matches.
+	//
+	// - param 1: time_point, the current time (the start of a paired match)
+	void acceptClients(Clock::time_point now);
+
+	// Start a new round of a match, and tell its players.
+	//  - The actions received before the round are dropped (see clearActions())
+	//
+	// - param 1: Match, the match (not running)
+	// - param 2: time_point, the time of the round's tick 0
+	void startRound(Match& match, Clock::time_point now);
+
+	// Drop every action of a match not applied yet: queued, pending and deferred.
+	//
+	// - param 1: Match, the match (not running)
+	void clearActions(Match& match);
+
+	// Read a player's actions into the match's action queue.
+	//  - Stops when the queue is full (the rest is read on a later tick)
+	//
+	// - param 1: Match, the match
+	// - param 2: int, the player index
+	// - return: bool, false if the connection was closed (or the stream was invalid)
+	bool receiveActions(Match& match, int player);
+
+	// Queue a state message for both players (see the stream format.)
+	//
+	// - param 1: Match, the match (not running)
+	void queueState(Match& match);
+
+	// Copy the encoded message into a player's send buffer (it is dropped if it does not fit.)
+	//
+	// - param 1: Client, the player
+	// - return: bool, true if the message was queued
+	bool queueMessage(Client& client);
+
+	// Send a player's queued bytes (as many as the socket takes.)
+	//
+	// - param 1: Client, the player
+	// - return: bool, false if the connection was closed or failed
+	bool flush(Client& client);
+
+	// Step the ticks due of a match, run on a worker.
+	//  - At most MAX_TICKS_PER_TASK ticks, the actions queued are applied on the first one
+	//
+	// - param 1: Match, the match (running)
+	void stepMatch(Match& match);
+
+	// Wait until no task is stepping a match.
+	//
+	// - param 1: Match, the match
+	static void waitUntilIdle(const Match& match);
+};
+
+#endif /* MATCHSERVER_H */
@@ -0,0 +1,179 @@
+#include "PlacementPolicy.h"
+
+#include <bitset>
+#include <cstdlib>
+#include <type_traits>
+
+
+static_assert(std::is_trivially_copyable<PlacementPolicy>::value, "Rollouts copy policies by assignment");
+
+
+// Score the board of a game after a placement (see PlacementPolicy::evaluate())
+static double evaluateGame(const TetrisSimulation& simulation, const int linesCleared)
+{
+	return PlacementPolicy::evaluate(simulation.getBoard(), linesCleared);
+}
+
+static double evaluateGame(const GameState& state, const int linesCleared)
+{
+	return PlacementPolicy::evaluate(state, linesCleared);
+}
+
+
+// Constructor ------------------------------------------------------------
+
+PlacementPolicy::PlacementPolicy(const Kind kind, const std::uint32_t seed)
+	: kind(kind), random(seed)
+{
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+int PlacementPolicy::choose(const TetrisSimulation& simulation, const TetrisSimulation::Placement placements[], const int count)
+{
+	return chooseFrom(simulation, placements, count);
+}
+
+int PlacementPolicy::choose(const GameState& state, const TetrisSimulation::Placement placements[], const int count)
+{
+	return chooseFrom(state, placements, count);
+}
+
+double PlacementPolicy::evaluate(const TetrisSimulation::Board& board, const int linesCleared)
+{
+	using Board = TetrisSimulation::Board;
+
+	int totalHeight{0};
+	int holes{0};
+	int bumpiness{0};
+
+	for (int x{0}; x < Board::MAX_X; x++)
+	{
+		const int height{board.getColumnHeight(x)};
+
+		totalHeight += height;
+
+		// Empty blocks below the top of the column
+		for (int y{Board::MAX_Y - height + 1}; y < Board::MAX_Y; y++)
+		{
+			holes += (board.getContent(x, y) == Board::EMPTY_BLOCK);
+		}
+
+		if (x > 0)
+		{
+			bumpiness += std::abs(height - board.getColumnHeight(x - 1));
+		}
+	}
+
+	return HEIGHT_WEIGHT * totalHeight + LINES_WEIGHT * linesCleared + HOLES_WEIGHT * holes + BUMPINESS_WEIGHT * bumpiness;
+}
+
+double PlacementPolicy::evaluate(const GameState& state, const int linesCleared)
+{
+	using Board = GameState::Board;
+
+	int columnHeights[Board::MAX_X]{};
+	int holes{0};
+	GameState::RowMask covered{0};	// Columns with a block above the row
+
+	// From the top down: a column's height is set by its first block, and every empty block below one is a hole
+	for (int y{-Board::HIDDEN_ROWS}; y < Board::MAX_Y; y++)
+	{
+		const GameState::RowMask row{state.getRow(y)};
+
+		holes += static_cast<int>(std::bitset<Board::MAX_X>(covered & ~row).count());
+
+		for (GameState::RowMask tops{static_cast<GameState::RowMask>(row & ~covered)}; tops != 0; tops &= tops - 1)
+		{
+			columnHeights[std::bitset<Board::MAX_X>((tops & -tops) - 1).count()] = Board::MAX_Y - y;
+		}
+
+		covered |= row;
+	}
+
+	int totalHeight{0};
+	int bumpiness{0};
+
+	for (int x{0}; x < Board::MAX_X; x++)
+	{
+		totalHeight += columnHeights[x];
+
+		if (x > 0)
+		{
+			bumpiness += std::abs(columnHeights[x] - columnHeights[x - 1]);
+		}
+	}
+
+	return HEIGHT_WEIGHT * totalHeight + LINES_WEIGHT * linesCleared + HOLES_WEIGHT * holes + BUMPINESS_WEIGHT * bumpiness;
+}
+
+bool PlacementPolicy::parseKind(const std::string& name, Kind& kind)
+{
+	if (name == "random")
+	{
+		kind = Kind::RANDOM;
+		return true;
+	}
+
+	if (name == "greedy")
+	{
+		kind = Kind::GREEDY;
+		return true;
+	}
+
+	return false;
+}
+
+PlacementPolicy::Kind PlacementPolicy::getKind() const
+{
+	return kind;
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+template <typename Game>
+int PlacementPolicy::chooseFrom(const Game& game, const TetrisSimulation::Placement placements[], const int count)
+{
+	if (count <= 0)
+	{
+		return -1;
+	}
+
+	if (kind == Kind::RANDOM)
+	{
+		return random.nextInt(count);
+	}
+
+	int best{-1};
+	double bestValue{0.0};
+	int ties{0};
+
+	for (int i{0}; i < count; i++)
+	{
+		// Play the placement on a copy of the game
+		Game next{game};
+
+		if (!next.place(placements[i]))
+		{
+			continue;
+		}
+
+		// A placement that ends the game is only picked if every one does
+		const double value{next.isGameOver() ? -1e9 : evaluateGame(next, next.getLines() - game.getLines())};
+
+		if ((best < 0) || (value > bestValue))
+		{
+			best = i;
+			bestValue = value;
+			ties = 1;
+		}
+		else if ((value == bestValue) && (random.nextInt(++ties) == 0))
+		{
+			best = i;	// Each tie is kept with equal chance
+		}
+	}
+
+	return (best >= 0) ? best : random.nextInt(count);
+}
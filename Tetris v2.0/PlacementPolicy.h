@@ -0,0 +1,111 @@
+// The PlacementPolicy class picks where each shape of a TetrisSimulation goes, for bots that
+// play whole games headless one placement at a time (training data, rollouts.)
+//  - RANDOM: any placement the shape can reach, uniformly
+//  - GREEDY: the placement that leaves the best board, one shape ahead (a weighted sum of
+//     the stack height, holes, bumpiness and lines cleared), ties broken at random
+//  - Plays a TetrisSimulation or a GameState (the same placements, so the same choices)
+//  - Deterministic for a seed, and trivially copyable (its whole state is a Random)
+
+#ifndef PLACEMENTPOLICY_H
+#define PLACEMENTPOLICY_H
+
+#include <string>
+#include "GameState.h"
+#include "Random.h"
+#include "TetrisSimulation.h"
+
+
+class PlacementPolicy
+{
+public:
+	// TYPES ------------------------------------------------------------------
+
+	// How placements are picked
+	enum class Kind : std::uint8_t
+	{
+		RANDOM,
+		GREEDY,
+		COUNT
+	};
+
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+
+	// Weights of the board features (tuned for line clearing, see evaluate())
+	static constexpr double HEIGHT_WEIGHT{-0.510066};		// Per block of total column height
+	static constexpr double LINES_WEIGHT{0.760666};			// Per line cleared
+	static constexpr double HOLES_WEIGHT{-0.35663};			// Per empty block below a column's top
+	static constexpr double BUMPINESS_WEIGHT{-0.184483};	// Per block of height difference between neighbours
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+	Kind kind;			// How placements are picked
+	Random random;		// Picks random placements, and breaks ties
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//
+	// - param 1: Kind, how placements are picked
+	// - param 2: uint32_t, the seed of the random choices
+	PlacementPolicy(Kind kind, std::uint32_t seed);
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Pick one of a game's placements.
+	//
+	// - param 1: TetrisSimulation, the game (before the placement)
+	// - param 2: Placement array, the game's placements (see TetrisSimulation::getPlacements())
+	// - param 3: int, the number of placements
+	// - return: int, the index of the placement picked (-1 if there are none)
+	int choose(const TetrisSimulation& simulation, const TetrisSimulation::Placement placements[], int count);
+
+	// Pick one of a game state's placements (see choose() above.)
+	//
+	// - param 1: GameState, the game (before the placement)
+	// - param 2: Placement array, the game's placements (see GameState::getPlacements())
+	// - param 3: int, the number of placements
+	// - return: int, the index of the placement picked (-1 if there are none)
+	int choose(const GameState& state, const TetrisSimulation::Placement placements[], int count);
+
+	// Score a board (higher is better.)
+	//
+	// - param 1: Board, the board after a placement
+	// - param 2: int, the lines the placement cleared
+	// - return: double, the weighted sum of the board features
+	static double evaluate(const TetrisSimulation::Board& board, int linesCleared);
+
+	// Score a game state's board (see evaluate() above, the same features from the row masks.)
+	//
+	// - param 1: GameState, the game after a placement
+	// - param 2: int, the lines the placement cleared
+	// - return: double, the weighted sum of the board features
+	static double evaluate(const GameState& state, int linesCleared);
+
+	// Get a kind from its name ("random" or "greedy".)
+	//
+	// - param 1: string, the name
+	// - param 2: Kind, set to the kind (if the name is known)
+	// - return: bool, true if the name is known
+	static bool parseKind(const std::string& name, Kind& kind);
+
+	// Getters ---------------------------------
+
+	Kind getKind() const;		// Get how placements are picked
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// Pick one of a game's placements (see choose().)
+	//
+	// - param 1: TetrisSimulation or GameState, the game (before the placement)
+	// - param 2: Placement array, the game's placements
+	// - param 3: int, the number of placements
+	// - return: int, the index of the placement picked (-1 if there are none)
+	template <typename Game>
+	int chooseFrom(const Game& game, const TetrisSimulation::Placement placements[], int count);
+};
+
+#endif /* PLACEMENTPOLICY_H */
@@ -0,0 +1,44 @@
+#include "Random.h"
+
+#include <cassert>
+
+
+// Constructor ------------------------------------------------------------
+
+Random::Random(const std::uint32_t seed)
+{
+	// Scramble the seed (so nearby seeds give unrelated sequences), xorshift can not start at 0
+	std::uint32_t mixed{seed * 0x9E3779B9u};
+	mixed ^= mixed >> 16;
+	mixed *= 0x85EBCA6Bu;
+	mixed ^= mixed >> 13;
+
+	state = (mixed != 0) ? mixed : 0x6D2B79F5u;
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+std::uint32_t Random::next()
+{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+
+	return state;
+}
+
+int Random::nextInt(const int bound)
+{
+	assert((bound > 0) && "Invalid bound.");
+
+	// Scale instead of % (no modulo bias towards the low numbers)
+	return static_cast<int>((static_cast<std::uint64_t>(next()) * static_cast<std::uint64_t>(bound)) >> 32);
+}
+
+// Getters ---------------------------------
+
+std::uint32_t Random::getState() const
+{
+	return state;
+}
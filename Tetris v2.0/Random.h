@@ -0,0 +1,45 @@
+// The Random class is a small, seedable pseudo-random number generator (xorshift32).
+//  - The same seed always gives the same numbers, on every platform, so games that
+//     use it can be replayed and run in lockstep
+//  - Its whole state is one integer (trivially copyable)
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+
+class Random
+{
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+	std::uint32_t state;	// The generator state (never 0)
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//
+	// - param 1: uint32_t, the seed (any value, 0 included)
+	explicit Random(std::uint32_t seed = 0);
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Get the next number.
+	//
+	// - return: uint32_t, the next number in [0, 2^32)
+	std::uint32_t next();
+
+	// Get the next number in a range.
+	//
+	// - param 1: int, the size of the range (> 0)
+	// - return: int, the next number in [0, bound)
+	int nextInt(int bound);
+
+	// Getters ---------------------------------
+
+	std::uint32_t getState() const;		// Get the generator state (equal states give equal numbers)
+};
+
+#endif /* RANDOM_H */
@@ -0,0 +1,126 @@
+#include "RenderThread.h"
+
+#include <algorithm>
+#include <iostream>
+#include <SFML/System/Sleep.hpp>
+
+
+// Constructor ------------------------------------------------------------
+
+RenderThread::RenderThread(sf::RenderWindow& window, GameRenderer& renderer, const Clock::time_point startTime)
+	: window(window), startTime(startTime), renderer(renderer)
+{
+	running = true;
+	thread = std::thread(&RenderThread::run, this);
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+void RenderThread::addInputTime(const Clock::time_point time)
+{
+	if (numPendingInputTimes < MAX_INPUT_TIMES)
+	{
+		pendingInputTimes[numPendingInputTimes++] = time;
+	}
+}
+
+void RenderThread::publish(const TetrisSimulation& game)
+{
+	// Forget the inputs that have been displayed
+	const std::uint64_t displayed{displayedInputSequence.load(std::memory_order_acquire)};
+
+	if (displayed > firstPendingInputSequence)
+	{
+		const int numDisplayed{static_cast<int>(std::min<std::uint64_t>(displayed - firstPendingInputSequence,
+		                                                                  numPendingInputTimes))};
+
+		std::copy(pendingInputTimes + numDisplayed, pendingInputTimes + numPendingInputTimes, pendingInputTimes);
+		numPendingInputTimes -= numDisplayed;
+		firstPendingInputSequence += numDisplayed;
+	}
+
+	Frame& frame{frames.getWriteBuffer()};
+
+	game.writeSnapshot(frame.game);
+
+	std::copy(pendingInputTimes, pendingInputTimes + numPendingInputTimes, frame.inputTimes);
+	frame.firstInputSequence = firstPendingInputSequence;
+	frame.numInputTimes = numPendingInputTimes;
+
+	frames.publish();
+}
+
+void RenderThread::stop()
+{
+	running = false;
+
+	if (thread.joinable())
+	{
+		thread.join();
+	}
+}
+
+const LatencyStats& RenderThread::getInputLatency() const
+{
+	return inputLatency;
+}
+
+
+// Destructor -------------------------------------------------------------
+
+RenderThread::~RenderThread()
+{
+	stop();
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+void RenderThread::run()
+{
+	window.setActive(true);
+
+	std::uint64_t measuredInputSequence{0};	// Inputs before this sequence number have been measured
+	bool firstFrameShown{false};
+
+	while (running)
+	{
+		// Nothing new to draw, wait for the game loop
+		if (!frames.update())
+		{
+			sf::sleep(sf::milliseconds(1));
+			continue;
+		}
+
+		const Frame& frame{frames.getReadBuffer()};
+
+		// Draw the game to the screen
+		window.clear(sf::Color::White);	// Clear the entire window
+		renderer.draw(frame.game);		// Draw the background and the game (onto the window)
+		window.display();				// Re-display the entire window (waits for the frame rate limit)
+
+		// The inputs handled by this frame are now on screen (measure each one only once)
+		const Clock::time_point displayTime{Clock::now()};
+
+		if (!firstFrameShown)
+		{
+			firstFrameShown = true;
+			std::cout << "Time to first frame: "
+			          << std::chrono::duration<double, std::milli>(displayTime - startTime).count() << " ms\n";
+		}
+
+		for (int i{0}; i < frame.numInputTimes; i++)
+		{
+			if (frame.firstInputSequence + i >= measuredInputSequence)
+			{
+				inputLatency.addSample(std::chrono::duration<double>(displayTime - frame.inputTimes[i]).count());
+			}
+		}
+
+		measuredInputSequence = std::max(measuredInputSequence, frame.firstInputSequence + frame.numInputTimes);
+		displayedInputSequence.store(measuredInputSequence, std::memory_order_release);
+	}
+
+	window.setActive(false);
+}
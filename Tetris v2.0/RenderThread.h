@@ -0,0 +1,111 @@
+// The RenderThread class draws and displays the game on its own thread.
+//  - The game loop publishes a Frame (a game snapshot) every loop, and never waits for
+//     drawing, vsync or the graphics driver
+//  - The render thread draws the latest published Frame, skipping any it was too slow for
+//  - Input-to-photon latency is measured here, when an input is first displayed (inputs
+//     stay in every published Frame until the render thread has displayed one of them)
+//  - The time to first frame (from the start time to the first display) is printed to the console
+
+#ifndef RENDERTHREAD_H
+#define RENDERTHREAD_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include "GameRenderer.h"
+#include "LatencyStats.h"
+#include "SnapshotBuffer.h"
+#include "TetrisSimulation.h"
+
+
+class RenderThread
+{
+public:
+	// TYPES ------------------------------------------------------------------
+	using Clock = std::chrono::steady_clock;
+
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int MAX_INPUT_TIMES{16};	// Max inputs waiting to be displayed (extras are not measured)
+
+	// Everything the render thread needs for one frame
+	struct Frame
+	{
+		TetrisSimulation::Snapshot game;						// The game to draw
+		Clock::time_point inputTimes[MAX_INPUT_TIMES];	// When the inputs not yet displayed were sampled
+		std::uint64_t firstInputSequence;				// Sequence number of inputTimes[0] (the rest follow in order)
+		int numInputTimes;								// Number of inputTimes
+	};
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+	sf::RenderWindow& window;		// The window to draw on (active on the render thread)
+	const Clock::time_point startTime;	// When the program started (for the time to first frame)
+	GameRenderer& renderer;			// Draws the game snapshots
+	SnapshotBuffer<Frame> frames;	// Frames published by the game loop
+	LatencyStats inputLatency;		// Input-to-photon latency (render thread only, until stop())
+
+	// Inputs waiting to be displayed (game loop thread only)
+	Clock::time_point pendingInputTimes[MAX_INPUT_TIMES];
+	int numPendingInputTimes{0};
+	std::uint64_t firstPendingInputSequence{0};
+
+	std::atomic<std::uint64_t> displayedInputSequence{0};	// Inputs before this sequence number have been displayed
+
+	std::atomic<bool> running{false};	// False to stop the thread
+	std::thread thread;					// The render thread
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//  - Starts the render thread, which activates the window on itself
+	//  - The window must not be active on the calling thread (window.setActive(false))
+	//
+	// - param 1: the RenderWindow to draw on
+	// - param 2: the GameRenderer to draw the game with
+	// - param 3: time_point, when the program started
+	RenderThread(sf::RenderWindow& window, GameRenderer& renderer, Clock::time_point startTime);
+
+	// The thread can not be copied
+	RenderThread(const RenderThread&) = delete;
+	RenderThread& operator=(const RenderThread&) = delete;
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Record an input that the next published Frame shows (game loop thread only.)
+	//
+	// - param 1: time_point, when the input was sampled
+	void addInputTime(Clock::time_point time);
+
+	// Publish a snapshot of the game, with the inputs not yet displayed, to be drawn (game loop thread only.)
+	//  - Never blocks or allocates
+	//
+	// - param 1: the TetrisSimulation to snapshot (such as TetrisGame::getSimulation())
+	void publish(const TetrisSimulation& game);
+
+	// Stop and join the render thread (the window can be closed afterwards.)
+	void stop();
+
+	// Get the input-to-photon latency (only once stop() has been called.)
+	//
+	// - return: LatencyStats
+	const LatencyStats& getInputLatency() const;
+
+
+	// Destructor -------------------------------------------------------------
+
+	// Stops and joins the render thread
+	~RenderThread();
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// The drawing loop, run on the render thread.
+	void run();
+};
+
+#endif /* RENDERTHREAD_H */
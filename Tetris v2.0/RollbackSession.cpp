@@ -0,0 +1,208 @@
+#include "RollbackSession.h"
+
+#include <algorithm>
+#include <cassert>
+
+
+static_assert(InputChannel::WINDOW_TICKS > RollbackSession::MAX_ROLLBACK_TICKS + RollbackSession::MAX_INPUT_DELAY_TICKS
+              + InputChannel::SEND_INTERVAL_TICKS, "The window must hold every tick that can be stepped again");
+
+static constexpr int NUM_STATES{RollbackSession::MAX_ROLLBACK_TICKS + 1};	// Saved states (the confirmed tick's, and every predicted one's)
+
+
+// Determine if an action frame has any presses or releases.
+//
+// - param 1: ActionFrame, the frame to test
+// - return: bool, true if the frame is empty (the prediction)
+static bool isEmptyFrame(const ActionFrame& frame)
+{
+	return frame.pressed.isEmpty() && frame.released.isEmpty();
+}
+
+
+// Constructor ------------------------------------------------------------
+
+RollbackSession::RollbackSession(const int localPlayer, const unsigned short localPort, const sf::IpAddress& remoteAddress,
+                                 const unsigned short remotePort, const std::uint32_t seed, const int inputDelayTicks)
+	: match(seed), localPlayer(localPlayer), inputDelay(std::clamp(inputDelayTicks, 1, MAX_INPUT_DELAY_TICKS)),
+	  channel(localPort, remoteAddress, remotePort, inputDelay),	// The first inputDelay ticks have no actions (on both peers)
+	  states(NUM_STATES, match.getState())
+{
+	assert((localPlayer >= 0) && (localPlayer < VersusMatch::NUM_PLAYERS) && "Invalid player.");
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+void RollbackSession::addLocalActions(const ActionFrame& frame)
+{
+	channel.addLocalActions(frame);
+}
+
+void RollbackSession::update(const Clock::time_point now)
+{
+	if (!started)
+	{
+		started = true;
+		startTime = now;
+	}
+
+	channel.receive(confirmedTick);
+	confirmRemoteTicks();
+
+	// Ticks of real time since the start (the match may not run ahead of it)
+	const std::int64_t clockTicks{std::chrono::duration_cast<std::chrono::microseconds>(now - startTime).count()
+	                              * TetrisSimulation::TICKS_PER_SECOND / 1000000};
+
+	for (bool progressed{true}; progressed;)
+	{
+		progressed = false;
+
+		// Local actions are final for a tick once it is due, and at most inputDelay ticks
+		// ahead of the match (and within the resend window)
+		const std::int64_t nextLocalTick{channel.getNextLocalTick()};
+
+		if ((nextLocalTick - inputDelay < clockTicks) && (nextLocalTick <= match.getTick() + inputDelay)
+			&& (nextLocalTick < channel.getRemoteTicksAcked() + InputChannel::WINDOW_TICKS))
+		{
+			channel.finalizeLocalTick();
+			progressed = true;
+		}
+
+		if ((match.getTick() < clockTicks) && (match.getTick() < channel.getNextLocalTick())
+			&& (match.getTick() < confirmedTick + MAX_ROLLBACK_TICKS) && !match.isOver())
+		{
+			stepMatch();
+			progressed = true;
+		}
+	}
+
+	channel.checkHash(confirmedTick);
+	channel.sendIfDue(now);
+}
+
+void RollbackSession::setSimulatedLatency(const Clock::duration latency)
+{
+	channel.setSimulatedLatency(latency);
+}
+
+const VersusMatch& RollbackSession::getMatch() const
+{
+	return match;
+}
+
+int RollbackSession::getLocalPlayer() const
+{
+	return localPlayer;
+}
+
+std::int64_t RollbackSession::getConfirmedTick() const
+{
+	return confirmedTick;
+}
+
+bool RollbackSession::isDesynced() const
+{
+	return channel.isDesynced();
+}
+
+std::int64_t RollbackSession::getDesyncTick() const
+{
+	return channel.getDesyncTick();
+}
+
+bool RollbackSession::isWaitingForRemote() const
+{
+	return !match.isOver() && (match.getTick() >= confirmedTick + MAX_ROLLBACK_TICKS);
+}
+
+const RollbackSession::Stats& RollbackSession::getStats() const
+{
+	return stats;
+}
+
+double RollbackSession::getBytesSentPerSecond(const Clock::time_point now) const
+{
+	return channel.getBytesSentPerSecond(now);
+}
+
+std::int64_t RollbackSession::getPacketsSent() const
+{
+	return channel.getPacketsSent();
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+void RollbackSession::confirmRemoteTicks()
+{
+	// Every tick from confirmedTick to the match tick was stepped with the prediction
+	const std::int64_t endTick{std::min(channel.getRemoteTicksReceived(), match.getTick())};
+
+	while (confirmedTick < endTick)
+	{
+		if (!isEmptyFrame(channel.getRemoteFrame(confirmedTick)))
+		{
+			rollBack(confirmedTick);	// Also confirms the ticks stepped again
+			return;
+		}
+
+		confirmedTick++;
+		recordConfirmedHash();
+	}
+}
+
+void RollbackSession::rollBack(const std::int64_t tick)
+{
+	const Clock::time_point start{Clock::now()};
+	const std::int64_t endTick{match.getTick()};
+
+	match.restoreState(states[tick % NUM_STATES]);
+
+	while ((match.getTick() < endTick) && !match.isOver())
+	{
+		stepMatch();
+	}
+
+	const int ticksResimulated{static_cast<int>(match.getTick() - tick)};
+
+	stats.rollbacks++;
+	stats.ticksResimulated += ticksResimulated;
+	stats.longestRollbackTicks = std::max(stats.longestRollbackTicks, ticksResimulated);
+	stats.longestRollbackSeconds = std::max(stats.longestRollbackSeconds,
+	                                        std::chrono::duration<double>(Clock::now() - start).count());
+}
+
+void RollbackSession::stepMatch()
+{
+	const std::int64_t tick{match.getTick()};
+	const bool remoteKnown{tick < channel.getRemoteTicksReceived()};
+
+	states[tick % NUM_STATES] = match.getState();
+
+	VersusMatch::TickActions actions;
+	actions.players[localPlayer] = channel.getLocalFrame(tick);
+	actions.players[1 - localPlayer] = remoteKnown ? channel.getRemoteFrame(tick) : ActionFrame{};	// Predicted: no change
+
+	match.step(actions);
+
+	if (remoteKnown && (tick == confirmedTick))
+	{
+		confirmedTick++;
+		recordConfirmedHash();
+	}
+}
+
+void RollbackSession::recordConfirmedHash()
+{
+	if (confirmedTick % InputChannel::HASH_INTERVAL_TICKS != 0)
+	{
+		return;
+	}
+
+	// The confirmed state is the current one, or saved before a predicted tick
+	const std::uint32_t hash{(confirmedTick == match.getTick()) ? match.getStateHash()
+	                         : states[confirmedTick % NUM_STATES].getHash()};
+
+	channel.recordHash(confirmedTick, hash);
+}
@@ -0,0 +1,149 @@
+// The RollbackSession class plays a VersusMatch against a remote peer over UDP, with
+// rollback instead of waiting for the peer's actions.
+//  - Both peers run the whole (deterministic) match, only the players' actions are sent
+//     (see InputChannel), and local actions are applied after a short input delay
+//  - The match runs in real time: the ticks the peer's actions have not arrived for yet
+//     are predicted (no new presses or releases, so its held actions stay held)
+//  - The match state is saved before every tick into a ring of MAX_ROLLBACK_TICKS
+//     states (a plain copy, see VersusMatch::State). When the peer's actions arrive and
+//     differ from the prediction, the match is restored to the first mispredicted tick
+//     and stepped again up to the current tick with the actual actions
+//  - The match never predicts more than MAX_ROLLBACK_TICKS ticks ahead of the peer's
+//     actions, above that it stalls (as lockstep would) until they arrive
+//  - Hashes are only taken of confirmed states (every action before them known), so a
+//     misprediction is never reported as a desync
+//  - Non-blocking: update() never waits for the network
+//
+// Note: peers must use the same seed, input delay and build (the simulation's timers use doubles).
+
+#ifndef ROLLBACKSESSION_H
+#define ROLLBACKSESSION_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "Actions.h"
+#include "InputChannel.h"
+#include "VersusMatch.h"
+
+
+class RollbackSession
+{
+public:
+	// TYPES ------------------------------------------------------------------
+	using Clock = InputChannel::Clock;
+
+	// Counters of the rollbacks made (see getStats())
+	struct Stats
+	{
+		std::int64_t rollbacks{0};			// Times a misprediction was corrected
+		std::int64_t ticksResimulated{0};	// Ticks stepped again by all the rollbacks
+		int longestRollbackTicks{0};		// Most ticks stepped again by one rollback
+		double longestRollbackSeconds{0.0};	// Longest time one rollback took (restore and steps)
+	};
+
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int DEFAULT_INPUT_DELAY_TICKS{2};	// Local actions are applied this many ticks later (33 ms)
+	static constexpr int MAX_INPUT_DELAY_TICKS{15};		// Largest allowed input delay
+	static constexpr int MAX_ROLLBACK_TICKS{15};		// Most ticks predicted ahead of the peer's actions (250 ms)
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+	VersusMatch match;			// The match, with the peer's actions predicted past confirmedTick
+	const int localPlayer;		// The player index controlled here
+	const int inputDelay;		// Ticks between an action and the tick it is applied on
+
+	InputChannel channel;		// Sends the local actions, and receives the peer's
+
+	// The match state before each tick, by tick % (MAX_ROLLBACK_TICKS + 1)
+	//  - Holds every tick from confirmedTick up to the match tick
+	std::vector<VersusMatch::State> states;
+
+	std::int64_t confirmedTick{0};	// The match is final (stepped with the peer's actual actions) up to this tick
+
+	bool started{false};				// False until the first update()
+	Clock::time_point startTime;		// The time of the first update() (tick 0)
+
+	Stats stats;						// Rollbacks made so far
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//  - Binds the local port, throws a NetworkError if it can not
+	//
+	// - param 1: int, the local player index (0 or 1, the peer must use the other one)
+	// - param 2: unsigned short, the local UDP port
+	// - param 3: IpAddress, the peer's address
+	// - param 4: unsigned short, the peer's UDP port
+	// - param 5: uint32_t, the match seed (the same on both peers)
+	// - param 6: int, the input delay in ticks (the same on both peers)
+	RollbackSession(int localPlayer, unsigned short localPort, const sf::IpAddress& remoteAddress,
+	                unsigned short remotePort, std::uint32_t seed, int inputDelayTicks = DEFAULT_INPUT_DELAY_TICKS);
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Add local actions (applied on the next local tick, inputDelay ticks ahead.)
+	//
+	// - param 1: ActionFrame, the released and pressed actions
+	void addLocalActions(const ActionFrame& frame);
+
+	// Receive the peer's packets, roll back if they differ from the prediction, finalize
+	// the local ticks that are due, step the match up to real time (predicting the peer's
+	// actions), and send a packet if one is due.
+	//  - The match never runs ahead of real time (TetrisSimulation::TICKS_PER_SECOND)
+	//
+	// - param 1: time_point, the current time
+	void update(Clock::time_point now);
+
+	// Hold back every outgoing packet for a time (to test on loopback as if over a slow link.)
+	//
+	// - param 1: duration, the one way latency to add
+	void setSimulatedLatency(Clock::duration latency);
+
+	// Getters ---------------------------------
+
+	const VersusMatch& getMatch() const;	// Get the match (predicted past getConfirmedTick())
+	int getLocalPlayer() const;				// Get the local player index
+	std::int64_t getConfirmedTick() const;	// Get the tick the match is final up to
+	bool isDesynced() const;				// True once the peers' confirmed states differed
+	std::int64_t getDesyncTick() const;		// Get the tick of the first mismatched hash (-1 if none)
+	bool isWaitingForRemote() const;		// True if the match is stalled on the prediction limit
+	const Stats& getStats() const;			// Get the rollbacks made so far
+
+	// Get the bytes sent per second since the first update().
+	//
+	// - param 1: time_point, the current time
+	// - return: double, bytes per second (UDP/IP headers included)
+	double getBytesSentPerSecond(Clock::time_point now) const;
+
+	// Get the packets sent since the first update().
+	//
+	// - return: int64_t, the number of packets
+	std::int64_t getPacketsSent() const;
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// Compare the peer's actions received since the last call with the prediction.
+	//  - Predicted ticks that were right are confirmed
+	//  - At the first wrong one, roll back to it (see rollBack())
+	void confirmRemoteTicks();
+
+	// Restore the match to the state before a tick, and step it again up to the current tick.
+	//
+	// - param 1: int64_t, the first mispredicted tick
+	void rollBack(std::int64_t tick);
+
+	// Save the match state, and step the match one tick with the local actions and the
+	// peer's actions (or the prediction, if they are not known yet.)
+	//  - Confirms the tick if the peer's actions were known
+	void stepMatch();
+
+	// Keep the hash of the confirmed state if one is due.
+	void recordConfirmedHash();
+};
+
+#endif /* ROLLBACKSESSION_H */
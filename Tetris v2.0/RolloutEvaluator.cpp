@@ -0,0 +1,187 @@
+#include "RolloutEvaluator.h"
+
+#include <algorithm>
+
+
+// Mix a seed with two indices into the seed of one rollout's shapes or policy (murmur3
+// finalizer), so neighbouring rounds do not play related shape orders
+static std::uint32_t mixSeed(const std::uint32_t seed, const std::uint32_t round, const std::uint32_t stream)
+{
+	std::uint32_t hash{seed ^ (round * 0x9E3779B9u) ^ (stream * 0x85EBCA6Bu)};
+
+	hash ^= hash >> 16;
+	hash *= 0x85EBCA6Bu;
+	hash ^= hash >> 13;
+	hash *= 0xC2B2AE35u;
+	hash ^= hash >> 16;
+
+	return hash;
+}
+
+
+// Constructor ------------------------------------------------------------
+
+RolloutEvaluator::RolloutEvaluator(const Settings& settings)
+	: settings(settings), pool(settings.numWorkers)
+{
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+RolloutEvaluator::Result RolloutEvaluator::evaluate(const TetrisSimulation& simulation)
+{
+	return evaluate(GameState{simulation, settings.seed});
+}
+
+RolloutEvaluator::Result RolloutEvaluator::evaluate(const GameState& state)
+{
+	const Clock::time_point start{Clock::now()};
+
+	Placement candidates[GameState::MAX_PLACEMENTS];
+	const int count{state.getPlacements(candidates)};
+
+	Result evaluation;
+
+	if (count == 0)
+	{
+		return evaluation;
+	}
+
+	const int numTasks{pool.getNumWorkers()};
+
+	{
+		std::lock_guard<std::mutex> lock(doneMutex);
+		tasksLeft = numTasks;
+		totals.assign(count, Totals{});
+		placementsPlayed = 0;
+	}
+
+	nextPlayout = 0;
+	deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(settings.seconds));
+
+	for (int task{0}; task < numTasks; task++)
+	{
+		pool.submit([this, &state, &candidates, count]() { playRollouts(state, candidates, count); });
+	}
+
+	std::unique_lock<std::mutex> lock(doneMutex);
+
+	tasksDone.wait(lock, [this]() { return tasksLeft == 0; });
+
+	// The candidates' means, and the best of them
+	evaluation.candidates.resize(count);
+
+	for (int i{0}; i < count; i++)
+	{
+		Candidate& candidate{evaluation.candidates[i]};
+		const Totals& sums{totals[i]};
+
+		candidate.placement = candidates[i];
+		candidate.playouts = sums.playouts;
+		candidate.meanValue = (sums.playouts > 0) ? sums.value / sums.playouts : 0.0;
+		candidate.gameOverRate = (sums.playouts > 0) ? static_cast<double>(sums.gameOvers) / sums.playouts : 0.0;
+
+		evaluation.playouts += sums.playouts;
+
+		if ((sums.playouts > 0) && ((evaluation.best < 0) || (candidate.meanValue > evaluation.candidates[evaluation.best].meanValue)))
+		{
+			evaluation.best = i;
+		}
+	}
+
+	evaluation.placements = placementsPlayed;
+	evaluation.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	return evaluation;
+}
+
+// Getters ---------------------------------
+
+const RolloutEvaluator::Settings& RolloutEvaluator::getSettings() const
+{
+	return settings;
+}
+
+int RolloutEvaluator::getNumWorkers() const
+{
+	return pool.getNumWorkers();
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+void RolloutEvaluator::playRollouts(const GameState& root, const Placement candidates[], const int count)
+{
+	// With neither limit set, one round (so an evaluation always ends)
+	const std::int64_t maxPlayouts{((settings.maxPlayouts <= 0) && (settings.seconds <= 0.0)) ? count : settings.maxPlayouts};
+
+	std::vector<Totals> sums(count);
+	std::int64_t placements{0};
+
+	while ((settings.seconds <= 0.0) || (Clock::now() < deadline))
+	{
+		const std::int64_t playout{nextPlayout.fetch_add(1, std::memory_order_relaxed)};
+
+		if ((maxPlayouts > 0) && (playout >= maxPlayouts))
+		{
+			break;
+		}
+
+		const int candidate{static_cast<int>(playout % count)};
+		const auto round{static_cast<std::uint32_t>(playout / count)};
+
+		GameState state{root};
+		state.reseed(mixSeed(settings.seed, round, 1));
+
+		PlacementPolicy policy{settings.policy, mixSeed(settings.seed, round, 2)};
+
+		placements += playRollout(state, candidates[candidate], policy);
+
+		Totals& total{sums[candidate]};
+
+		total.playouts++;
+		total.gameOvers += state.isGameOver();
+		total.value += (state.getScore() - root.getScore()) - (state.isGameOver() ? settings.gameOverPenalty : 0.0);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(doneMutex);
+
+		for (int i{0}; i < count; i++)
+		{
+			totals[i].playouts += sums[i].playouts;
+			totals[i].gameOvers += sums[i].gameOvers;
+			totals[i].value += sums[i].value;
+		}
+
+		placementsPlayed += placements;
+		tasksLeft--;
+	}
+
+	tasksDone.notify_all();
+}
+
+int RolloutEvaluator::playRollout(GameState& state, const Placement& candidate, PlacementPolicy& policy) const
+{
+	Placement placements[GameState::MAX_PLACEMENTS];
+
+	state.place(candidate);
+
+	int placed{1};
+
+	for (; (placed <= settings.depth) && !state.isGameOver(); placed++)
+	{
+		const int count{state.getPlacements(placements)};
+		const int choice{policy.choose(state, placements, count)};
+
+		if (choice < 0)
+		{
+			break;
+		}
+
+		state.place(placements[choice]);
+	}
+
+	return placed;
+}
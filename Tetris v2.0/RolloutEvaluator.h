@@ -0,0 +1,147 @@
+// The RolloutEvaluator class scores every placement of a game's current shape by playing
+// many short random or greedy futures (rollouts) after each one, for Monte Carlo search.
+//  - A rollout copies a GameState (two cache lines, no SFML objects), makes the candidate
+//     placement, then lets a PlacementPolicy place up to Settings::depth more shapes. Its
+//     value is the score gained, less Settings::gameOverPenalty if the game topped out
+//  - Rollouts are played in rounds of one per candidate. The rollouts of a round deal the
+//     same shapes after the known next shapes (see GameState::reseed()) and seed their
+//     policies alike, so candidates are compared on the same futures
+//  - Parallel: one task per worker on a WorkStealingPool. The tasks take rollouts from one
+//     shared counter (so the candidates are played in turn, and each gets about as many
+//     rollouts), sum them locally, and merge once when the time budget runs out
+//  - Rollout n always plays candidate n % candidates the same way, but how many rollouts
+//     finish in the time budget depends on the machine (set Settings::maxPlayouts, and no
+//     time budget, for the same result on every run)
+
+#ifndef ROLLOUTEVALUATOR_H
+#define ROLLOUTEVALUATOR_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "GameState.h"
+#include "PlacementPolicy.h"
+#include "TetrisSimulation.h"
+#include "WorkStealingPool.h"
+
+
+class RolloutEvaluator
+{
+public:
+	// TYPES ------------------------------------------------------------------
+	using Clock = std::chrono::steady_clock;
+	using Placement = TetrisSimulation::Placement;
+
+	// How to evaluate
+	struct Settings
+	{
+		PlacementPolicy::Kind policy{PlacementPolicy::Kind::GREEDY};	// Places the shapes after the candidate
+		int depth{10};								// Shapes placed after the candidate (per rollout)
+		double seconds{0.1};						// Time budget of one evaluation (0 for no limit)
+		std::int64_t maxPlayouts{0};				// Rollouts of one evaluation, over every candidate (0 for no limit)
+		double gameOverPenalty{1000.0};				// Taken from the value of a rollout that topped out
+		int numWorkers{0};							// Workers (0 for one per hardware thread)
+		std::uint32_t seed{1};						// Seeds the rollouts' shapes and policies
+	};
+
+	// What the rollouts of one candidate placement gave
+	struct Candidate
+	{
+		Placement placement{};		// The candidate placement
+		std::int64_t playouts{0};	// Rollouts played
+		double meanValue{0.0};		// Mean rollout value (score gained, less the game over penalty)
+		double gameOverRate{0.0};	// Share of the rollouts that topped out (0 - 1)
+	};
+
+	// What one evaluation found (see evaluate())
+	struct Result
+	{
+		std::vector<Candidate> candidates;	// Every placement, in getPlacements() order
+		int best{-1};						// The candidate with the highest mean value (-1 if none)
+		std::int64_t playouts{0};			// Rollouts played (every candidate)
+		std::int64_t placements{0};			// Shapes placed by the rollouts
+		double seconds{0.0};				// Time taken
+	};
+
+private:
+	// The sums of one candidate's rollouts
+	struct Totals
+	{
+		std::int64_t playouts{0};	// Rollouts played
+		std::int64_t gameOvers{0};	// Rollouts that topped out
+		double value{0.0};			// Sum of the rollout values
+	};
+
+	// MEMBER VARIABLES -------------------------------------------------------
+	Settings settings;						// How to evaluate
+
+	std::atomic<std::int64_t> nextPlayout{0};	// The next rollout a task takes
+	Clock::time_point deadline;				// When the tasks stop taking rollouts (set before they start)
+
+	std::mutex doneMutex;					// Guards the members below
+	std::condition_variable tasksDone;		// Signaled when a task finishes
+	int tasksLeft{0};						// Tasks not finished yet
+	std::vector<Totals> totals;				// The merged sums, per candidate
+	std::int64_t placementsPlayed{0};		// The merged shapes placed
+
+	WorkStealingPool pool;					// Plays the rollouts (last, so it stops first)
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//  - Starts the pool's workers
+	//
+	// - param 1: Settings, how to evaluate
+	explicit RolloutEvaluator(const Settings& settings);
+
+	// The evaluator owns threads, so it can not be copied
+	RolloutEvaluator(const RolloutEvaluator&) = delete;
+	RolloutEvaluator& operator=(const RolloutEvaluator&) = delete;
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Play rollouts after every placement of a game's current shape, waiting until the time
+	// budget (or the rollout limit) runs out.
+	//
+	// - param 1: TetrisSimulation, the game (between two shapes)
+	// - return: Result, the candidates and their values
+	Result evaluate(const TetrisSimulation& simulation);
+
+	// Play rollouts after every placement of a game state's current shape (see evaluate() above.)
+	//
+	// - param 1: GameState, the game
+	// - return: Result, the candidates and their values
+	Result evaluate(const GameState& state);
+
+	// Getters ---------------------------------
+
+	const Settings& getSettings() const;		// Get how to evaluate
+	int getNumWorkers() const;					// Get the number of workers
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// Play rollouts until the time budget or the rollout limit runs out, and merge their
+	// sums (run on a worker.)
+	//
+	// - param 1: GameState, the game
+	// - param 2: Placement array, the candidate placements
+	// - param 3: int, the number of candidates
+	void playRollouts(const GameState& root, const Placement candidates[], int count);
+
+	// Play one rollout.
+	//
+	// - param 1: GameState, a copy of the game (played on)
+	// - param 2: Placement, the candidate placement
+	// - param 3: PlacementPolicy, places the shapes after the candidate
+	// - return: int, the shapes placed (the candidate too)
+	int playRollout(GameState& state, const Placement& candidate, PlacementPolicy& policy) const;
+};
+
+#endif /* ROLLOUTEVALUATOR_H */
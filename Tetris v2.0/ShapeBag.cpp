@@ -0,0 +1,66 @@
+#include "ShapeBag.h"
+
+#include <algorithm>
+#include <utility>
+
+
+// Constructor ------------------------------------------------------------
+
+ShapeBag::ShapeBag(const std::uint32_t seed)
+{
+	reset(seed);
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+void ShapeBag::reset(const std::uint32_t seed)
+{
+	random = Random{seed};
+	nextShape = BAG_SIZE;
+}
+
+Tetromino::TetShape ShapeBag::next()
+{
+	if (nextShape == BAG_SIZE)
+	{
+		// Fisher-Yates shuffle of one of each shape
+		for (int i{0}; i < BAG_SIZE; i++)
+		{
+			shapes[i] = static_cast<Tetromino::TetShape>(i);
+		}
+
+		for (int i{BAG_SIZE - 1}; i > 0; i--)
+		{
+			std::swap(shapes[i], shapes[random.nextInt(i + 1)]);
+		}
+
+		nextShape = 0;
+	}
+
+	return shapes[nextShape++];
+}
+
+std::uint8_t ShapeBag::getShapesLeft() const
+{
+	std::uint8_t shapesLeft{0};
+
+	for (int i{nextShape}; i < BAG_SIZE; i++)
+	{
+		shapesLeft |= static_cast<std::uint8_t>(1u << static_cast<int>(shapes[i]));
+	}
+
+	return shapesLeft;
+}
+
+int ShapeBag::getShapesLeft(Tetromino::TetShape shapesLeft[BAG_SIZE]) const
+{
+	std::copy(shapes + nextShape, shapes + BAG_SIZE, shapesLeft);
+
+	return BAG_SIZE - nextShape;
+}
+
+std::uint32_t ShapeBag::getRandomState() const
+{
+	return random.getState();
+}
@@ -0,0 +1,65 @@
+// The ShapeBag class picks the order Tetrominos are dealt in (a "7-bag").
+//  - Every shape is dealt once per bag, in a shuffled order, before a new bag starts
+//  - Each game owns its own seeded bag, so two games given the same seed are dealt
+//     the same shapes (no shared static state, no rand())
+
+#ifndef SHAPEBAG_H
+#define SHAPEBAG_H
+
+#include <cstdint>
+#include "Random.h"
+#include "Tetromino.h"
+
+
+class ShapeBag
+{
+public:
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int BAG_SIZE{static_cast<int>(Tetromino::TetShape::COUNT)};	// Shapes per bag
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+	Random random;							// Shuffles each bag
+	Tetromino::TetShape shapes[BAG_SIZE];	// The current bag, in deal order
+	int nextShape{BAG_SIZE};				// Index of the next shape to deal (BAG_SIZE when the bag is empty)
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//
+	// - param 1: uint32_t, the seed for the deal order
+	explicit ShapeBag(std::uint32_t seed = 0);
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Start over with a new seed (the next shape starts a new bag.)
+	//
+	// - param 1: uint32_t, the seed for the deal order
+	void reset(std::uint32_t seed);
+
+	// Deal the next shape.
+	//  - Shuffles a new bag once the current one is empty
+	//
+	// - return: TetShape, the next shape
+	Tetromino::TetShape next();
+
+	// Get the shapes of the current bag not dealt yet.
+	//
+	// - return: uint8_t, bit n is set if TetShape n is still in the bag (0 if a new bag is next)
+	std::uint8_t getShapesLeft() const;
+
+	// Get the shapes of the current bag not dealt yet, in deal order.
+	//
+	// - param 1: TetShape array, filled with the shapes (BAG_SIZE at most)
+	// - return: int, the number of shapes (0 if a new bag is next)
+	int getShapesLeft(Tetromino::TetShape shapesLeft[BAG_SIZE]) const;
+
+	// Get the state of the generator that shuffles the bags.
+	//
+	// - return: uint32_t, the generator state (see Random::getState())
+	std::uint32_t getRandomState() const;
+};
+
+#endif /* SHAPEBAG_H */
@@ -0,0 +1,74 @@
+// The SnapshotBuffer class hands the latest snapshot from one thread to another, without locking.
+//  - The writer fills getWriteBuffer() and publish()es it, the reader update()s to the
+//     latest published snapshot and reads getReadBuffer()
+//  - The published snapshot is double-buffered against the one being read, with a third
+//     buffer for the writer, so neither thread ever waits for the other
+//  - Never allocates or copies after construction, snapshots published faster than they
+//     are read are skipped (only the latest one matters)
+
+#ifndef SNAPSHOTBUFFER_H
+#define SNAPSHOTBUFFER_H
+
+#include <atomic>
+
+
+template <typename T>
+class SnapshotBuffer
+{
+private:
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr unsigned char INDEX_MASK{0x3};	// Bits of published holding a buffer index
+	static constexpr unsigned char NEW_FLAG{0x4};	// Set in published until the reader takes it
+
+	// MEMBER VARIABLES -------------------------------------------------------
+
+	T buffers[3];	// The writer's, the published, and the reader's buffers (by index)
+
+	// Kept on separate cache lines so the writer and reader do not share one.
+	alignas(64) std::atomic<unsigned char> published{1};	// Index of the latest published buffer (and NEW_FLAG)
+	alignas(64) unsigned char writeIndex{0};				// Index of the writer's buffer (writer thread only)
+	alignas(64) unsigned char readIndex{2};					// Index of the reader's buffer (reader thread only)
+
+public:
+	// METHODS ----------------------------------------------------------------
+
+	// Get the buffer to fill with the next snapshot (writer thread only.)
+	//  - Its contents are an older snapshot, so every field must be written
+	//
+	// - return: the writer's buffer
+	T& getWriteBuffer()
+	{
+		return buffers[writeIndex];
+	}
+
+	// Publish the writer's buffer as the latest snapshot (writer thread only.)
+	void publish()
+	{
+		writeIndex = published.exchange(writeIndex | NEW_FLAG, std::memory_order_acq_rel) & INDEX_MASK;
+	}
+
+	// Take the latest published snapshot, if there is a new one (reader thread only.)
+	//
+	// - return: true if getReadBuffer() now holds a new snapshot, false if nothing new was published
+	bool update()
+	{
+		if ((published.load(std::memory_order_relaxed) & NEW_FLAG) == 0)
+		{
+			return false;
+		}
+
+		readIndex = published.exchange(readIndex, std::memory_order_acq_rel) & INDEX_MASK;
+
+		return true;
+	}
+
+	// Get the snapshot taken by the last successful update() (reader thread only.)
+	//
+	// - return: the reader's buffer
+	const T& getReadBuffer() const
+	{
+		return buffers[readIndex];
+	}
+};
+
+#endif /* SNAPSHOTBUFFER_H */
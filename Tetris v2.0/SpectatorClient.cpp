@@ -0,0 +1,293 @@
+#include "SpectatorClient.h"
+
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+static constexpr int HEADER_BYTES{2};	// The uint16 payload size before each message
+
+static constexpr int KEYFRAME_HEADER_BYTES{6};		// Type, tick and board count
+static constexpr int KEYFRAME_BOARD_BYTES{11 + SpectatorServer::PACKED_BOARD_BYTES};	// Per board
+static constexpr int DELTA_BYTES{15 + 2 * Tetromino::NUM_BLOCKS + 7};	// Before the garbage holes
+
+
+// Read an unsigned value from a message, in little endian order, and move past it.
+//
+// - param 1: uint8_t pointer, the position to read at
+// - param 2: int, the bytes to read (1, 2 or 4)
+// - return: uint32_t, the value
+static std::uint32_t readUint(const std::uint8_t*& position, const int bytes)
+{
+	std::uint32_t value{0};
+
+	for (int i{0}; i < bytes; i++)
+	{
+		value |= static_cast<std::uint32_t>(*position++) << (i * 8);
+	}
+
+	return value;
+}
+
+
+// Constructor ------------------------------------------------------------
+
+SpectatorClient::SpectatorClient(const sf::IpAddress& address, const unsigned short port)
+{
+	if (socket.connect(address, port, sf::seconds(5)) != sf::Socket::Done)
+	{
+		throw NetworkError("could not connect to spectator server " + address.toString() + ":" + std::to_string(port));
+	}
+
+	socket.setBlocking(false);
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+bool SpectatorClient::update()
+{
+	for (;;)
+	{
+		std::size_t received{0};
+		const sf::Socket::Status status{socket.receive(buffer + bufferedBytes,
+		                                               static_cast<std::size_t>(RECEIVE_BUFFER_BYTES - bufferedBytes), received)};
+
+		if ((status == sf::Socket::Disconnected) || (status == sf::Socket::Error))
+		{
+			return false;
+		}
+
+		if (received == 0)
+		{
+			return true;
+		}
+
+		bufferedBytes += static_cast<int>(received);
+		stats.bytesReceived += static_cast<std::int64_t>(received);
+
+		// Read the whole messages, and keep the rest for the next receive
+		int position{0};
+
+		while (bufferedBytes - position >= HEADER_BYTES)
+		{
+			const int size{buffer[position] | (buffer[position + 1] << 8)};
+
+			if (HEADER_BYTES + size > RECEIVE_BUFFER_BYTES)
+			{
+				return false;
+			}
+
+			if (bufferedBytes - position < HEADER_BYTES + size)
+			{
+				break;
+			}
+
+			if (!readMessage(buffer + position + HEADER_BYTES, size))
+			{
+				return false;
+			}
+
+			position += HEADER_BYTES + size;
+		}
+
+		std::memmove(buffer, buffer + position, static_cast<std::size_t>(bufferedBytes - position));
+		bufferedBytes -= position;
+	}
+}
+
+const SpectatorClient::Board& SpectatorClient::getBoard(const int board) const
+{
+	assert((board >= 0) && (board < SpectatorServer::MAX_BOARDS) && "Invalid board.");
+
+	return boards[board];
+}
+
+bool SpectatorClient::isSynced(const int board) const
+{
+	return synced[board];
+}
+
+int SpectatorClient::getScore(const int board) const
+{
+	return scores[board];
+}
+
+int SpectatorClient::getLines(const int board) const
+{
+	return lines[board];
+}
+
+int SpectatorClient::getNumBoards() const
+{
+	return numBoards;
+}
+
+std::int64_t SpectatorClient::getTick() const
+{
+	return tick;
+}
+
+const SpectatorClient::Stats& SpectatorClient::getStats() const
+{
+	return stats;
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+bool SpectatorClient::readMessage(const std::uint8_t* const payload, const int size)
+{
+	if (size < 1)
+	{
+		return false;
+	}
+
+	switch (static_cast<SpectatorServer::MessageType>(payload[0]))
+	{
+	case SpectatorServer::MessageType::KEYFRAME:
+		return readKeyframe(payload, size);
+
+	case SpectatorServer::MessageType::DELTA:
+		return readDelta(payload, size);
+
+	default:
+		return true;	// Unknown messages are skipped (for future ones)
+	}
+}
+
+bool SpectatorClient::readKeyframe(const std::uint8_t* const payload, const int size)
+{
+	if (size < KEYFRAME_HEADER_BYTES)
+	{
+		return false;
+	}
+
+	const std::uint8_t* position{payload + 1};
+	tick = readUint(position, 4);
+	const int boardCount{static_cast<int>(readUint(position, 1))};
+
+	if ((boardCount < 1) || (boardCount > SpectatorServer::MAX_BOARDS)
+		|| (size != KEYFRAME_HEADER_BYTES + boardCount * KEYFRAME_BOARD_BYTES))
+	{
+		return false;
+	}
+
+	numBoards = boardCount;
+
+	for (int board{0}; board < numBoards; board++)
+	{
+		const std::uint32_t sequence{readUint(position, 4)};
+		scores[board] = static_cast<int>(readUint(position, 4));
+		lines[board] = static_cast<int>(readUint(position, 2));
+		readUint(position, 1);	// Game over (not drawn yet)
+
+		// A board that followed the stream must match the keyframe of the same lock
+		const bool check{synced[board] && (sequences[board] == sequence)};
+		bool mismatch{false};
+
+		Board keyframeBoard;
+
+		for (int i{0}; i < Board::TOTAL_ROWS * Board::MAX_X; i++)
+		{
+			const int content{((position[i / 2] >> ((i % 2) * 4)) & 0x0F) - 1};
+			const int x{i % Board::MAX_X};
+			const int y{i / Board::MAX_X - Board::HIDDEN_ROWS};
+
+			if (content != Board::EMPTY_BLOCK)
+			{
+				keyframeBoard.setContent(x, y, content);
+			}
+
+			mismatch = mismatch || (check && (boards[board].getContent(x, y) != content));
+		}
+
+		position += SpectatorServer::PACKED_BOARD_BYTES;
+
+		stats.mismatches += mismatch;
+		stats.keyframes++;
+
+		boards[board] = keyframeBoard;
+		sequences[board] = sequence;
+		synced[board] = true;
+	}
+
+	return true;
+}
+
+bool SpectatorClient::readDelta(const std::uint8_t* const payload, const int size)
+{
+	if (size < DELTA_BYTES)
+	{
+		return false;
+	}
+
+	const std::uint8_t* position{payload + 1};
+	tick = readUint(position, 4);
+	const int board{static_cast<int>(readUint(position, 1))};
+	const std::uint32_t sequence{readUint(position, 4)};
+	const int color{static_cast<int>(readUint(position, 1))};
+
+	Point blockLocs[Tetromino::NUM_BLOCKS];
+
+	for (Point& blockLoc : blockLocs)
+	{
+		const int x{static_cast<int>(readUint(position, 1))};
+		const int y{static_cast<int>(readUint(position, 1)) - Board::HIDDEN_ROWS};
+
+		blockLoc.setXY(x, y);
+	}
+
+	const auto clearedRows{static_cast<Board::ColumnMask>(readUint(position, 4))};
+	const int score{static_cast<int>(readUint(position, 4))};
+	const int totalLines{static_cast<int>(readUint(position, 2))};
+	const int garbageRows{static_cast<int>(readUint(position, 1))};
+
+	if ((board >= SpectatorServer::MAX_BOARDS) || (size != DELTA_BYTES + garbageRows))
+	{
+		return false;
+	}
+
+	// Deltas only apply to the board of the lock before them
+	if (!synced[board] || (sequence != sequences[board] + 1))
+	{
+		synced[board] = false;
+		stats.skippedDeltas++;
+
+		return true;
+	}
+
+	Board& gameboard{boards[board]};
+	Board::ColumnMask removedRows{0};
+
+	gameboard.setContent(blockLocs, Tetromino::NUM_BLOCKS, color);
+	gameboard.removeCompletedRows(blockLocs, Tetromino::NUM_BLOCKS, removedRows);
+
+	for (int i{0}; i < garbageRows; i++)
+	{
+		const int holeColumn{static_cast<int>(readUint(position, 1))};
+
+		if (holeColumn >= Board::MAX_X)
+		{
+			return false;
+		}
+
+		gameboard.insertGarbageRows(1, holeColumn, TetrisSimulation::GARBAGE_BLOCK);
+	}
+
+	// The rows removed here must be the rows the game cleared
+	if (removedRows != clearedRows)
+	{
+		synced[board] = false;
+		stats.mismatches++;
+	}
+
+	sequences[board] = sequence;
+	scores[board] = score;
+	lines[board] = totalLines;
+
+	stats.deltas++;
+
+	return true;
+}
@@ -0,0 +1,118 @@
+// The SpectatorClient class follows the games streamed by a SpectatorServer.
+//  - Rebuilds each board from the last keyframe and the lock deltas after it, with the
+//     same Gameboard code as the game (place the blocks, remove the cleared rows, add
+//     the garbage rows)
+//  - The cleared rows of each delta are checked against the rows the board removed, and
+//     the boards are checked against each keyframe, so a broken stream is detected (the
+//     board then waits for the next keyframe)
+//  - Non-blocking: update() reads what has arrived and returns
+
+#ifndef SPECTATORCLIENT_H
+#define SPECTATORCLIENT_H
+
+#include <cstdint>
+#include <SFML/Network.hpp>
+#include "SpectatorServer.h"
+
+
+class SpectatorClient
+{
+public:
+	// TYPES ------------------------------------------------------------------
+	using Board = SpectatorServer::Board;
+
+	// Counters of the stream (see getStats())
+	struct Stats
+	{
+		std::int64_t bytesReceived{0};		// Bytes read from the socket
+		std::int64_t keyframes{0};			// Keyframes applied
+		std::int64_t deltas{0};				// Deltas applied
+		std::int64_t skippedDeltas{0};		// Deltas ignored while waiting for a keyframe
+		std::int64_t mismatches{0};			// Boards that differed from the stream (cleared rows or a keyframe)
+	};
+
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int RECEIVE_BUFFER_BYTES{1024};	// Bytes of partly received messages kept (more than a keyframe)
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+	sf::TcpSocket socket;							// Non-blocking connection to the server
+
+	std::uint8_t buffer[RECEIVE_BUFFER_BYTES];		// Received bytes not read yet
+	int bufferedBytes{0};							// Bytes in buffer
+
+	int numBoards{0};								// Games streamed (known after the first keyframe)
+	Board boards[SpectatorServer::MAX_BOARDS];		// The rebuilt boards
+	bool synced[SpectatorServer::MAX_BOARDS]{};		// True if the board follows the stream (false until a keyframe)
+	std::uint32_t sequences[SpectatorServer::MAX_BOARDS]{};	// The lock sequence each board is at
+	int scores[SpectatorServer::MAX_BOARDS]{};		// The score of each game
+	int lines[SpectatorServer::MAX_BOARDS]{};		// The total lines cleared of each game
+	std::int64_t tick{-1};							// The tick of the last message (-1 if none)
+
+	Stats stats;									// Stream counters
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//  - Connects to the server, throws a NetworkError if it can not
+	//
+	// - param 1: IpAddress, the server's address
+	// - param 2: unsigned short, the server's TCP port
+	SpectatorClient(const sf::IpAddress& address, unsigned short port);
+
+	// The client holds a socket, so it can not be copied
+	SpectatorClient(const SpectatorClient&) = delete;
+	SpectatorClient& operator=(const SpectatorClient&) = delete;
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Read the messages that have arrived, and apply them to the boards.
+	//
+	// - return: bool, false if the connection was closed (or the stream was invalid)
+	bool update();
+
+	// Getters ---------------------------------
+
+	// Get a rebuilt board.
+	//  - Assert the board index is valid
+	//
+	// - param 1: int, the board index
+	// - return: Board, the board
+	const Board& getBoard(int board) const;
+
+	bool isSynced(int board) const;		// True if the board follows the stream
+	int getScore(int board) const;		// Get the score of a game
+	int getLines(int board) const;		// Get the total lines cleared of a game
+	int getNumBoards() const;			// Get the games streamed (0 before the first keyframe)
+	std::int64_t getTick() const;		// Get the tick of the last message (-1 if none)
+	const Stats& getStats() const;		// Get the stream counters
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// Apply one message.
+	//
+	// - param 1: uint8_t pointer, the payload
+	// - param 2: int, the payload size
+	// - return: bool, false if the message is invalid
+	bool readMessage(const std::uint8_t* payload, int size);
+
+	// Apply a keyframe (see SpectatorServer for the format.)
+	//
+	// - param 1: uint8_t pointer, the payload
+	// - param 2: int, the payload size
+	// - return: bool, false if the message is invalid
+	bool readKeyframe(const std::uint8_t* payload, int size);
+
+	// Apply a delta (see SpectatorServer for the format.)
+	//
+	// - param 1: uint8_t pointer, the payload
+	// - param 2: int, the payload size
+	// - return: bool, false if the message is invalid
+	bool readDelta(const std::uint8_t* payload, int size);
+};
+
+#endif /* SPECTATORCLIENT_H */
@@ -0,0 +1,312 @@
+#include "SpectatorServer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <string>
+
+
+static_assert(sizeof(SpectatorServer::Board::ColumnMask) <= 4, "Cleared rows are sent as 32 bits");
+
+static constexpr int HEADER_BYTES{2};	// The uint16 payload size before each message
+
+
+// Append an unsigned value to a message, in little endian order.
+//
+// - param 1: vector of bytes, the message
+// - param 2: uint32_t, the value
+// - param 3: int, the bytes to write (1, 2 or 4)
+static void writeUint(std::vector<std::uint8_t>& message, const std::uint32_t value, const int bytes)
+{
+	for (int i{0}; i < bytes; i++)
+	{
+		message.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+	}
+}
+
+
+// Constructor ------------------------------------------------------------
+
+SpectatorServer::SpectatorServer(const unsigned short port, const int numBoards)
+	: numBoards(numBoards)
+{
+	assert((numBoards > 0) && (numBoards <= MAX_BOARDS) && "Invalid number of boards.");
+
+	if (listener.listen(port) != sf::Socket::Done)
+	{
+		throw NetworkError("could not listen on TCP port " + std::to_string(port));
+	}
+
+	listener.setBlocking(false);
+	selector.add(listener);
+
+	spectators.reserve(MAX_SPECTATORS);
+	message.reserve(HEADER_BYTES + 8 + MAX_BOARDS * (11 + PACKED_BOARD_BYTES));
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+void SpectatorServer::publish(const std::int64_t tick, const TetrisSimulation* const games[])
+{
+	bool keyframeToAll{tick - lastKeyframeTick >= KEYFRAME_INTERVAL_TICKS};
+
+	for (int board{0}; board < numBoards; board++)
+	{
+		const TetrisSimulation::LockDelta& lock{games[board]->getLastLock()};
+
+		if (lock.sequence == lastSequences[board])
+		{
+			continue;
+		}
+
+		// One new lock is a delta, anything else (missed locks, a reset game, garbage
+		// past the top of the board) needs a keyframe
+		if ((lock.sequence == lastSequences[board] + 1) && (lock.garbageRows <= Board::TOTAL_ROWS))
+		{
+			encodeDelta(tick, board, lock);
+			stats.deltasSent++;
+
+			for (const auto& spectator : spectators)
+			{
+				if (!spectator->needsKeyframe)
+				{
+					queueMessage(*spectator);
+				}
+			}
+		}
+		else
+		{
+			keyframeToAll = true;
+		}
+
+		lastSequences[board] = lock.sequence;
+	}
+
+	if (keyframeToAll)
+	{
+		lastKeyframeTick = tick;
+	}
+
+	bool keyframeEncoded{false};
+
+	for (const auto& spectator : spectators)
+	{
+		if (keyframeToAll || spectator->needsKeyframe)
+		{
+			if (!keyframeEncoded)
+			{
+				encodeKeyframe(tick, games);
+				keyframeEncoded = true;
+			}
+
+			// A full buffer is dropped by the first try, so the keyframe fits on the second
+			if (queueMessage(*spectator) || queueMessage(*spectator))
+			{
+				spectator->needsKeyframe = false;
+				stats.keyframesSent++;
+			}
+		}
+	}
+}
+
+void SpectatorServer::update(const sf::Time timeout)
+{
+	// Time::Zero would wait forever
+	if (selector.wait((timeout > sf::Time::Zero) ? timeout : sf::microseconds(1)) && selector.isReady(listener))
+	{
+		acceptSpectators();
+	}
+
+	for (std::size_t i{0}; i < spectators.size();)
+	{
+		if (flush(*spectators[i]))
+		{
+			i++;
+		}
+		else
+		{
+			// Closed or failed, the last spectator takes its place
+			spectators[i]->socket.disconnect();
+			spectators[i] = std::move(spectators.back());
+			spectators.pop_back();
+
+			stats.spectatorsLeft++;
+		}
+	}
+}
+
+int SpectatorServer::getSpectatorCount() const
+{
+	return static_cast<int>(spectators.size());
+}
+
+const SpectatorServer::Stats& SpectatorServer::getStats() const
+{
+	return stats;
+}
+
+std::size_t SpectatorServer::getBytesPerSpectator()
+{
+	return sizeof(Spectator);
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+void SpectatorServer::acceptSpectators()
+{
+	for (;;)
+	{
+		auto spectator{std::make_unique<Spectator>()};
+
+		if (listener.accept(spectator->socket) != sf::Socket::Done)
+		{
+			return;
+		}
+
+		if (static_cast<int>(spectators.size()) >= MAX_SPECTATORS)
+		{
+			spectator->socket.disconnect();
+			continue;
+		}
+
+		spectator->socket.setBlocking(false);
+		spectators.push_back(std::move(spectator));
+
+		stats.spectatorsJoined++;
+	}
+}
+
+void SpectatorServer::encodeKeyframe(const std::int64_t tick, const TetrisSimulation* const games[])
+{
+	message.clear();
+	writeUint(message, 0, HEADER_BYTES);
+	writeUint(message, static_cast<std::uint32_t>(MessageType::KEYFRAME), 1);
+	writeUint(message, static_cast<std::uint32_t>(tick), 4);
+	writeUint(message, static_cast<std::uint32_t>(numBoards), 1);
+
+	for (int board{0}; board < numBoards; board++)
+	{
+		const TetrisSimulation& game{*games[board]};
+		const Board& gameboard{game.getBoard()};
+
+		writeUint(message, game.getLastLock().sequence, 4);
+		writeUint(message, static_cast<std::uint32_t>(game.getLastLock().score), 4);
+		writeUint(message, static_cast<std::uint32_t>(game.getLastLock().lines), 2);
+		writeUint(message, game.isGameOver(), 1);
+
+		// Two blocks per byte, hidden rows first
+		for (int i{0}; i < Board::TOTAL_ROWS * Board::MAX_X; i += 2)
+		{
+			const int low{gameboard.getContent(i % Board::MAX_X, i / Board::MAX_X - Board::HIDDEN_ROWS) + 1};
+			const int high{(i + 1 < Board::TOTAL_ROWS * Board::MAX_X)
+			               ? gameboard.getContent((i + 1) % Board::MAX_X, (i + 1) / Board::MAX_X - Board::HIDDEN_ROWS) + 1 : 0};
+
+			writeUint(message, static_cast<std::uint32_t>(low | (high << 4)), 1);
+		}
+	}
+
+	const auto size{static_cast<std::uint16_t>(message.size() - HEADER_BYTES)};
+	message[0] = static_cast<std::uint8_t>(size);
+	message[1] = static_cast<std::uint8_t>(size >> 8);
+}
+
+void SpectatorServer::encodeDelta(const std::int64_t tick, const int board, const TetrisSimulation::LockDelta& lock)
+{
+	message.clear();
+	writeUint(message, 0, HEADER_BYTES);
+	writeUint(message, static_cast<std::uint32_t>(MessageType::DELTA), 1);
+	writeUint(message, static_cast<std::uint32_t>(tick), 4);
+	writeUint(message, static_cast<std::uint32_t>(board), 1);
+	writeUint(message, lock.sequence, 4);
+	writeUint(message, static_cast<std::uint32_t>(lock.color), 1);
+
+	for (int i{0}; i < Tetromino::NUM_BLOCKS; i++)
+	{
+		writeUint(message, static_cast<std::uint32_t>(lock.blockX[i]), 1);
+		writeUint(message, static_cast<std::uint32_t>(lock.blockY[i] + Board::HIDDEN_ROWS), 1);
+	}
+
+	writeUint(message, static_cast<std::uint32_t>(lock.clearedRows), 4);
+	writeUint(message, static_cast<std::uint32_t>(lock.score), 4);
+	writeUint(message, static_cast<std::uint32_t>(lock.lines), 2);
+	writeUint(message, static_cast<std::uint32_t>(lock.garbageRows), 1);
+
+	for (int i{0}; i < lock.garbageRows; i++)
+	{
+		writeUint(message, static_cast<std::uint32_t>(lock.garbageHoles[i]), 1);
+	}
+
+	const auto size{static_cast<std::uint16_t>(message.size() - HEADER_BYTES)};
+	message[0] = static_cast<std::uint8_t>(size);
+	message[1] = static_cast<std::uint8_t>(size >> 8);
+}
+
+bool SpectatorServer::queueMessage(Spectator& spectator)
+{
+	const int size{static_cast<int>(message.size())};
+
+	// Move the queued bytes to the front to make room
+	if ((SEND_BUFFER_BYTES - spectator.end < size) && (spectator.start > 0))
+	{
+		std::memmove(spectator.buffer, spectator.buffer + spectator.start, static_cast<std::size_t>(spectator.end - spectator.start));
+		spectator.end -= spectator.start;
+		spectator.start = 0;
+	}
+
+	if (SEND_BUFFER_BYTES - spectator.end < size)
+	{
+		// Keep only the rest of a partly sent message (the stream must stay whole)
+		spectator.end = spectator.start + spectator.frameBytesLeft;
+		spectator.needsKeyframe = true;
+
+		stats.overflows++;
+
+		return false;
+	}
+
+	std::memcpy(spectator.buffer + spectator.end, message.data(), static_cast<std::size_t>(size));
+	spectator.end += size;
+
+	stats.bytesQueued += size;
+
+	return true;
+}
+
+bool SpectatorServer::flush(Spectator& spectator)
+{
+	if (spectator.start == spectator.end)
+	{
+		return true;
+	}
+
+	std::size_t sent{0};
+	const sf::Socket::Status status{spectator.socket.send(spectator.buffer + spectator.start,
+	                                                      static_cast<std::size_t>(spectator.end - spectator.start), sent)};
+
+	stats.bytesSent += static_cast<std::int64_t>(sent);
+
+	// Move past the sent bytes, keeping track of where the message at start ends
+	for (int bytesLeft{static_cast<int>(sent)}; bytesLeft > 0;)
+	{
+		if (spectator.frameBytesLeft == 0)
+		{
+			spectator.frameBytesLeft = HEADER_BYTES + (spectator.buffer[spectator.start] | (spectator.buffer[spectator.start + 1] << 8));
+		}
+
+		const int bytes{std::min(bytesLeft, spectator.frameBytesLeft)};
+
+		spectator.start += bytes;
+		spectator.frameBytesLeft -= bytes;
+		bytesLeft -= bytes;
+	}
+
+	if (spectator.start == spectator.end)
+	{
+		spectator.start = 0;
+		spectator.end = 0;
+	}
+
+	return (status == sf::Socket::Done) || (status == sf::Socket::Partial) || (status == sf::Socket::NotReady);
+}
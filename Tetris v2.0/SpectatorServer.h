@@ -0,0 +1,166 @@
+// The SpectatorServer class streams live games (such as the two boards of a VersusMatch)
+// to many spectators over TCP.
+//  - Each locked shape is sent as a delta: its blocks, the rows it cleared and the garbage
+//     rows added after it (see TetrisSimulation::LockDelta), about 30 bytes
+//  - Every KEYFRAME_INTERVAL_TICKS ticks, and to every spectator that joins or falls
+//     behind, a keyframe with the whole boards is sent, so spectators can (re)sync
+//  - A message is encoded once, and copied into each spectator's fixed size send buffer.
+//     A spectator whose buffer is full (a slow reader) drops its queued deltas and gets
+//     the next keyframe instead, so the memory per spectator is bounded
+//  - Non-blocking: the selector only waits on the listener (select() holds few sockets on
+//     some systems), the spectators' sockets are only written to when data is queued
+//
+// Stream format (little endian), each message is a uint16 payload size, then the payload:
+//  - KEYFRAME: uint8 type, uint32 tick, uint8 boards, then per board: uint32 lock sequence,
+//     int32 score and uint16 lines (at the last lock), uint8 game over, and the board
+//     contents (hidden rows first) packed two blocks per byte (content + 1, low nibble first)
+//  - DELTA: uint8 type, uint32 tick, uint8 board, uint32 lock sequence, uint8 color,
+//     NUM_BLOCKS x (uint8 x, uint8 y + HIDDEN_ROWS), uint32 cleared rows, int32 score,
+//     uint16 lines, uint8 garbage rows, then a uint8 hole column per garbage row
+
+#ifndef SPECTATORSERVER_H
+#define SPECTATORSERVER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <SFML/Network.hpp>
+#include "InputChannel.h"
+#include "TetrisSimulation.h"
+
+
+class SpectatorServer
+{
+public:
+	// TYPES ------------------------------------------------------------------
+	using Board = TetrisSimulation::Board;
+
+	// Message types of the stream
+	enum class MessageType : std::uint8_t
+	{
+		KEYFRAME = 1,
+		DELTA = 2
+	};
+
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int MAX_BOARDS{2};					// Games streamed at once
+	static constexpr int MAX_SPECTATORS{1024};			// Connections accepted at once (more are closed)
+	static constexpr int SEND_BUFFER_BYTES{4096};		// Bytes queued per spectator, at most
+	static constexpr int KEYFRAME_INTERVAL_TICKS{120};	// Ticks between keyframes to every spectator (2 seconds)
+
+	static constexpr int PACKED_BOARD_BYTES{(Board::TOTAL_ROWS * Board::MAX_X + 1) / 2};	// Board contents in a keyframe
+
+	// Counters of the stream (see getStats())
+	struct Stats
+	{
+		std::int64_t bytesQueued{0};		// Bytes copied into the spectators' send buffers
+		std::int64_t bytesSent{0};			// Bytes written to the spectators' sockets
+		std::int64_t deltasSent{0};			// Deltas encoded (each sent to every synced spectator)
+		std::int64_t keyframesSent{0};		// Keyframes queued (summed over the spectators)
+		std::int64_t overflows{0};			// Times a spectator's buffer was full (it dropped deltas and resynced)
+		std::int64_t spectatorsJoined{0};	// Connections accepted
+		std::int64_t spectatorsLeft{0};		// Connections closed (by the spectator, or on an error)
+	};
+
+private:
+	// A connected spectator
+	struct Spectator
+	{
+		sf::TcpSocket socket;							// Non-blocking connection
+		std::uint8_t buffer[SEND_BUFFER_BYTES];		// Queued bytes, in [start, end)
+		int start{0};									// First queued byte not sent yet
+		int end{0};										// One past the last queued byte
+		int frameBytesLeft{0};							// Bytes of the message at start not sent yet (0 at a message start)
+		bool needsKeyframe{true};						// True until it got a keyframe since joining or overflowing
+	};
+
+	// MEMBER VARIABLES -------------------------------------------------------
+	const int numBoards;								// Games streamed
+
+	sf::TcpListener listener;							// Accepts spectators (non-blocking)
+	sf::SocketSelector selector;						// Waits for new connections on the listener
+	std::vector<std::unique_ptr<Spectator>> spectators;	// Connected spectators
+
+	std::uint32_t lastSequences[MAX_BOARDS]{};			// The lock sequence last streamed of each game
+	std::int64_t lastKeyframeTick{0};					// The tick of the last keyframe to every spectator
+	std::vector<std::uint8_t> message;					// The message being encoded (reused)
+
+	Stats stats;										// Stream counters
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//  - Listens on the port, throws a NetworkError if it can not
+	//
+	// - param 1: unsigned short, the TCP port to listen on
+	// - param 2: int, the games streamed (1 - MAX_BOARDS)
+	SpectatorServer(unsigned short port, int numBoards);
+
+	// The spectators hold sockets, so the server can not be copied
+	SpectatorServer(const SpectatorServer&) = delete;
+	SpectatorServer& operator=(const SpectatorServer&) = delete;
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Queue the changes of the games since the last call.
+	//  - A delta per new lock, or a keyframe if locks were missed (or a game was reset)
+	//  - A keyframe to every spectator if one is due, and to the spectators that need one
+	//
+	// - param 1: int64_t, the current tick
+	// - param 2: TetrisSimulation, the games (numBoards of them, in board order)
+	void publish(std::int64_t tick, const TetrisSimulation* const games[]);
+
+	// Accept new spectators, and send the queued bytes.
+	//  - Waits on the listener for up to a timeout (use it as the server loop's sleep)
+	//
+	// - param 1: Time, the longest time to wait for new connections (Time::Zero to not wait)
+	void update(sf::Time timeout);
+
+	// Getters ---------------------------------
+
+	int getSpectatorCount() const;		// Get the connected spectators
+	const Stats& getStats() const;		// Get the stream counters
+
+	// Get the memory used by one spectator (its socket and send buffer.)
+	//
+	// - return: size_t, bytes per spectator
+	static std::size_t getBytesPerSpectator();
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// Accept every waiting connection (closing those above MAX_SPECTATORS.)
+	void acceptSpectators();
+
+	// Encode a keyframe of the games into message.
+	//
+	// - param 1: int64_t, the current tick
+	// - param 2: TetrisSimulation, the games
+	void encodeKeyframe(std::int64_t tick, const TetrisSimulation* const games[]);
+
+	// Encode a lock delta into message.
+	//
+	// - param 1: int64_t, the current tick
+	// - param 2: int, the board index
+	// - param 3: LockDelta, the lock
+	void encodeDelta(std::int64_t tick, int board, const TetrisSimulation::LockDelta& lock);
+
+	// Copy the encoded message into a spectator's send buffer.
+	//  - If it does not fit, the queued messages (except one partly sent) are dropped,
+	//     and the spectator needs a keyframe
+	//
+	// - param 1: Spectator, the spectator to queue the message for
+	// - return: bool, true if the message was queued
+	bool queueMessage(Spectator& spectator);
+
+	// Send a spectator's queued bytes (as many as the socket takes.)
+	//
+	// - param 1: Spectator, the spectator to send to
+	// - return: bool, false if the connection was closed or failed
+	bool flush(Spectator& spectator);
+};
+
+#endif /* SPECTATORSERVER_H */
@@ -0,0 +1,80 @@
+// The SpscQueue class is a fixed size, lock-free, single-producer single-consumer queue.
+//  - One thread may push() and one (other) thread may pop(), without locking
+//  - Never allocates after construction, push() fails when the queue is full
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+
+template <typename T, std::size_t Capacity>
+class SpscQueue
+{
+	static_assert((Capacity >= 2) && ((Capacity & (Capacity - 1)) == 0), "Capacity must be a power of 2");
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+
+	T items[Capacity];	// Ring buffer of queued items
+
+	// Indices only ever increase (wrapping is done by masking), so head == tail
+	// means empty and tail - head == Capacity means full.
+	// Kept on separate cache lines so the producer and consumer do not share one.
+	alignas(64) std::atomic<std::size_t> head{0};	// Next item to pop (written by the consumer)
+	alignas(64) std::atomic<std::size_t> tail{0};	// Next slot to push into (written by the producer)
+
+public:
+	// METHODS ----------------------------------------------------------------
+
+	// Add an item to the back of the queue (producer thread only.)
+	//
+	// - param 1: the item to add
+	// - return: true if the item was added, false if the queue is full
+	bool push(const T& item)
+	{
+		const std::size_t currentTail{tail.load(std::memory_order_relaxed)};
+
+		if (currentTail - head.load(std::memory_order_acquire) == Capacity)
+		{
+			return false;
+		}
+
+		items[currentTail & (Capacity - 1)] = item;
+		tail.store(currentTail + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	// Remove the item at the front of the queue (consumer thread only.)
+	//
+	// - param 1: the item to fill with the front of the queue
+	// - return: true if an item was removed, false if the queue is empty
+	bool pop(T& item)
+	{
+		const std::size_t currentHead{head.load(std::memory_order_relaxed)};
+
+		if (currentHead == tail.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		item = items[currentHead & (Capacity - 1)];
+		head.store(currentHead + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	// Get the number of queued items (from either thread, it may change right after.)
+	//
+	// - return: size_t, the number of items
+	std::size_t size() const
+	{
+		const std::size_t currentHead{head.load(std::memory_order_acquire)};
+
+		return tail.load(std::memory_order_acquire) - currentHead;
+	}
+};
+
+#endif /* SPSCQUEUE_H */
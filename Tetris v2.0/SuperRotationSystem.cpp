@@ -0,0 +1,40 @@
+#include "SuperRotationSystem.h"
+
+#include <cassert>
+
+
+// STATIC METHODS ---------------------------------------------------------
+
+const SuperRotationSystem::Offset* SuperRotationSystem::getBlockOffsets(const Tetromino::TetShape shape,
+                                                                       const int state)
+{
+	assert((state >= 0) && (state < NUM_STATES) && "Invalid rotation state.");
+
+	return BLOCK_OFFSETS[static_cast<int>(shape)][state];
+}
+
+SuperRotationSystem::Kicks SuperRotationSystem::getKicks(const Tetromino::TetShape shape, const int fromState,
+                                                         const int quarterTurns)
+{
+	assert((fromState >= 0) && (fromState < NUM_STATES) && "Invalid rotation state.");
+	assert((quarterTurns >= 1) && (quarterTurns <= 3) && "Invalid rotation.");
+
+	if (quarterTurns == 2)
+	{
+		return Kicks{KICKS_180[fromState], (shape == Tetromino::TetShape::O) ? 1 : NUM_180_KICKS};
+	}
+
+	const bool clockwise{quarterTurns == 1};
+
+	switch (shape)
+	{
+	case Tetromino::TetShape::O:
+		return Kicks{JLSTZ_KICKS_CLOCKWISE[fromState], 1};
+
+	case Tetromino::TetShape::I:
+		return Kicks{clockwise ? I_KICKS_CLOCKWISE[fromState] : I_KICKS_COUNTERCLOCKWISE[fromState], NUM_KICKS};
+
+	default:
+		return Kicks{clockwise ? JLSTZ_KICKS_CLOCKWISE[fromState] : JLSTZ_KICKS_COUNTERCLOCKWISE[fromState], NUM_KICKS};
+	}
+}
@@ -0,0 +1,130 @@
+// The SuperRotationSystem class holds the Super Rotation System (SRS) data:
+//  - The block offsets of every shape in each of its 4 rotation states
+//  - The wall kick offsets to test, in order, when rotating between states
+//
+// All data is constexpr and uses the gameboard's axes (x right, y down), so
+// the standard SRS tables (which use y up) have their y offsets negated.
+// Rotation states: 0 - spawn, 1 - R (clockwise from spawn), 2 - two rotations, 3 - L
+
+#ifndef SUPERROTATIONSYSTEM_H
+#define SUPERROTATIONSYSTEM_H
+
+#include <cstdint>
+#include "Tetromino.h"
+
+
+class SuperRotationSystem
+{
+public:
+	// TYPES ------------------------------------------------------------------
+
+	// An x,y offset (a block offset from the rotation center, or a kick)
+	struct Offset
+	{
+		std::int8_t x;
+		std::int8_t y;
+	};
+
+	// The kick offsets to test for one rotation
+	struct Kicks
+	{
+		const Offset* offsets;	// The offsets, in the order to test them
+		int count;				// Number of offsets
+	};
+
+
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int NUM_SHAPES{static_cast<int>(Tetromino::TetShape::COUNT)};
+	static constexpr int NUM_STATES{4};			// Rotation states per shape
+	static constexpr int NUM_BLOCKS{4};			// Blocks per shape
+	static constexpr int NUM_KICKS{5};			// Kicks per 90 degree rotation
+	static constexpr int NUM_180_KICKS{6};		// Kicks per 180 degree rotation
+
+	// Block offsets [shape][state][block], in TetShape order
+	//  - Note: TetShape::S is the red, Z-shaped piece, and TetShape::Z is the
+	//     green, S-shaped piece, so they use the SRS Z and S data respectively
+	static constexpr Offset BLOCK_OFFSETS[NUM_SHAPES][NUM_STATES][NUM_BLOCKS]
+	{
+		// S
+		{{{-1, -1}, { 0, -1}, { 0,  0}, { 1,  0}}, {{ 1, -1}, { 1,  0}, { 0,  0}, { 0,  1}}, {{ 1,  1}, { 0,  1}, { 0,  0}, {-1,  0}}, {{-1,  1}, {-1,  0}, { 0,  0}, { 0, -1}}},
+		// Z
+		{{{-1,  0}, { 0,  0}, { 0, -1}, { 1, -1}}, {{ 0, -1}, { 0,  0}, { 1,  0}, { 1,  1}}, {{ 1,  0}, { 0,  0}, { 0,  1}, {-1,  1}}, {{ 0,  1}, { 0,  0}, {-1,  0}, {-1, -1}}},
+		// L
+		{{{-1,  0}, { 0,  0}, { 1,  0}, { 1, -1}}, {{ 0, -1}, { 0,  0}, { 0,  1}, { 1,  1}}, {{ 1,  0}, { 0,  0}, {-1,  0}, {-1,  1}}, {{ 0,  1}, { 0,  0}, { 0, -1}, {-1, -1}}},
+		// J
+		{{{-1, -1}, {-1,  0}, { 0,  0}, { 1,  0}}, {{ 1, -1}, { 0, -1}, { 0,  0}, { 0,  1}}, {{ 1,  1}, { 1,  0}, { 0,  0}, {-1,  0}}, {{-1,  1}, { 0,  1}, { 0,  0}, { 0, -1}}},
+		// O
+		{{{-1, -1}, { 0, -1}, {-1,  0}, { 0,  0}}, {{-1, -1}, { 0, -1}, {-1,  0}, { 0,  0}}, {{-1, -1}, { 0, -1}, {-1,  0}, { 0,  0}}, {{-1, -1}, { 0, -1}, {-1,  0}, { 0,  0}}},
+		// I
+		{{{-2,  0}, {-1,  0}, { 0,  0}, { 1,  0}}, {{ 0, -1}, { 0,  0}, { 0,  1}, { 0,  2}}, {{-2,  1}, {-1,  1}, { 0,  1}, { 1,  1}}, {{-1, -1}, {-1,  0}, {-1,  1}, {-1,  2}}},
+		// T
+		{{{-1,  0}, { 0,  0}, { 1,  0}, { 0, -1}}, {{ 0, -1}, { 0,  0}, { 0,  1}, { 1,  0}}, {{ 1,  0}, { 0,  0}, {-1,  0}, { 0,  1}}, {{ 0,  1}, { 0,  0}, { 0, -1}, {-1,  0}}},
+	};
+
+	// J, L, S, T, Z clockwise kicks [from state][kick]
+	static constexpr Offset JLSTZ_KICKS_CLOCKWISE[NUM_STATES][NUM_KICKS]
+	{
+		{{ 0,  0}, {-1,  0}, {-1, -1}, { 0,  2}, {-1,  2}}, // 0 -> R
+		{{ 0,  0}, { 1,  0}, { 1,  1}, { 0, -2}, { 1, -2}}, // R -> 2
+		{{ 0,  0}, { 1,  0}, { 1, -1}, { 0,  2}, { 1,  2}}, // 2 -> L
+		{{ 0,  0}, {-1,  0}, {-1,  1}, { 0, -2}, {-1, -2}}, // L -> 0
+	};
+
+	// J, L, S, T, Z counter-clockwise kicks [from state][kick]
+	static constexpr Offset JLSTZ_KICKS_COUNTERCLOCKWISE[NUM_STATES][NUM_KICKS]
+	{
+		{{ 0,  0}, { 1,  0}, { 1, -1}, { 0,  2}, { 1,  2}}, // 0 -> L
+		{{ 0,  0}, { 1,  0}, { 1,  1}, { 0, -2}, { 1, -2}}, // R -> 0
+		{{ 0,  0}, {-1,  0}, {-1, -1}, { 0,  2}, {-1,  2}}, // 2 -> R
+		{{ 0,  0}, {-1,  0}, {-1,  1}, { 0, -2}, {-1, -2}}, // L -> 2
+	};
+
+	// I clockwise kicks [from state][kick]
+	static constexpr Offset I_KICKS_CLOCKWISE[NUM_STATES][NUM_KICKS]
+	{
+		{{ 0,  0}, {-2,  0}, { 1,  0}, {-2,  1}, { 1, -2}}, // 0 -> R
+		{{ 0,  0}, {-1,  0}, { 2,  0}, {-1, -2}, { 2,  1}}, // R -> 2
+		{{ 0,  0}, { 2,  0}, {-1,  0}, { 2, -1}, {-1,  2}}, // 2 -> L
+		{{ 0,  0}, { 1,  0}, {-2,  0}, { 1,  2}, {-2, -1}}, // L -> 0
+	};
+
+	// I counter-clockwise kicks [from state][kick]
+	static constexpr Offset I_KICKS_COUNTERCLOCKWISE[NUM_STATES][NUM_KICKS]
+	{
+		{{ 0,  0}, {-1,  0}, { 2,  0}, {-1, -2}, { 2,  1}}, // 0 -> L
+		{{ 0,  0}, { 2,  0}, {-1,  0}, { 2, -1}, {-1,  2}}, // R -> 0
+		{{ 0,  0}, { 1,  0}, {-2,  0}, { 1,  2}, {-2, -1}}, // 2 -> R
+		{{ 0,  0}, {-2,  0}, { 1,  0}, {-2,  1}, { 1, -2}}, // L -> 2
+	};
+
+	// 180 degree kicks for all shapes [from state][kick]
+	//  - SRS has no 180 degree rotation, these are the common SRS+ extension
+	static constexpr Offset KICKS_180[NUM_STATES][NUM_180_KICKS]
+	{
+		{{ 0,  0}, { 0, -1}, { 1, -1}, {-1, -1}, { 1,  0}, {-1,  0}}, // 0 -> 2
+		{{ 0,  0}, { 1,  0}, { 1, -2}, { 1, -1}, { 0, -2}, { 0, -1}}, // R -> L
+		{{ 0,  0}, { 0,  1}, {-1,  1}, { 1,  1}, {-1,  0}, { 1,  0}}, // 2 -> 0
+		{{ 0,  0}, {-1,  0}, {-1, -2}, {-1, -1}, { 0, -2}, { 0, -1}}, // L -> R
+	};
+
+
+	// STATIC METHODS ---------------------------------------------------------
+
+	// Get the block offsets of a shape in a rotation state.
+	//
+	// - param 1: TetShape shape
+	// - param 2: int, the rotation state (0 - 3)
+	// - return: a pointer to the NUM_BLOCKS offsets
+	static const Offset* getBlockOffsets(Tetromino::TetShape shape, int state);
+
+	// Get the kicks to test for a rotation.
+	//  - The O shape only tests the first (no) kick
+	//
+	// - param 1: TetShape shape
+	// - param 2: int, the rotation state being rotated from (0 - 3)
+	// - param 3: int, quarter turns clockwise (1 - clockwise, 2 - 180, 3 - counter-clockwise)
+	// - return: Kicks, the offsets to test in order
+	static Kicks getKicks(Tetromino::TetShape shape, int fromState, int quarterTurns);
+};
+
+#endif /* SUPERROTATIONSYSTEM_H */
@@ -0,0 +1,143 @@
+// Checks that GameState plays like TetrisSimulation, built as a console program outside the
+// game project:
+//
+//   g++ -std=c++17 -I.. GameStateTests.cpp ../GameState.cpp ../TetrisSimulation.cpp ../Gameboard.cpp ../GarbageQueue.cpp
+//       ../GravityCurve.cpp ../GridTetromino.cpp ../Tetromino.cpp ../SuperRotationSystem.cpp ../ShapeBag.cpp
+//       ../Actions.cpp ../Point.cpp ../Random.cpp -o GameStateTests
+//
+// Plays seeded games of random placements. Before each placement, a GameState is copied from
+// the game, and every placement is played through both: they must list the same placements,
+// and leave the same board, score, lines, hold state, current shape and top out. Prints each
+// failed check, and exits with EXIT_FAILURE if any failed.
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include "GameState.h"
+#include "Random.h"
+#include "TetrisSimulation.h"
+
+
+using Board = TetrisSimulation::Board;
+using Placement = TetrisSimulation::Placement;
+
+static constexpr int NUM_GAMES{40};				// Games played
+static constexpr int MAX_PLACEMENTS_PER_GAME{300};	// Placements before a game is cut off
+
+static int failures{0};		// Checks failed so far
+
+// Count and print a failed check
+static void check(const bool passed, const char* const what)
+{
+	if (!passed)
+	{
+		std::cerr << "FAILED: " << what << '\n';
+		failures++;
+	}
+}
+
+// Determine if a game state has the blocks of a board (hidden rows included)
+static bool sameBoard(const GameState& state, const Board& board)
+{
+	for (int y{-Board::HIDDEN_ROWS}; y < Board::MAX_Y; y++)
+	{
+		Board::RowMask row{0};
+
+		for (int x{0}; x < Board::MAX_X; x++)
+		{
+			row |= static_cast<Board::RowMask>((board.getContent(x, y) != Board::EMPTY_BLOCK) ? 1u << x : 0u);
+		}
+
+		if (state.getRow(y) != row)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Determine if a game state has the hold state of a game
+static bool sameHold(const GameState& state, const TetrisSimulation& simulation)
+{
+	Tetromino::TetShape stateShape;
+	Tetromino::TetShape simulationShape;
+	const bool stateSet{state.getHoldShape(stateShape)};
+	const bool simulationSet{simulation.getHoldShape(simulationShape)};
+
+	return (stateSet == simulationSet) && (!stateSet || (stateShape == simulationShape))
+		&& (state.isHoldAvailable() == simulation.isHoldAvailable());
+}
+
+// Determine if a game state is the same game as a simulation (as far as a GameState keeps it)
+static bool sameGame(const GameState& state, const TetrisSimulation& simulation)
+{
+	return (state.isGameOver() == simulation.isGameOver()) && (state.getScore() == simulation.getScore())
+		&& (state.getLines() == simulation.getLines()) && sameHold(state, simulation)
+		&& (simulation.isGameOver() || ((state.getCurrentShape() == simulation.getCurrentShape())
+		                                && sameBoard(state, simulation.getBoard())));
+}
+
+// Determine if two placement lists are the same, in the same order
+static bool samePlacements(const Placement a[], const int countA, const Placement b[], const int countB)
+{
+	bool same{countA == countB};
+
+	for (int i{0}; same && (i < countA); i++)
+	{
+		same = (a[i].useHold == b[i].useHold) && (a[i].rotation == b[i].rotation) && (a[i].x == b[i].x) && (a[i].y == b[i].y);
+	}
+
+	return same;
+}
+
+
+int main()
+{
+	Random random{1};
+	std::int64_t placementsChecked{0};
+
+	for (int game{0}; game < NUM_GAMES; game++)
+	{
+		TetrisSimulation simulation{static_cast<std::uint32_t>(game * 77 + 1)};
+
+		for (int n{0}; (n < MAX_PLACEMENTS_PER_GAME) && !simulation.isGameOver(); n++)
+		{
+			const GameState state{simulation, static_cast<std::uint32_t>(n)};
+
+			check(sameGame(state, simulation), "a copied game state is the same game");
+
+			Placement placements[TetrisSimulation::MAX_PLACEMENTS];
+			Placement statePlacements[GameState::MAX_PLACEMENTS];
+			const int count{simulation.getPlacements(placements)};
+
+			check(samePlacements(placements, count, statePlacements, state.getPlacements(statePlacements)),
+			      "a game state lists the same placements in the same order");
+
+			// Every placement leaves the same game
+			for (int i{0}; i < count; i++)
+			{
+				TetrisSimulation played{simulation};
+				GameState statePlayed{state};
+
+				check(played.place(placements[i]) == statePlayed.place(placements[i]), "a placement is played by both or neither");
+				check(sameGame(statePlayed, played), "a placement leaves the same board, score, lines and hold state");
+
+				placementsChecked++;
+			}
+
+			if (count == 0)
+			{
+				break;
+			}
+
+			simulation.place(placements[random.nextInt(count)]);
+		}
+	}
+
+	check(placementsChecked > 10000, "the games play enough placements to compare");
+
+	std::cout << "Placements compared: " << placementsChecked << '\n';
+
+	return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,147 @@
+// Throughput of the Gameboard packed forms, built as a console program outside the game project:
+//
+//   g++ -std=c++17 -O2 -DNDEBUG -I.. GameboardBenchmark.cpp ../Gameboard.cpp ../Point.cpp ../Random.cpp -o GameboardBenchmark
+//
+// Packs and unpacks a set of random 10x19 boards (the game's board, hidden rows included)
+// many times over, and prints the boards per second of each form against its target (on
+// a desktop CPU, one thread). Exits with EXIT_FAILURE if a form is below its target.
+//  - The occupancy forms and the color pack only move bits (the board keeps its contents
+//     as bit masks too), so their targets are tens of millions of boards a second
+//  - Unpacking to a board also rebuilds every block's content byte and the column masks,
+//     so its target is a few million
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "Gameboard.h"
+#include "Random.h"
+
+
+using Board = Gameboard<10, 19>;
+using Clock = std::chrono::steady_clock;
+
+static constexpr int NUM_BOARDS{4096};			// Boards in the set (fits in the L2 cache packed)
+static constexpr int PASSES{2000};				// Passes over the set by the fast forms
+static constexpr int SLOW_PASSES{100};			// Passes over the set by the forms that rebuild a board
+
+// Targets, in million boards per second
+static constexpr double OCCUPANCY_TARGET{50.0};	// pack() and unpackRowMasks()
+static constexpr double COLORS_TARGET{10.0};		// pack() with colors
+static constexpr double BOARD_TARGET{3.0};			// unpack() to a board
+
+
+static bool allOnTarget{true};	// False once a form was below its target
+
+// Print the rate of a number of boards handled since a start time, and its target
+static void printRate(const char* const what, const Clock::time_point start, const std::int64_t boards, const double target)
+{
+	const double seconds{std::chrono::duration<double>(Clock::now() - start).count()};
+	const double rate{boards / seconds / 1e6};
+
+	std::cout << what << ": " << rate << " M boards/s (target " << target << (rate >= target ? ")\n" : ", BELOW TARGET)\n");
+
+	allOnTarget = allOnTarget && (rate >= target);
+}
+
+
+int main()
+{
+	// Random boards, filled from the bottom up to a random height with random contents
+	std::vector<Board> boards(NUM_BOARDS);
+	Random random{1};
+
+	for (Board& board : boards)
+	{
+		const int height{random.nextInt(Board::TOTAL_ROWS)};
+
+		for (int y{Board::MAX_Y - height}; y < Board::MAX_Y; y++)
+		{
+			for (int x{0}; x < Board::MAX_X; x++)
+			{
+				if (random.nextInt(4) != 0)
+				{
+					board.setContent(x, y, random.nextInt(8));
+				}
+			}
+		}
+	}
+
+	std::vector<Board::PackedBoard> packed(NUM_BOARDS);
+	std::vector<Board::PackedColors> colors(NUM_BOARDS);
+	std::vector<Board::RowMask> rowMasks(Board::TOTAL_ROWS);
+	Board unpacked;
+	std::uint64_t sink{0};	// Read back, so no loop is optimized away
+
+	Clock::time_point start{Clock::now()};
+
+	for (int pass{0}; pass < PASSES; pass++)
+	{
+		for (int i{0}; i < NUM_BOARDS; i++)
+		{
+			boards[i].pack(packed[i]);
+		}
+
+		sink += packed[pass % NUM_BOARDS].occupancy[0];
+	}
+
+	printRate("pack() occupancy", start, static_cast<std::int64_t>(PASSES) * NUM_BOARDS, OCCUPANCY_TARGET);
+
+	start = Clock::now();
+
+	for (int pass{0}; pass < PASSES; pass++)
+	{
+		for (int i{0}; i < NUM_BOARDS; i++)
+		{
+			Board::unpackRowMasks(packed[i], rowMasks.data());
+			sink += rowMasks[Board::TOTAL_ROWS - 1];
+		}
+	}
+
+	printRate("unpackRowMasks()", start, static_cast<std::int64_t>(PASSES) * NUM_BOARDS, OCCUPANCY_TARGET);
+
+	start = Clock::now();
+
+	for (int pass{0}; pass < PASSES; pass++)
+	{
+		for (int i{0}; i < NUM_BOARDS; i++)
+		{
+			boards[i].pack(packed[i], colors[i]);
+		}
+
+		sink += colors[pass % NUM_BOARDS].planes[0][0];
+	}
+
+	printRate("pack() occupancy and colors", start, static_cast<std::int64_t>(PASSES) * NUM_BOARDS, COLORS_TARGET);
+
+	start = Clock::now();
+
+	for (int pass{0}; pass < SLOW_PASSES; pass++)
+	{
+		for (int i{0}; i < NUM_BOARDS; i++)
+		{
+			unpacked.unpack(packed[i], 7);
+			sink += unpacked.getColumnHeight(i % Board::MAX_X);
+		}
+	}
+
+	printRate("unpack() occupancy to a board", start, static_cast<std::int64_t>(SLOW_PASSES) * NUM_BOARDS, BOARD_TARGET);
+
+	start = Clock::now();
+
+	for (int pass{0}; pass < SLOW_PASSES; pass++)
+	{
+		for (int i{0}; i < NUM_BOARDS; i++)
+		{
+			unpacked.unpack(packed[i], colors[i]);
+			sink += unpacked.getColumnHeight(i % Board::MAX_X);
+		}
+	}
+
+	printRate("unpack() occupancy and colors to a board", start, static_cast<std::int64_t>(SLOW_PASSES) * NUM_BOARDS, BOARD_TARGET);
+
+	std::cout << "(" << sink % 10 << ")\n";
+
+	return allOnTarget ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,266 @@
+// Checks of the Gameboard class, built as a console program outside the game project:
+//
+//   g++ -std=c++17 -I.. GameboardTests.cpp ../Gameboard.cpp ../Point.cpp -o GameboardTests
+//
+// Prints each failed check, and exits with EXIT_FAILURE if any failed.
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Gameboard.h"
+
+
+static int failures{0};		// Checks failed so far
+
+// Count and print a failed check
+static void check(const bool passed, const char* const what)
+{
+	if (!passed)
+	{
+		std::cerr << "FAILED: " << what << '\n';
+		failures++;
+	}
+}
+
+// A completed row is found and cleared on every supported width, and the rows above drop
+// into its place (FULL_ROW_MASK has exactly one bit per column).
+template <typename Board>
+static void checkRowClear()
+{
+	Board board;
+	const int bottom{Board::MAX_Y - 1};
+
+	// Fill the bottom row but its last block, with one block on top of it
+	for (int x{0}; x < Board::MAX_X - 1; x++)
+	{
+		board.setContent(x, bottom, 1);
+	}
+
+	board.setContent(0, bottom - 1, 2);
+
+	check(board.removeCompletedRows() == 0, "a row with an empty block is not cleared");
+	check(board.getRowFillCount(bottom) == Board::MAX_X - 1, "an incomplete row keeps its blocks");
+
+	// Complete it
+	board.setContent(Board::MAX_X - 1, bottom, 1);
+
+	check(board.removeCompletedRows() == 1, "a completed row is cleared");
+	check(board.getRowFillCount(bottom) == 1, "the row above drops into the cleared row");
+	check(board.getContent(0, bottom) == 2, "the dropped block keeps its content");
+	check(board.getColumnHeight(0) == 1, "the column height follows the clear");
+
+	// The same through the locked shape's rows
+	std::vector<Point> locs;
+
+	for (int x{1}; x < Board::MAX_X; x++)
+	{
+		locs.push_back(Point{x, bottom});
+	}
+
+	board.setContent(locs.data(), static_cast<int>(locs.size()), 3);
+
+	check(board.removeCompletedRows(locs.data(), static_cast<int>(locs.size())) == 1, "a row completed by the touched blocks is cleared");
+	check(board.getRowFillCount(bottom) == 0, "the board is empty after both clears");
+}
+
+// Fill a board with every content (0 - 7, 7 being garbage) in a fixed pattern, the hidden
+// rows included, leaving some blocks empty.
+template <typename Board>
+static Board makePatternBoard()
+{
+	Board board;
+
+	for (int y{-Board::HIDDEN_ROWS}; y < Board::MAX_Y; y++)
+	{
+		for (int x{0}; x < Board::MAX_X; x++)
+		{
+			if ((x * 7 + y * 3 + 100) % 5 != 0)
+			{
+				board.setContent(x, y, (x + y + Board::HIDDEN_ROWS) % 8);
+			}
+		}
+	}
+
+	return board;
+}
+
+// Determine if two boards have the same contents, column heights and drop distances.
+template <typename Board>
+static bool isSameBoard(const Board& a, const Board& b)
+{
+	for (int x{0}; x < Board::MAX_X; x++)
+	{
+		if (a.getColumnHeight(x) != b.getColumnHeight(x))
+		{
+			return false;
+		}
+
+		for (int y{-Board::HIDDEN_ROWS}; y < Board::MAX_Y; y++)
+		{
+			if ((a.getContent(x, y) != b.getContent(x, y)) || (a.getDropDistance(x, y) != b.getDropDistance(x, y)))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+// A board packed and unpacked (occupancy alone, and with the contents) is the same board,
+// hidden rows and garbage included.
+template <typename Board>
+static void checkPackRoundTrip()
+{
+	const Board board{makePatternBoard<Board>()};
+
+	typename Board::PackedBoard packed;
+	typename Board::PackedColors colors;
+	board.pack(packed, colors);
+
+	// Unpacked over a board that is not empty
+	Board unpacked;
+	unpacked.setContent(0, Board::MAX_Y - 1, 3);
+	unpacked.unpack(packed, colors);
+
+	check(isSameBoard(board, unpacked), "pack() and unpack() with contents give the same board");
+
+	// The occupancy alone, every block unpacked as garbage
+	typename Board::PackedBoard occupancy;
+	board.pack(occupancy);
+
+	Board garbage;
+	garbage.unpack(occupancy, 7);
+
+	// The occupancy alone, as row masks (and packed back)
+	typename Board::RowMask rowMasks[Board::TOTAL_ROWS];
+	Board::unpackRowMasks(occupancy, rowMasks);
+
+	bool sameBlocks{true};
+	bool sameRows{true};
+
+	for (int y{-Board::HIDDEN_ROWS}; y < Board::MAX_Y; y++)
+	{
+		for (int x{0}; x < Board::MAX_X; x++)
+		{
+			const bool filled{board.getContent(x, y) != Board::EMPTY_BLOCK};
+
+			sameBlocks = sameBlocks && (garbage.getContent(x, y) == (filled ? 7 : Board::EMPTY_BLOCK));
+			sameRows = sameRows && ((((rowMasks[y + Board::HIDDEN_ROWS] >> x) & 1) != 0) == filled);
+		}
+	}
+
+	check(sameBlocks, "unpack() of the occupancy fills the same blocks with one content");
+	check(sameRows, "unpackRowMasks() gives the occupancy of each row");
+
+	typename Board::PackedBoard repacked;
+	Board::packRowMasks(rowMasks, repacked);
+
+	bool sameWords{true};
+
+	for (int i{0}; i < Board::PACKED_WORDS; i++)
+	{
+		sameWords = sameWords && (repacked.occupancy[i] == occupancy.occupancy[i]);
+	}
+
+	check(sameWords, "packRowMasks() gives back the packed occupancy");
+}
+
+// The packed contents follow every edit of a board (the board keeps them as color masks,
+// updated by each edit rather than read from the blocks when packed.)
+template <typename Board>
+static void checkPackAfterEdits()
+{
+	Board board{makePatternBoard<Board>()};
+
+	// Clear a row, remove a block, and push up some garbage
+	for (int x{0}; x < Board::MAX_X; x++)
+	{
+		board.setContent(x, Board::MAX_Y - 3, 5);
+	}
+
+	check(board.removeCompletedRows() >= 1, "a filled row of the pattern board is cleared");
+
+	board.setContent(1, Board::MAX_Y - 1, Board::EMPTY_BLOCK);
+	board.insertGarbageRows(2, 0, 7);
+	board.setContent(0, Board::MAX_Y - 1, 6);
+
+	typename Board::PackedBoard packed;
+	typename Board::PackedColors colors;
+	board.pack(packed, colors);
+
+	Board unpacked;
+	unpacked.unpack(packed, colors);
+
+	check(isSameBoard(board, unpacked), "pack() after clears, garbage and edits gives the same board");
+}
+
+// Text fixtures are read into a board and written back unchanged, hidden rows included.
+static void checkTextRoundTrip()
+{
+	// A Z block above a garbage row
+	const std::string lowText{"......Z.../XXXX.XXXXX"};
+
+	Gameboard<10, 20> low;
+
+	check(low.fromText(lowText), "a text fixture is read");
+	check(low.toText() == lowText, "a text fixture is written back unchanged");
+	check(low.getContent(6, 18) == 0, "Z is content 0");
+	check(low.getContent(0, 19) == 7, "X is garbage (content 7)");
+	check(low.getContent(4, 19) == Gameboard<10, 20>::EMPTY_BLOCK, "'.' is an empty block");
+
+	// Every row of a narrow board, the 4 hidden rows first
+	const std::string tallText{
+		"I.../I.../I.../I.../"
+		"..../..../..../..../..../..../..../..../"
+		"..../..../T.../TT../T..J/OO.J/OOJJ/LSSZ/"
+		"LLSS/ZZ.L/.ZZL/XX.X"};
+
+	Gameboard<4, 20> tall;
+
+	check(tall.fromText(tallText), "a text fixture of every row is read");
+	check(tall.toText() == tallText, "a text fixture of every row is written back unchanged");
+	check(tall.getContent(0, -4) == 4, "the first row is the top hidden row");
+	check(tall.getColumnHeight(0) == 24, "a column reaching the top hidden row is 24 high");
+
+	// The text form survives packing
+	Gameboard<4, 20>::PackedBoard packed;
+	Gameboard<4, 20>::PackedColors colors;
+	tall.pack(packed, colors);
+
+	Gameboard<4, 20> unpacked;
+	unpacked.unpack(packed, colors);
+
+	check(unpacked.toText() == tallText, "a text fixture survives pack() and unpack()");
+
+	// Invalid text leaves the board as it was
+	check(!low.fromText("......Z.."), "a row of the wrong width is invalid");
+	check(!low.fromText("......Q..."), "an unknown letter is invalid");
+	check(!tall.fromText(tallText + "/...."), "more rows than the board has are invalid");
+	check(low.toText() == lowText, "the board is not changed by invalid text");
+}
+
+
+int main()
+{
+	checkRowClear<Gameboard<10, 20>>();
+	checkRowClear<Gameboard<4, 20>>();
+	checkRowClear<Gameboard<16, 20>>();
+
+	checkPackRoundTrip<Gameboard<10, 19>>();
+	checkPackRoundTrip<Gameboard<10, 40>>();
+	checkPackRoundTrip<Gameboard<4, 20>>();
+	checkPackRoundTrip<Gameboard<16, 20>>();
+
+	checkPackAfterEdits<Gameboard<10, 19>>();
+	checkPackAfterEdits<Gameboard<10, 40>>();
+	checkPackAfterEdits<Gameboard<4, 20>>();
+	checkPackAfterEdits<Gameboard<16, 20>>();
+
+	checkTextRoundTrip();
+
+	std::cout << ((failures == 0) ? "All Gameboard checks passed\n" : "Some Gameboard checks failed\n");
+
+	return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,207 @@
+// Checks that stepping a TetrisEnv never allocates, built as a console program outside the
+// game project:
+//
+//   g++ -std=c++17 -O2 -I.. TetrisEnvAllocationTests.cpp ../TetrisEnv.cpp ../TetrisSimulation.cpp ../Gameboard.cpp
+//       ../GarbageQueue.cpp ../GravityCurve.cpp ../GridTetromino.cpp ../Tetromino.cpp ../SuperRotationSystem.cpp
+//       ../ShapeBag.cpp ../Actions.cpp ../Point.cpp ../Random.cpp -o TetrisEnvAllocationTests
+//
+// Replaces the global operator new to count every allocation, warms a batch of environments
+// up, then plays a long seeded sequence of placement, batch and tick steps (with resets,
+// observes and restores) and checks that none of it allocated. Prints each failed check, and
+// exits with EXIT_FAILURE if any failed.
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+#include "Random.h"
+#include "TetrisEnv.h"
+
+
+static std::int64_t allocations{0};		// Calls to the global operator new so far
+
+void* operator new(const std::size_t size)
+{
+	allocations++;
+
+	if (void* const memory{std::malloc((size > 0) ? size : 1)})
+	{
+		return memory;
+	}
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* const memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* const memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* const memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* const memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+
+static constexpr int NUM_ENVS{64};			// Environments stepped together
+static constexpr int WARM_UP_STEPS{200};	// Batch steps before counting
+static constexpr int STEPS{5000};			// Batch steps counted
+static constexpr int TICK_STEPS{20000};		// Tick steps counted
+
+static int failures{0};		// Checks failed so far
+
+// Count and print a failed check
+static void check(const bool passed, const char* const what)
+{
+	if (!passed)
+	{
+		std::cerr << "FAILED: " << what << '\n';
+		failures++;
+	}
+}
+
+// Pick a random placement that can be played (-1 if none can)
+static std::int32_t pickPlacement(const TetrisEnvObservation& observation, Random& random)
+{
+	std::int32_t playable[TETRIS_ENV_NUM_PLACEMENTS];
+	int count{0};
+
+	for (std::int32_t i{0}; i < TETRIS_ENV_NUM_PLACEMENTS; i++)
+	{
+		if (observation.placementMask[i] != 0)
+		{
+			playable[count++] = i;
+		}
+	}
+
+	return (count > 0) ? playable[random.nextInt(count)] : -1;
+}
+
+// Play one batch step of every environment with random placements, and reset the games that
+// ended (with the next seed)
+static void stepAll(std::vector<TetrisEnv*>& envs, std::vector<TetrisEnvObservation>& observations,
+	std::vector<std::int32_t>& placements, std::vector<float>& rewards, std::vector<std::uint8_t>& done,
+	Random& random, std::uint32_t& seed)
+{
+	for (int i{0}; i < NUM_ENVS; i++)
+	{
+		placements[i] = pickPlacement(observations[i], random);
+	}
+
+	tetrisEnvStepBatch(envs.data(), NUM_ENVS, placements.data(), observations.data(), rewards.data(), done.data());
+
+	for (int i{0}; i < NUM_ENVS; i++)
+	{
+		if (done[i] != 0)
+		{
+			tetrisEnvReset(envs[i], seed++, &observations[i]);
+		}
+	}
+}
+
+
+int main()
+{
+	std::vector<TetrisEnv*> envs(NUM_ENVS);
+	std::vector<TetrisEnvObservation> observations(NUM_ENVS);
+	std::vector<std::int32_t> placements(NUM_ENVS);
+	std::vector<float> rewards(NUM_ENVS);
+	std::vector<std::uint8_t> done(NUM_ENVS);
+	Random random{1};
+	std::uint32_t seed{1};
+
+	for (int i{0}; i < NUM_ENVS; i++)
+	{
+		envs[i] = tetrisEnvCreate(seed++);
+		tetrisEnvObserve(envs[i], &observations[i]);
+	}
+
+	TetrisEnv* const saved{tetrisEnvClone(envs[0])};
+	TetrisEnvObservation observation;
+	float reward;
+	std::uint8_t gameOver;
+
+	// Warm up (every game has reset at least once, and restored from a clone)
+	for (int step{0}; step < WARM_UP_STEPS; step++)
+	{
+		stepAll(envs, observations, placements, rewards, done, random, seed);
+	}
+
+	tetrisEnvRestore(envs[0], saved);
+	tetrisEnvObserve(envs[0], &observations[0]);
+
+	const std::int64_t warmAllocations{allocations};
+	std::int64_t games{0};
+
+	// Batch steps, with a single placement step and a restore now and then
+	for (int step{0}; step < STEPS; step++)
+	{
+		stepAll(envs, observations, placements, rewards, done, random, seed);
+
+		const std::int32_t placement{pickPlacement(observations[1], random)};
+
+		if (tetrisEnvStepPlacement(envs[1], placement, &observations[1], &reward, &gameOver) && (gameOver != 0))
+		{
+			tetrisEnvReset(envs[1], seed++, &observations[1]);
+		}
+
+		if (step % 100 == 0)
+		{
+			tetrisEnvRestore(envs[0], saved);
+			tetrisEnvObserve(envs[0], &observations[0]);
+		}
+	}
+
+	check(allocations == warmAllocations, "placement, batch and restore steps do not allocate after warm-up");
+
+	// Tick steps, with random actions held for a few ticks
+	const std::int64_t tickAllocations{allocations};
+	std::uint16_t held{0};
+
+	for (int tick{0}; tick < TICK_STEPS; tick++)
+	{
+		const std::uint16_t pressed{static_cast<std::uint16_t>((tick % 8 == 0) ? (1 << random.nextInt(8)) : 0)};
+		const std::uint16_t released{static_cast<std::uint16_t>((tick % 8 == 4) ? held : 0)};
+
+		held = static_cast<std::uint16_t>((held | pressed) & ~released);
+
+		tetrisEnvStepActions(envs[2], pressed, released, &observation, &reward, &gameOver);
+
+		if (gameOver != 0)
+		{
+			tetrisEnvReset(envs[2], seed++, &observation);
+			held = 0;
+			games++;
+		}
+	}
+
+	check(allocations == tickAllocations, "tick steps do not allocate after warm-up");
+
+	std::cout << "Allocations: " << allocations - warmAllocations << " over " << STEPS * (NUM_ENVS + 1) + TICK_STEPS
+		<< " steps (" << games << " tick step games)\n";
+
+	tetrisEnvDestroy(saved);
+
+	for (TetrisEnv* const env : envs)
+	{
+		tetrisEnvDestroy(env);
+	}
+
+	return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
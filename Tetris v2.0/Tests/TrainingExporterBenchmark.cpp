@@ -0,0 +1,96 @@
+// Throughput of the TrainingExporter at 1, 2 and N workers, built as a console program outside
+// the game project:
+//
+//   g++ -std=c++17 -O2 -DNDEBUG -I.. TrainingExporterBenchmark.cpp ../TrainingExporter.cpp ../PlacementPolicy.cpp
+//       ../GameState.cpp ../WorkStealingPool.cpp ../TetrisSimulation.cpp ../Gameboard.cpp ../GarbageQueue.cpp
+//       ../GravityCurve.cpp ../GridTetromino.cpp ../Tetromino.cpp ../SuperRotationSystem.cpp ../ShapeBag.cpp
+//       ../Actions.cpp ../Point.cpp ../Random.cpp -pthread -o TrainingExporterBenchmark
+//
+//   TrainingExporterBenchmark [records] [path prefix]
+//
+// Exports the same records (one default sized shard, by default) with 1 worker, 2 workers and
+// one worker per hardware thread, and prints the records per second of each and the speedup
+// over 1 worker. The shards are read back and compared, and the program exits with
+// EXIT_FAILURE if a worker count wrote different files (the export must be deterministic.)
+// The shard files are removed afterwards.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TrainingExporter.h"
+
+
+// Read every shard of an export, and remove the files
+static std::vector<std::vector<char>> readShards(const std::string& pathPrefix, const int shards)
+{
+	std::vector<std::vector<char>> contents;
+
+	for (int shard{0}; shard < shards; shard++)
+	{
+		const std::string path{TrainingExporter::getShardPath(pathPrefix, shard)};
+
+		{
+			std::ifstream file(path, std::ios::binary);
+			contents.emplace_back(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		}
+
+		std::remove(path.c_str());
+	}
+
+	return contents;
+}
+
+
+int main(int argc, char* argv[])
+{
+	TrainingExporter::Settings settings;
+	settings.records = (argc > 1) ? std::stoll(argv[1]) : 200000;
+	settings.pathPrefix = (argc > 2) ? argv[2] : "exporter-benchmark";
+
+	std::vector<int> workerCounts{1, 2};
+	const int hardwareThreads{static_cast<int>(std::thread::hardware_concurrency())};
+
+	if (hardwareThreads > 2)
+	{
+		workerCounts.push_back(hardwareThreads);
+	}
+
+	std::cout << settings.records << " records, " << TrainingExporter::getRecordsPerShard(settings.shardBytes)
+		<< " per shard, " << TrainingExporter::CHUNK_RECORDS << " per chunk, " << std::max(hardwareThreads, 1) << " hardware threads\n";
+
+	std::vector<std::vector<char>> firstShards;
+	double firstRate{0.0};
+	bool allIdentical{true};
+
+	for (const int workers : workerCounts)
+	{
+		settings.numWorkers = workers;
+
+		TrainingExporter exporter(settings);
+		const TrainingExporter::Result result{exporter.run()};
+		const double rate{result.records / std::max(result.seconds, 1e-9)};
+
+		const std::vector<std::vector<char>> shards{readShards(settings.pathPrefix, result.shards)};
+		const bool identical{firstShards.empty() || (shards == firstShards)};
+
+		if (firstShards.empty())
+		{
+			firstShards = shards;
+			firstRate = rate;
+		}
+
+		std::cout << workers << " workers: " << rate << " records/s, " << rate / firstRate << "x"
+			<< (identical ? "\n" : ", SHARDS DIFFER\n");
+
+		allIdentical = allIdentical && identical;
+	}
+
+	return allIdentical ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,227 @@
+#include "TetrisEnv.h"
+
+#include <algorithm>
+#include <new>
+#include <type_traits>
+#include "TetrisSimulation.h"
+
+
+using Board = TetrisSimulation::Board;
+using Placement = TetrisSimulation::Placement;
+
+static_assert((TETRIS_ENV_COLUMNS == Board::MAX_X) && (TETRIS_ENV_ROWS == Board::TOTAL_ROWS), "The observed board must match the game's");
+static_assert(TETRIS_ENV_NUM_NEXT == TetrisSimulation::NUM_NEXT_SHAPES, "The observed next shapes must match the game's");
+static_assert(TETRIS_ENV_NUM_ROTATIONS == Tetromino::NUM_ROTATIONS, "Placement indices need every rotation");
+static_assert(TETRIS_ENV_NUM_PLACEMENTS == TetrisSimulation::MAX_PLACEMENTS, "Every placement needs an index");
+static_assert((TETRIS_ENV_HOLD == (1 << static_cast<int>(Action::HOLD))) && (TETRIS_ENV_MOVE_LEFT == (1 << static_cast<int>(Action::MOVE_LEFT)))
+	&& (TETRIS_ENV_HARD_DROP == (1 << static_cast<int>(Action::HARD_DROP))), "Action bits must match ActionSet's");
+static_assert(sizeof(TetrisEnvObservation) == 328, "The observation layout is part of the ABI");
+
+
+// A game, and the placements of its current shape (by placement index)
+//  - Trivially copyable, so clone and restore are plain copies
+struct TetrisEnv
+{
+	TetrisSimulation simulation;
+	Placement placements[TETRIS_ENV_NUM_PLACEMENTS];		// Valid where placementMask is set
+	std::uint8_t placementMask[TETRIS_ENV_NUM_PLACEMENTS];	// 1 if the placement index can be played
+
+	explicit TetrisEnv(const std::uint32_t seed)
+		: simulation(seed)
+	{
+	}
+};
+
+static_assert(std::is_trivially_copyable<TetrisEnv>::value, "Restore copies a game by assignment");
+
+
+// Get the placement index of a placement (see TetrisEnv.h.)
+//
+// - param 1: TetrisSimulation, the game (before the placement)
+// - param 2: Placement, the placement
+// - return: int, the placement index
+static int getPlacementIndex(const TetrisSimulation& simulation, const Placement& placement)
+{
+	Tetromino tetromino;
+	tetromino.setShape(placement.useHold ? simulation.getShapeAfterHold() : simulation.getCurrentShape());
+	tetromino.setRotation(placement.rotation);
+
+	int leftColumn{Board::MAX_X};
+
+	for (const Point& block : tetromino.getBlockLocs())
+	{
+		leftColumn = std::min(leftColumn, placement.x + block.getX());
+	}
+
+	return (placement.useHold * Tetromino::NUM_ROTATIONS + placement.rotation) * Board::MAX_X + leftColumn;
+}
+
+// Find the placements of the game's current shape, by placement index.
+//
+// - param 1: TetrisEnv, the game
+static void updatePlacements(TetrisEnv& env)
+{
+	Placement placements[TetrisSimulation::MAX_PLACEMENTS];
+	const int count{env.simulation.getPlacements(placements)};
+
+	std::fill(env.placementMask, env.placementMask + TETRIS_ENV_NUM_PLACEMENTS, std::uint8_t{0});
+
+	for (int i{0}; i < count; i++)
+	{
+		const int index{getPlacementIndex(env.simulation, placements[i])};
+
+		env.placements[index] = placements[i];
+		env.placementMask[index] = 1;
+	}
+}
+
+// Write the observation, reward and done flag of a step (each may be null.)
+//
+// - param 1: TetrisEnv, the game after the step
+// - param 2: int, the score before the step
+// - param 3: TetrisEnvObservation, the observation
+// - param 4: float, the reward
+// - param 5: uint8_t, the done flag
+static void writeStep(const TetrisEnv& env, const int scoreBefore, TetrisEnvObservation* const observation,
+                      float* const reward, std::uint8_t* const done)
+{
+	if (observation != nullptr)
+	{
+		tetrisEnvObserve(&env, observation);
+	}
+
+	if (reward != nullptr)
+	{
+		*reward = static_cast<float>(env.simulation.getScore() - scoreBefore);
+	}
+
+	if (done != nullptr)
+	{
+		*done = env.simulation.isGameOver();
+	}
+}
+
+
+// FUNCTIONS --------------------------------------------------------------
+
+std::int32_t tetrisEnvGetVersion()
+{
+	return TETRIS_ENV_VERSION;
+}
+
+TetrisEnv* tetrisEnvCreate(const std::uint32_t seed)
+{
+	TetrisEnv* const env{new (std::nothrow) TetrisEnv{seed}};
+
+	if (env != nullptr)
+	{
+		updatePlacements(*env);
+	}
+
+	return env;
+}
+
+void tetrisEnvDestroy(TetrisEnv* const env)
+{
+	delete env;
+}
+
+void tetrisEnvReset(TetrisEnv* const env, const std::uint32_t seed, TetrisEnvObservation* const observation)
+{
+	env->simulation.reset(seed);
+	updatePlacements(*env);
+
+	if (observation != nullptr)
+	{
+		tetrisEnvObserve(env, observation);
+	}
+}
+
+void tetrisEnvObserve(const TetrisEnv* const env, TetrisEnvObservation* const observation)
+{
+	const TetrisSimulation& simulation{env->simulation};
+
+	// One byte per block, from the packed occupancy (hidden rows first)
+	Board::PackedBoard packed;
+	simulation.getBoard().pack(packed);
+
+	std::uint8_t* const blocks{&observation->board[0][0]};
+
+	for (int i{0}; i < Board::PACKED_BITS; i++)
+	{
+		blocks[i] = static_cast<std::uint8_t>((packed.occupancy[i / 64] >> (i % 64)) & 1);
+	}
+
+	std::copy(env->placementMask, env->placementMask + TETRIS_ENV_NUM_PLACEMENTS, observation->placementMask);
+
+	observation->currentShape = static_cast<std::uint8_t>(simulation.getCurrentShape());
+
+	for (int i{0}; i < TETRIS_ENV_NUM_NEXT; i++)
+	{
+		observation->nextShapes[i] = static_cast<std::uint8_t>(simulation.getNextShape(i));
+	}
+
+	Tetromino::TetShape holdShape;
+	observation->holdShape = simulation.getHoldShape(holdShape) ? static_cast<std::uint8_t>(holdShape) : std::uint8_t{TETRIS_ENV_NO_SHAPE};
+	observation->gameOver = simulation.isGameOver();
+
+	observation->score = simulation.getScore();
+	observation->lines = simulation.getLines();
+	observation->pendingGarbage = simulation.getPendingGarbage();
+}
+
+std::int32_t tetrisEnvStepPlacement(TetrisEnv* const env, const std::int32_t placement, TetrisEnvObservation* const observation,
+                                    float* const reward, std::uint8_t* const done)
+{
+	const int scoreBefore{env->simulation.getScore()};
+
+	const bool placed{(placement >= 0) && (placement < TETRIS_ENV_NUM_PLACEMENTS) && (env->placementMask[placement] != 0)
+		&& env->simulation.place(env->placements[placement])};
+
+	if (placed)
+	{
+		updatePlacements(*env);
+	}
+
+	writeStep(*env, scoreBefore, observation, reward, done);
+
+	return placed;
+}
+
+void tetrisEnvStepActions(TetrisEnv* const env, const std::uint16_t pressed, const std::uint16_t released,
+                          TetrisEnvObservation* const observation, float* const reward, std::uint8_t* const done)
+{
+	const int scoreBefore{env->simulation.getScore()};
+
+	env->simulation.applyActions(ActionFrame{ActionSet{pressed}, ActionSet{released}});
+	env->simulation.step();
+
+	// The shape may have moved, rotated or locked
+	updatePlacements(*env);
+
+	writeStep(*env, scoreBefore, observation, reward, done);
+}
+
+std::int32_t tetrisEnvStepBatch(TetrisEnv* const* const envs, const std::int32_t count, const std::int32_t* const placements,
+                                TetrisEnvObservation* const observations, float* const rewards, std::uint8_t* const dones)
+{
+	std::int32_t placed{0};
+
+	for (std::int32_t i{0}; i < count; i++)
+	{
+		placed += tetrisEnvStepPlacement(envs[i], placements[i], (observations != nullptr) ? observations + i : nullptr,
+		                                 (rewards != nullptr) ? rewards + i : nullptr, (dones != nullptr) ? dones + i : nullptr);
+	}
+
+	return placed;
+}
+
+TetrisEnv* tetrisEnvClone(const TetrisEnv* const env)
+{
+	return new (std::nothrow) TetrisEnv{*env};
+}
+
+void tetrisEnvRestore(TetrisEnv* const env, const TetrisEnv* const source)
+{
+	*env = *source;
+}
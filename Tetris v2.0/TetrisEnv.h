@@ -0,0 +1,162 @@
+/* The TetrisEnv API is a C interface to the headless game, for training loops written in
+ * other languages (a gym-style environment: reset, step, clone and restore.)
+ *  - Stable C ABI: plain C types, an opaque TetrisEnv handle and fixed size structs
+ *     (TETRIS_ENV_VERSION changes if a layout or a meaning changes)
+ *  - Two kinds of step: a whole shape (a placement index, see TetrisEnvObservation::
+ *     placementMask), or one tick of raw actions (for agents that play like a player)
+ *  - No copies: observations are written straight into caller memory (such as the rows of
+ *     a numpy array of TetrisEnvObservation), and only create and clone allocate
+ *  - Batches: tetrisEnvStepBatch() steps many environments in one call. Each environment
+ *     must only be used by one thread at a time (different threads may step different ones)
+ *
+ * Placement index: (useHold * TETRIS_ENV_NUM_ROTATIONS + rotation) * TETRIS_ENV_COLUMNS
+ * + the leftmost column of the placed shape. The shape is rotated at its spawn location,
+ * shifted and hard dropped (see TetrisSimulation::getPlacements()).
+ */
+
+#ifndef TETRISENV_H
+#define TETRISENV_H
+
+#include <stdint.h>
+
+/* Build the DLL with TETRIS_ENV_EXPORTS defined, and use it without */
+#if defined(_WIN32) && defined(TETRIS_ENV_EXPORTS)
+#define TETRIS_ENV_API __declspec(dllexport)
+#elif defined(_WIN32) && defined(TETRIS_ENV_IMPORTS)
+#define TETRIS_ENV_API __declspec(dllimport)
+#else
+#define TETRIS_ENV_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* CONSTANTS -------------------------------------------------------------- */
+enum
+{
+	TETRIS_ENV_VERSION = 1,				/* Version of the API and its layouts */
+
+	TETRIS_ENV_COLUMNS = 10,			/* Board columns */
+	TETRIS_ENV_ROWS = 23,				/* Board rows (the 4 hidden rows, then the 19 visible ones) */
+	TETRIS_ENV_NUM_NEXT = 3,			/* Next shapes shown */
+	TETRIS_ENV_NUM_ROTATIONS = 4,		/* Rotation states of a shape */
+	TETRIS_ENV_NUM_PLACEMENTS = 2 * TETRIS_ENV_NUM_ROTATIONS * TETRIS_ENV_COLUMNS,	/* Placement indices */
+	TETRIS_ENV_NO_SHAPE = 255,			/* The hold shape when none is on hold */
+
+	/* Action bits of a tick step (1 << action, as in Actions.h) */
+	TETRIS_ENV_MOVE_LEFT = 1 << 0,
+	TETRIS_ENV_MOVE_RIGHT = 1 << 1,
+	TETRIS_ENV_SOFT_DROP = 1 << 2,
+	TETRIS_ENV_HARD_DROP = 1 << 3,
+	TETRIS_ENV_ROTATE_CLOCKWISE = 1 << 4,
+	TETRIS_ENV_ROTATE_COUNTERCLOCKWISE = 1 << 5,
+	TETRIS_ENV_ROTATE_180 = 1 << 6,
+	TETRIS_ENV_HOLD = 1 << 7
+};
+
+
+/* TYPES ------------------------------------------------------------------ */
+
+/* A game (opaque) */
+typedef struct TetrisEnv TetrisEnv;
+
+/* Everything an agent sees of a game (328 bytes, no padding) */
+typedef struct TetrisEnvObservation
+{
+	uint8_t board[TETRIS_ENV_ROWS][TETRIS_ENV_COLUMNS];		/* 1 if the block is filled, 0 if empty */
+	uint8_t placementMask[TETRIS_ENV_NUM_PLACEMENTS];		/* 1 if the placement index can be played */
+	uint8_t currentShape;									/* The falling shape (0 - 6: S Z L J O I T) */
+	uint8_t nextShapes[TETRIS_ENV_NUM_NEXT];				/* The next shapes, in order */
+	uint8_t holdShape;										/* The shape on hold (TETRIS_ENV_NO_SHAPE if none) */
+	uint8_t gameOver;										/* 1 once the game topped out (until a reset) */
+	int32_t score;											/* The score */
+	int32_t lines;											/* Total lines cleared */
+	int32_t pendingGarbage;									/* Garbage rows queued (versus only) */
+} TetrisEnvObservation;
+
+
+/* FUNCTIONS -------------------------------------------------------------- */
+
+/* Get the version the library was built with (TETRIS_ENV_VERSION.) */
+TETRIS_ENV_API int32_t tetrisEnvGetVersion(void);
+
+/* Create a game.
+ *
+ * - param 1: uint32_t, the seed of the shape order
+ * - return: TetrisEnv pointer, the game (NULL if it could not be allocated) */
+TETRIS_ENV_API TetrisEnv* tetrisEnvCreate(uint32_t seed);
+
+/* Destroy a game (NULL is ignored.) */
+TETRIS_ENV_API void tetrisEnvDestroy(TetrisEnv* env);
+
+/* Start a new game.
+ *
+ * - param 1: TetrisEnv, the game
+ * - param 2: uint32_t, the seed of the shape order
+ * - param 3: TetrisEnvObservation, written with the new game (may be NULL) */
+TETRIS_ENV_API void tetrisEnvReset(TetrisEnv* env, uint32_t seed, TetrisEnvObservation* observation);
+
+/* Write what the agent sees of a game.
+ *
+ * - param 1: TetrisEnv, the game
+ * - param 2: TetrisEnvObservation, written with the game */
+TETRIS_ENV_API void tetrisEnvObserve(const TetrisEnv* env, TetrisEnvObservation* observation);
+
+/* Play a whole shape (hold if asked, rotate, shift, hard drop and lock.)
+ *  - Nothing changes if the placement is not in the mask (or the game is over)
+ *
+ * - param 1: TetrisEnv, the game
+ * - param 2: int32_t, the placement index
+ * - param 3: TetrisEnvObservation, written after the step (may be NULL)
+ * - param 4: float, set to the reward, the score gained (may be NULL)
+ * - param 5: uint8_t, set to 1 if the game is over (may be NULL)
+ * - return: int32_t, 1 if the shape was placed, 0 if the placement could not be played */
+TETRIS_ENV_API int32_t tetrisEnvStepPlacement(TetrisEnv* env, int32_t placement, TetrisEnvObservation* observation,
+                                              float* reward, uint8_t* done);
+
+/* Play one tick (1 / 60 second) of raw actions.
+ *  - Releases are applied before presses, then the game advances by one tick
+ *  - An action stays held from its press to its release (as with a keyboard)
+ *
+ * - param 1: TetrisEnv, the game
+ * - param 2: uint16_t, the actions pressed this tick (TETRIS_ENV_* action bits)
+ * - param 3: uint16_t, the actions released this tick
+ * - param 4: TetrisEnvObservation, written after the step (may be NULL)
+ * - param 5: float, set to the reward, the score gained (may be NULL)
+ * - param 6: uint8_t, set to 1 if the game is over (may be NULL) */
+TETRIS_ENV_API void tetrisEnvStepActions(TetrisEnv* env, uint16_t pressed, uint16_t released,
+                                         TetrisEnvObservation* observation, float* reward, uint8_t* done);
+
+/* Play one placement in each of many games (see tetrisEnvStepPlacement().)
+ *  - Games that are over are not stepped (reset them to play on)
+ *
+ * - param 1: TetrisEnv pointer array, the games
+ * - param 2: int32_t, the number of games
+ * - param 3: int32_t array, the placement index of each game
+ * - param 4: TetrisEnvObservation array, one written per game (may be NULL)
+ * - param 5: float array, the reward of each game (may be NULL)
+ * - param 6: uint8_t array, 1 for each game that is over (may be NULL)
+ * - return: int32_t, the number of games a shape was placed in */
+TETRIS_ENV_API int32_t tetrisEnvStepBatch(TetrisEnv* const* envs, int32_t count, const int32_t* placements,
+                                          TetrisEnvObservation* observations, float* rewards, uint8_t* dones);
+
+/* Copy a game (for search: clone once, then restore into the copy as often as needed.)
+ *
+ * - param 1: TetrisEnv, the game
+ * - return: TetrisEnv pointer, the copy (NULL if it could not be allocated) */
+TETRIS_ENV_API TetrisEnv* tetrisEnvClone(const TetrisEnv* env);
+
+/* Set a game to the state of another (never allocates.)
+ *
+ * - param 1: TetrisEnv, the game to set
+ * - param 2: TetrisEnv, the game to copy */
+TETRIS_ENV_API void tetrisEnvRestore(TetrisEnv* env, const TetrisEnv* source);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TETRISENV_H */
@@ -0,0 +1,1081 @@
+#include "TetrisSimulation.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+
+#include "SuperRotationSystem.h"
+#include "DebugNewOp.h"
+
+
+static_assert(static_cast<int>(TetrisSimulation::Event::COUNT) <= 8, "Events must fit in 8 bits");
+static_assert(std::is_trivially_copyable<TetrisSimulation>::value, "Snapshots copy the simulation by assignment");
+static_assert(TetrisSimulation::GARBAGE_BLOCK < (1 << TetrisSimulation::Board::COLOR_BITS), "Garbage must fit in a packed board content");
+
+
+// Add an int to an FNV-1a hash (one byte at a time, in little endian order, so it is the same on every platform)
+static void hashInt(std::uint32_t& hash, const int value)
+{
+	const auto bits{static_cast<std::uint32_t>(value)};
+
+	for (int i{0}; i < 4; i++)
+	{
+		hash = (hash ^ ((bits >> (i * 8)) & 0xFFu)) * 16777619u;
+	}
+}
+
+// Add a 64 bit value to an FNV-1a hash
+static void hashInt64(std::uint32_t& hash, const std::uint64_t value)
+{
+	hashInt(hash, static_cast<int>(value));
+	hashInt(hash, static_cast<int>(value >> 32));
+}
+
+// Add a time (its exact bits, peers in step compute the same doubles) to an FNV-1a hash
+static void hashSeconds(std::uint32_t& hash, const double seconds)
+{
+	std::uint64_t bits;
+	std::memcpy(&bits, &seconds, sizeof(bits));
+
+	hashInt64(hash, bits);
+}
+
+// Add a shape (its shape, rotation and location) to an FNV-1a hash
+static void hashShape(std::uint32_t& hash, const GridTetromino& shape)
+{
+	hashInt(hash, static_cast<int>(shape.getShape()));
+	hashInt(hash, shape.getRotation());
+	hashInt(hash, shape.getGridLoc().getX());
+	hashInt(hash, shape.getGridLoc().getY());
+}
+
+// Get the blocks a shape covers on the board, as its sorted block indices (8 bits each), so
+// placements can be compared by the blocks they cover
+static std::uint32_t getCoveredBlocks(const GridTetromino& shape)
+{
+	static_assert(TetrisSimulation::Board::TOTAL_ROWS * TetrisSimulation::Board::MAX_X <= 256, "Block indices must fit in 8 bits");
+
+	const auto& blockLocs{shape.getBlockLocs()};
+	const Point gridLoc{shape.getGridLoc()};
+
+	int indices[Tetromino::NUM_BLOCKS];
+
+	for (int i{0}; i < Tetromino::NUM_BLOCKS; i++)
+	{
+		indices[i] = (blockLocs[i].getY() + gridLoc.getY() + TetrisSimulation::Board::HIDDEN_ROWS) * TetrisSimulation::Board::MAX_X
+			+ blockLocs[i].getX() + gridLoc.getX();
+	}
+
+	std::sort(indices, indices + Tetromino::NUM_BLOCKS);
+
+	std::uint32_t blocks{0};
+
+	for (int i{0}; i < Tetromino::NUM_BLOCKS; i++)
+	{
+		blocks |= static_cast<std::uint32_t>(indices[i]) << (i * 8);
+	}
+
+	return blocks;
+}
+
+
+// ========================================================================
+// ============================= Constructor ==============================
+// ========================================================================
+TetrisSimulation::TetrisSimulation(const std::uint32_t seed)
+{
+	reset(seed);		// Reset the game
+}
+
+
+// ========================================================================
+// ============================ Public Methods ============================
+// ========================================================================
+
+void TetrisSimulation::applyActions(const ActionFrame& frame)
+{
+	for (int i{0}; i < static_cast<int>(Action::COUNT); i++)
+	{
+		if (frame.released.has(static_cast<Action>(i)))
+		{
+			onActionReleased(static_cast<Action>(i));
+		}
+	}
+
+	for (int i{0}; i < static_cast<int>(Action::COUNT); i++)
+	{
+		if (frame.pressed.has(static_cast<Action>(i)))
+		{
+			onActionPressed(static_cast<Action>(i));
+		}
+	}
+}
+
+void TetrisSimulation::onActionPressed(const Action action)
+{
+	heldActions.add(action);
+
+	// A topped out game takes no more moves (until reset()), and a shape locked by a hard
+	// drop earlier in the same frame takes none either (the next advance() spawns its successor)
+	if (gameOver || shapePlacedSinceLastGameLoop)
+	{
+		return;
+	}
+
+	switch (action)
+	{
+	case Action::ROTATE_CLOCKWISE:
+	case Action::ROTATE_COUNTERCLOCKWISE:
+	case Action::ROTATE_180:
+		if (attemptRotate(currentShape, (action == Action::ROTATE_CLOCKWISE) ? 1 : (action == Action::ROTATE_180) ? 2 : 3))
+		{
+			onShapeMoved(true);
+			raiseEvent(Event::SHAPE_ROTATED);
+		}
+
+		break;
+
+	case Action::MOVE_LEFT:
+		startAutoShift(-1, true);
+		break;
+
+	case Action::SOFT_DROP:
+		// A blocked soft drop does not lock, the lock delay does
+		if (attemptMove(currentShape, 0, 1))
+		{
+			onShapeMoved(false);
+
+			// Successful soft drop, increase score
+			score += static_cast<int>(scoringActions::softDrop);
+		}
+		break;
+
+	case Action::MOVE_RIGHT:
+		startAutoShift(1, true);
+		break;
+
+	case Action::HARD_DROP:
+		score += getHardDropPoints(drop(currentShape));
+		lock(currentShape);
+		raiseEvent(Event::HARD_DROPPED);
+
+		break;
+
+	case Action::HOLD:
+		setHoldShape();
+		break;
+
+
+	default:
+		assert(false && "Unknown action");
+		break;
+	}
+
+	updateGhostShape();
+}
+
+void TetrisSimulation::onActionReleased(const Action action)
+{
+	heldActions.remove(action);
+
+	switch (action)
+	{
+	case Action::MOVE_LEFT:
+		if (shiftDirection == -1)
+		{
+			startAutoShift(heldActions.has(Action::MOVE_RIGHT) ? 1 : 0, false);
+		}
+		break;
+
+	case Action::MOVE_RIGHT:
+		if (shiftDirection == 1)
+		{
+			startAutoShift(heldActions.has(Action::MOVE_LEFT) ? -1 : 0, false);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+void TetrisSimulation::setHandling(const Handling& handling)
+{
+	this->handling = handling;
+}
+
+void TetrisSimulation::setGravityCurve(const GravityCurve::Curve curve)
+{
+	gravityCurve = curve;
+}
+
+void TetrisSimulation::step()
+{
+	advanceBy(1.0 / TICKS_PER_SECOND, GravityCurve::FIXED_ONE);
+}
+
+void TetrisSimulation::advance(const float secondsSinceLastLoop)
+{
+	advanceBy(secondsSinceLastLoop, static_cast<std::int64_t>(static_cast<double>(secondsSinceLastLoop)
+	                                 * GravityCurve::FRAMES_PER_SECOND * GravityCurve::FIXED_ONE));
+}
+
+void TetrisSimulation::reset(const std::uint32_t seed)
+{
+	// Reset Score, Level, and lines (rows cleared)
+	score = 0;
+	level = 1;
+	totalRowsCleared = 0;
+
+	// Clear gameboard
+	board.empty();
+	lockedAboveBoard = false;
+	shapePlacedSinceLastGameLoop = false;
+	lastLock = LockDelta{};
+
+	// Clear garbage, and the state of the last game
+	incomingGarbage.clear();
+	outgoingGarbage = 0;
+	gameOver = false;
+	events = 0;
+
+	// Set hold shape to false
+	holdShapeSet = false;
+	holdShapeSetThisRound = false;
+
+	// Pick & spawn next shape
+	shapeBag.reset(seed);
+	setStartingShapes();
+	spawnNextShape();
+	pickNextShape();
+}
+
+void TetrisSimulation::queueGarbage(const int rows, const int holeColumn)
+{
+	incomingGarbage.push(rows, holeColumn);
+}
+
+int TetrisSimulation::takeOutgoingGarbage()
+{
+	const int rows{outgoingGarbage};
+	outgoingGarbage = 0;
+
+	return rows;
+}
+
+int TetrisSimulation::getPendingGarbage() const
+{
+	return incomingGarbage.getPendingRows();
+}
+
+bool TetrisSimulation::takeEvent(const Event event)
+{
+	const auto bit{static_cast<std::uint8_t>(1u << static_cast<int>(event))};
+	const bool happened{(events & bit) != 0};
+
+	events &= static_cast<std::uint8_t>(~bit);
+
+	return happened;
+}
+
+bool TetrisSimulation::isGameOver() const
+{
+	return gameOver;
+}
+
+const TetrisSimulation::Board& TetrisSimulation::getBoard() const
+{
+	return board;
+}
+
+const TetrisSimulation::LockDelta& TetrisSimulation::getLastLock() const
+{
+	return lastLock;
+}
+
+int TetrisSimulation::getScore() const
+{
+	return score;
+}
+
+int TetrisSimulation::getLines() const
+{
+	return totalRowsCleared;
+}
+
+Tetromino::TetShape TetrisSimulation::getCurrentShape() const
+{
+	return currentShape.getShape();
+}
+
+Tetromino::TetShape TetrisSimulation::getNextShape(const int index) const
+{
+	assert((index >= 0) && (index < NUM_NEXT_SHAPES));
+
+	return nextShapes[index].getShape();
+}
+
+bool TetrisSimulation::getHoldShape(Tetromino::TetShape& shape) const
+{
+	shape = holdShape.getShape();
+
+	return holdShapeSet;
+}
+
+Tetromino::TetShape TetrisSimulation::getShapeAfterHold() const
+{
+	return getShapeAfterHold(holdShapeSet, holdShape.getShape(), nextShapes[0].getShape());
+}
+
+Tetromino::TetShape TetrisSimulation::getShapeAfterHold(const bool holdShapeSet, const Tetromino::TetShape holdShape,
+                                                        const Tetromino::TetShape nextShape)
+{
+	return holdShapeSet ? holdShape : nextShape;
+}
+
+int TetrisSimulation::getHardDropPoints(const int rowsDropped)
+{
+	return rowsDropped * static_cast<int>(scoringActions::hardDrop);
+}
+
+int TetrisSimulation::getRowClearPoints(const int rowsCleared, const int level)
+{
+	switch (rowsCleared)
+	{
+	case (4):
+		return static_cast<int>(scoringActions::Tetris) * level;
+
+	case (3):
+		return static_cast<int>(scoringActions::tripleRowClear) * level;
+
+	case (2):
+		return static_cast<int>(scoringActions::doubleRowClear) * level;
+
+	case (1):
+		return static_cast<int>(scoringActions::singleRowClear) * level;
+
+	default:
+		return 0;
+	}
+}
+
+int TetrisSimulation::getLevelForLines(const int lines)
+{
+	return std::min(lines / 10 + 1, numLevels);
+}
+
+bool TetrisSimulation::isHoldAvailable() const
+{
+	return !holdShapeSetThisRound;
+}
+
+const ShapeBag& TetrisSimulation::getShapeBag() const
+{
+	return shapeBag;
+}
+
+int TetrisSimulation::getPlacements(Placement placements[MAX_PLACEMENTS]) const
+{
+	if (gameOver)
+	{
+		return 0;
+	}
+
+	int count{0};
+	std::uint32_t coveredBlocks[MAX_PLACEMENTS];	// The blocks each placement covers (see getCoveredBlocks())
+
+	for (int hold{0}; hold < (holdShapeSetThisRound ? 1 : 2); hold++)
+	{
+		const int firstOfShape{count};	// Only the placements of the same shape can cover the same blocks
+
+		for (int rotation{0}; rotation < Tetromino::NUM_ROTATIONS; rotation++)
+		{
+			GridTetromino spawned;
+
+			if (!movePlacedShape(spawned, Placement{hold == 1, static_cast<std::int8_t>(rotation),
+			                                        static_cast<std::int8_t>(board.getSpawnLoc().getX()), 0}))
+			{
+				continue;
+			}
+
+			for (const int direction : {-1, 1})
+			{
+				GridTetromino shifted{spawned};
+
+				// The spawn column is listed with the left shifts
+				bool canMove{(direction < 0) || attemptMove(shifted, direction, 0)};
+
+				while (canMove)
+				{
+					GridTetromino landed{shifted};
+					drop(landed);
+
+					const std::uint32_t blocks{getCoveredBlocks(landed)};
+
+					if (std::find(coveredBlocks + firstOfShape, coveredBlocks + count, blocks) == coveredBlocks + count)
+					{
+						coveredBlocks[count] = blocks;
+						placements[count++] = Placement{hold == 1, static_cast<std::int8_t>(rotation),
+						                                static_cast<std::int8_t>(landed.getGridLoc().getX()),
+						                                static_cast<std::int8_t>(landed.getGridLoc().getY())};
+					}
+
+					canMove = attemptMove(shifted, direction, 0);
+				}
+			}
+		}
+	}
+
+	return count;
+}
+
+bool TetrisSimulation::place(const Placement& placement)
+{
+	GridTetromino shape;
+
+	// A shape locked by a hard drop action is handled by the next advance() first
+	if (gameOver || shapePlacedSinceLastGameLoop || !movePlacedShape(shape, placement))
+	{
+		return false;
+	}
+
+	// The shape hold brings in was checked by movePlacedShape() (in the placement's rotation)
+	if (placement.useHold)
+	{
+		swapHoldShape();
+	}
+
+	currentShape = shape;
+
+	score += getHardDropPoints(drop(currentShape));
+	lock(currentShape);
+	raiseEvent(Event::HARD_DROPPED);
+
+	onShapeLocked();
+
+	shapePlacedSinceLastGameLoop = false;
+	updateLevel();
+
+	return true;
+}
+
+std::uint32_t TetrisSimulation::getStateHash() const
+{
+	std::uint32_t hash{2166136261u};
+
+	for (int y{-Board::HIDDEN_ROWS}; y < Board::MAX_Y; y++)
+	{
+		for (int x{0}; x < Board::MAX_X; x++)
+		{
+			hashInt(hash, board.getContent(x, y));
+		}
+	}
+
+	hashShape(hash, currentShape);
+	hashShape(hash, holdShape);
+	hashInt(hash, holdShapeSet);
+	hashInt(hash, holdShapeSetThisRound);
+
+	for (const GridTetromino& nextShape : nextShapes)
+	{
+		hashShape(hash, nextShape);
+	}
+
+	// The shapes still to be dealt
+	Tetromino::TetShape shapesLeft[ShapeBag::BAG_SIZE];
+	const int numShapesLeft{shapeBag.getShapesLeft(shapesLeft)};
+
+	hashInt(hash, static_cast<int>(shapeBag.getRandomState()));
+	hashInt(hash, numShapesLeft);
+
+	for (int i{0}; i < numShapesLeft; i++)
+	{
+		hashInt(hash, static_cast<int>(shapesLeft[i]));
+	}
+
+	hashInt(hash, score);
+	hashInt(hash, level);
+	hashInt(hash, totalRowsCleared);
+
+	// Handling, gravity and lock delay, which decide where the falling shape goes next
+	hashInt(hash, heldActions.getBits());
+	hashInt(hash, shiftDirection);
+	hashSeconds(hash, secondsShiftHeld);
+	hashInt(hash, autoShiftsDone);
+	hashInt64(hash, static_cast<std::uint64_t>(gravityFrames));
+	hashInt(hash, shapeGrounded);
+	hashSeconds(hash, secondsGrounded);
+	hashInt(hash, lockResetsDone);
+	hashInt(hash, lowestShapeRow);
+
+	hashInt(hash, incomingGarbage.getPendingRows());
+	hashInt(hash, outgoingGarbage);
+	hashInt(hash, gameOver);
+
+	return hash;
+}
+
+void TetrisSimulation::writeSnapshot(Snapshot& snapshot) const
+{
+	// Gameboard (visible rows only)
+	for (int y{0}; y < Board::MAX_Y; y++)
+	{
+		for (int x{0}; x < Board::MAX_X; x++)
+		{
+			snapshot.board[y][x] = static_cast<std::int8_t>(board.getContent(x, y));
+		}
+	}
+
+	// Shapes
+	auto writeShape = [](Snapshot::Shape& shapeSnapshot, const GridTetromino& shape, const bool mapToGrid)
+	{
+		const auto& blockLocs{shape.getBlockLocs()};
+		const Point gridLoc{mapToGrid ? shape.getGridLoc() : Point{0, 0}};
+
+		shapeSnapshot.visible = true;
+		shapeSnapshot.color = shape.getColor();
+		shapeSnapshot.xViewBlockOffset = shape.getXViewBlockOffset();
+		shapeSnapshot.yViewBlockOffset = shape.getYViewBlockOffset();
+
+		for (int i{0}; i < Tetromino::NUM_BLOCKS; i++)
+		{
+			shapeSnapshot.blockX[i] = static_cast<std::int8_t>(blockLocs[i].getX() + gridLoc.getX());
+			shapeSnapshot.blockY[i] = static_cast<std::int8_t>(blockLocs[i].getY() + gridLoc.getY());
+		}
+	};
+
+	writeShape(snapshot.currentShape, currentShape, true);
+	writeShape(snapshot.ghostShape, ghostShape, true);
+	writeShape(snapshot.holdShape, holdShape, false);
+	snapshot.holdShape.visible = holdShapeSet;
+
+	for (int i = 0; i < NUM_NEXT_SHAPES; i++)
+	{
+		writeShape(snapshot.nextShapes[i], nextShapes[i], false);
+	}
+
+	// HUD
+	snapshot.score = score;
+	snapshot.level = level;
+	snapshot.lines = totalRowsCleared;
+}
+
+
+// ========================================================================
+// =============================== Methods ================================
+// ========================================================================
+
+// ==============================================================
+// ===================== Game loop methods ======================
+// ==============================================================
+
+void TetrisSimulation::advanceBy(const double seconds, const std::int64_t frames)
+{
+	if (gameOver)
+	{
+		return;
+	}
+
+	updateAutoShift(seconds);
+
+	// Turn the elapsed frames into whole rows of gravity, keeping the remainder
+	gravityFrames += frames;
+
+	const std::int32_t framesPerRow{getFramesPerRow()};
+	const std::int64_t rowsOwed{gravityFrames / framesPerRow};
+	gravityFrames -= rowsOwed * framesPerRow;
+
+	if (GravityCurve::isInstant(gravityCurve, level))
+	{
+		applyGravity(Board::MAX_Y + Board::HIDDEN_ROWS);
+	}
+	else if (rowsOwed > 0)
+	{
+		applyGravity(static_cast<int>(std::min<std::int64_t>(rowsOwed, Board::MAX_Y + Board::HIDDEN_ROWS)));
+	}
+
+	updateLockDelay(seconds);
+
+	if (shapePlacedSinceLastGameLoop)
+	{
+		onShapeLocked();
+
+		shapePlacedSinceLastGameLoop = false;
+		updateLevel();
+	}
+}
+
+void TetrisSimulation::onShapeLocked()
+{
+	holdShapeSetThisRound = false;
+
+	const std::array<Point, Tetromino::NUM_BLOCKS> lockedShapeLocs{lockedShape.getBlockLocsMappedToGrid()};
+
+	lastLock.sequence++;
+	lastLock.color = lockedShape.getColor();
+	lastLock.garbageRows = 0;
+
+	for (int i{0}; i < Tetromino::NUM_BLOCKS; i++)
+	{
+		lastLock.blockX[i] = static_cast<std::int8_t>(lockedShapeLocs[i].getX());
+		lastLock.blockY[i] = static_cast<std::int8_t>(lockedShapeLocs[i].getY());
+	}
+
+	// Clear rows before spawning, so a clear can make room for the next shape
+	const int rowsCleared = board.removeCompletedRows(lockedShapeLocs.data(), Tetromino::NUM_BLOCKS, lastLock.clearedRows);
+
+	// Lock out if the shape locked entirely in the hidden rows
+	bool toppedOut{lockedAboveBoard};
+
+	if (rowsCleared > 0)
+	{
+		// Clearing rows cancels the incoming garbage first, the rest is sent
+		outgoingGarbage += incomingGarbage.cancel(GARBAGE_FOR_ROWS_CLEARED[std::min(rowsCleared, 4)]);
+	}
+	else
+	{
+		// Garbage that pushes blocks off the board also tops out
+		GarbageQueue::Batch batch;
+
+		while (incomingGarbage.pop(batch))
+		{
+			toppedOut = !board.insertGarbageRows(batch.rows, batch.holeColumn, GARBAGE_BLOCK) || toppedOut;
+
+			for (int i{0}; i < batch.rows; i++, lastLock.garbageRows++)
+			{
+				if (lastLock.garbageRows < Board::TOTAL_ROWS)
+				{
+					lastLock.garbageHoles[lastLock.garbageRows] = static_cast<std::int8_t>(batch.holeColumn);
+				}
+			}
+		}
+	}
+
+	// Block out if the next shape can not spawn
+	if (!toppedOut && spawnNextShape())
+	{
+		pickNextShape();
+		raiseEvent(Event::SHAPE_LOCKED);
+
+		totalRowsCleared += rowsCleared;
+		score += getRowClearPoints(rowsCleared, level);
+	}
+	else
+	{
+		gameOver = true;
+		raiseEvent(Event::GAME_OVER);
+	}
+
+	lastLock.score = score;
+	lastLock.lines = totalRowsCleared;
+}
+
+void TetrisSimulation::applyGravity(const int rows)
+{
+	if (shapeGrounded || shapePlacedSinceLastGameLoop)
+	{
+		return;
+	}
+
+	const int rowsMoved{std::min(rows, getDropDistance(currentShape))};
+
+	if (rowsMoved > 0)
+	{
+		currentShape.move(0, rowsMoved);
+		onShapeMoved(false);
+
+		if (heldActions.has(Action::SOFT_DROP))
+		{
+			score += rowsMoved * static_cast<int>(scoringActions::softDrop);
+		}
+	}
+}
+
+void TetrisSimulation::resetShapeTimers()
+{
+	gravityFrames = 0;
+
+	shapeGrounded = isGrounded(currentShape);
+	secondsGrounded = 0.0;
+	lockResetsDone = 0;
+	lowestShapeRow = currentShape.getGridLoc().getY();
+}
+
+void TetrisSimulation::onShapeMoved(const bool byPlayer)
+{
+	const bool wasGrounded{shapeGrounded};
+	shapeGrounded = isGrounded(currentShape);
+
+	if (currentShape.getGridLoc().getY() > lowestShapeRow)
+	{
+		lowestShapeRow = currentShape.getGridLoc().getY();
+		lockResetsDone = 0;
+		secondsGrounded = 0.0;
+	}
+	else if (byPlayer && (wasGrounded || shapeGrounded) && (lockResetsDone < handling.maxLockResets))
+	{
+		lockResetsDone++;
+		secondsGrounded = 0.0;
+	}
+}
+
+void TetrisSimulation::updateLockDelay(const double seconds)
+{
+	if (!shapeGrounded || shapePlacedSinceLastGameLoop)
+	{
+		return;
+	}
+
+	secondsGrounded += seconds;
+
+	if (secondsGrounded >= handling.lockDelayMs / 1000.0)
+	{
+		lock(currentShape);
+	}
+}
+
+std::int32_t TetrisSimulation::getFramesPerRow() const
+{
+	const std::int32_t framesPerRow{GravityCurve::getFramesPerRow(gravityCurve, level)};
+
+	if (heldActions.has(Action::SOFT_DROP) && (handling.softDropFactor > 1))
+	{
+		return std::max<std::int32_t>(framesPerRow / handling.softDropFactor, 1);
+	}
+
+	return framesPerRow;
+}
+
+void TetrisSimulation::startAutoShift(const int direction, const bool moveNow)
+{
+	shiftDirection = direction;
+	secondsShiftHeld = 0.0;
+	autoShiftsDone = 0;
+
+	if (moveNow && attemptMove(currentShape, direction, 0))
+	{
+		onShapeMoved(true);
+	}
+}
+
+void TetrisSimulation::updateAutoShift(const double seconds)
+{
+	if (shiftDirection == 0)
+	{
+		return;
+	}
+
+	secondsShiftHeld += seconds;
+
+	const double secondsPastDelay{secondsShiftHeld - handling.delayedAutoShiftMs / 1000.0};
+
+	// DAS not charged yet
+	if (secondsPastDelay < 0)
+	{
+		return;
+	}
+
+	bool moved{false};
+
+	if (handling.autoRepeatRateMs <= 0)
+	{
+		// ARR of 0 - move straight to the wall
+		while (attemptMove(currentShape, shiftDirection, 0))
+		{
+			moved = true;
+		}
+
+		if (moved)
+		{
+			onShapeMoved(true);
+		}
+	}
+	else
+	{
+		// One move when DAS charges, then one move every ARR
+		const int shiftsDue{static_cast<int>(secondsPastDelay * 1000.0 / handling.autoRepeatRateMs) + 1};
+
+		for (; autoShiftsDone < shiftsDue; autoShiftsDone++)
+		{
+			if (attemptMove(currentShape, shiftDirection, 0))
+			{
+				onShapeMoved(true);
+				moved = true;
+			}
+		}
+	}
+
+	if (moved)
+	{
+		updateGhostShape();
+	}
+}
+
+void TetrisSimulation::updateLevel()
+{
+	const int newLevel{getLevelForLines(totalRowsCleared)};
+
+	if (level != newLevel)
+	{
+		level = newLevel;
+		raiseEvent(Event::LEVEL_UP);
+	}
+}
+
+void TetrisSimulation::raiseEvent(const Event event)
+{
+	events |= static_cast<std::uint8_t>(1u << static_cast<int>(event));
+}
+
+
+// ==============================================================
+// ========================= Set Shapes =========================
+// ==============================================================
+
+void TetrisSimulation::setStartingShapes()
+{
+	for (GridTetromino& nextShape : nextShapes)
+	{
+		nextShape.setShape(shapeBag.next());
+	}
+}
+
+bool TetrisSimulation::spawnNextShape()
+{
+	currentShape.setShape(nextShapes[0].getShape());
+	currentShape.setGridLoc(board.getSpawnLoc().getX(), board.getSpawnLoc().getY());
+	updateGhostShape();
+	resetShapeTimers();
+
+	return isPositionLegal(currentShape);
+}
+
+void TetrisSimulation::pickNextShape()
+{
+	// Move the shapes up
+	std::copy(nextShapes + 1, nextShapes + NUM_NEXT_SHAPES, nextShapes);
+
+	// Add a shape to the end
+	nextShapes[NUM_NEXT_SHAPES - 1].setShape(shapeBag.next());
+}
+
+bool TetrisSimulation::setHoldShape()
+{
+	GridTetromino incomingShape{currentShape};
+	incomingShape.setShape(getShapeAfterHold());
+	incomingShape.setGridLoc(board.getSpawnLoc().getX(), board.getSpawnLoc().getY());
+
+	// Hold shape has not yet been set this round, and the shape it brings in fits at spawn
+	if (!holdShapeSetThisRound && isPositionLegal(incomingShape))
+	{
+		swapHoldShape();
+
+		return true;
+	}
+
+	return false;
+}
+
+void TetrisSimulation::swapHoldShape()
+{
+	// If Hold shape has been set before
+	if (holdShapeSet)
+	{
+		GridTetromino temp = holdShape;
+
+		holdShape.setShape(currentShape.getShape());
+		currentShape.setShape(temp.getShape());
+		currentShape.setGridLoc(board.getSpawnLoc().getX(), board.getSpawnLoc().getY());
+		resetShapeTimers();
+	}
+	// If Hold shape has never been set before
+	else
+	{
+		holdShapeSet = true;
+
+		holdShape.setShape(currentShape.getShape());
+		spawnNextShape();
+		pickNextShape();
+	}
+
+	holdShapeSetThisRound = true;
+}
+
+
+// ==============================================================
+// ========================== Movement ==========================
+// ==============================================================
+
+bool TetrisSimulation::attemptRotate(GridTetromino& shape, const int quarterTurns) const
+{
+	const int turns{((quarterTurns % Tetromino::NUM_ROTATIONS) + Tetromino::NUM_ROTATIONS) % Tetromino::NUM_ROTATIONS};
+
+	if (turns == 0)
+	{
+		return true;
+	}
+
+	const SuperRotationSystem::Kicks kicks{SuperRotationSystem::getKicks(shape.getShape(), shape.getRotation(), turns)};
+
+	GridTetromino tempTetromino{shape};
+	tempTetromino.rotate(turns);
+
+	const Point rotatedLoc{tempTetromino.getGridLoc()};
+
+	for (int i{0}; i < kicks.count; i++)
+	{
+		tempTetromino.setGridLoc(rotatedLoc.getX() + kicks.offsets[i].x, rotatedLoc.getY() + kicks.offsets[i].y);
+
+		if (isPositionLegal(tempTetromino))
+		{
+			shape = tempTetromino;
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool TetrisSimulation::attemptMove(GridTetromino& shape, const int x, const int y) const
+{
+	GridTetromino tempTetromino{shape};
+	tempTetromino.move(x, y);
+
+	if (isPositionLegal(tempTetromino))
+	{
+		shape.move(x, y);
+
+		return true;
+	}
+
+	return false;
+}
+
+bool TetrisSimulation::movePlacedShape(GridTetromino& shape, const Placement& placement) const
+{
+	if ((placement.useHold && holdShapeSetThisRound)
+		|| (placement.rotation < 0) || (placement.rotation >= Tetromino::NUM_ROTATIONS))
+	{
+		return false;
+	}
+
+	shape.setShape(placement.useHold ? getShapeAfterHold() : currentShape.getShape());
+	shape.setRotation(placement.rotation);
+	shape.setGridLoc(board.getSpawnLoc());
+
+	if (!isPositionLegal(shape))
+	{
+		return false;
+	}
+
+	const int direction{(placement.x < shape.getGridLoc().getX()) ? -1 : 1};
+
+	while (shape.getGridLoc().getX() != placement.x)
+	{
+		if (!attemptMove(shape, direction, 0))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int TetrisSimulation::getDropDistance(const GridTetromino& shape) const
+{
+	const auto& blockLocs{shape.getBlockLocs()};
+	const Point gridLoc{shape.getGridLoc()};
+
+	int rowsDropped{Board::MAX_Y + Board::HIDDEN_ROWS};
+
+	for (int i{0}; i < static_cast<int>(blockLocs.size()); i++)
+	{
+		rowsDropped = std::min(rowsDropped, board.getDropDistance(blockLocs[i].getX() + gridLoc.getX(),
+		                                                          blockLocs[i].getY() + gridLoc.getY()));
+	}
+
+	return rowsDropped;
+}
+
+int TetrisSimulation::drop(GridTetromino& shape) const
+{
+	const int rowsDropped{getDropDistance(shape)};
+
+	shape.move(0, rowsDropped);
+
+	return rowsDropped;
+}
+
+void TetrisSimulation::lock(const GridTetromino& shape)
+{
+	const std::array<Point, Tetromino::NUM_BLOCKS> lockedShapeLocs{shape.getBlockLocsMappedToGrid()};
+
+	board.setContent(lockedShapeLocs.data(), Tetromino::NUM_BLOCKS, static_cast<int>(shape.getColor()));
+	lockedShape = shape;
+
+	lockedAboveBoard = std::all_of(lockedShapeLocs.begin(), lockedShapeLocs.end(),
+	                               [](const Point& loc) { return Board::isHiddenRow(loc.getY()); });
+
+	shapePlacedSinceLastGameLoop = true;
+}
+
+void TetrisSimulation::updateGhostShape()
+{
+	ghostShape = currentShape;
+	drop(ghostShape);
+}
+
+bool TetrisSimulation::isGrounded(const GridTetromino& shape) const
+{
+	return getDropDistance(shape) == 0;
+}
+
+
+// ==============================================================
+// ================== State & gameplay/ logic ===================
+// ==============================================================
+
+bool TetrisSimulation::isPositionLegal(const GridTetromino& shape) const
+{
+	if (!isWithinBorders(shape))
+	{
+		return false;
+	}
+
+	// Every block is on the board, so test the content directly (no mapped vector needed)
+	const auto& blockLocs{shape.getBlockLocs()};
+	const Point gridLoc{shape.getGridLoc()};
+
+	for (int i{0}; i < static_cast<int>(blockLocs.size()); i++)
+	{
+		if (board.getContent(blockLocs[i].getX() + gridLoc.getX(), blockLocs[i].getY() + gridLoc.getY())
+			!= Board::EMPTY_BLOCK)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool TetrisSimulation::isWithinBorders(const GridTetromino& shape) const
+{
+	const auto& blockLocs{shape.getBlockLocs()};
+	const Point gridLoc{shape.getGridLoc()};
+
+	for (int i{ 0 }; i < static_cast<int>(blockLocs.size()); i++)
+	{
+		const int x{blockLocs[i].getX() + gridLoc.getX()};
+		const int y{blockLocs[i].getY() + gridLoc.getY()};
+
+		if ((x < 0) || (x >= Board::MAX_X) || (y < -Board::HIDDEN_ROWS) || (y >= Board::MAX_Y))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
@@ -0,0 +1,629 @@
+// This class encapsulates the Tetris gameplay & control logic, without graphics or audio.
+//  - Headless: it only depends on the game's own classes (no SFML), so many can run in
+//     one process (versus, bots, servers)
+//  - Deterministic: the shapes come from a seeded ShapeBag, and step() advances by a fixed
+//     tick, so the same seed and actions on the same ticks always play the same game
+//  - Sounds and game over are reported as Events for the front end (see TetrisGame)
+//  - Drawing is done by the GameRenderer, from Snapshots of the game (see writeSnapshot())
+//  - Trivially copyable (no pointers or heap members), so a copy of the whole game is a
+//     snapshot that can be restored by assignment (rollback, search)
+
+#ifndef TETRISSIMULATION_H
+#define TETRISSIMULATION_H
+
+#include <cstdint>
+#include "Actions.h"
+#include "Gameboard.h"
+#include "GarbageQueue.h"
+#include "GravityCurve.h"
+#include "GridTetromino.h"
+#include "ShapeBag.h"
+
+
+class TetrisSimulation
+{
+public:
+	// TYPES ------------------------------------------------------------------
+	using Board = Gameboard<10, 19>;	// The v2.0 board (sized to match background_v2.0.png)
+
+	// Handling settings for held actions (all handled in advance(), not by OS key repeat)
+	struct Handling
+	{
+		int delayedAutoShiftMs{167};	// DAS - time a move must be held before the shape auto-repeats
+		int autoRepeatRateMs{33};		// ARR - time between auto-repeated moves (0 moves straight to the wall)
+		int softDropFactor{20};			// Gravity multiplier while soft drop is held
+		int lockDelayMs{500};			// Time a shape may rest on the stack before it locks
+		int maxLockResets{15};			// Moves/ rotations that may restart the lock delay (per lowest row reached)
+	};
+
+	// Things that happened in the game, for the front end (sounds) to react to (see takeEvent())
+	enum class Event : std::uint8_t
+	{
+		SHAPE_ROTATED,	// The current shape was rotated
+		HARD_DROPPED,	// The current shape was hard dropped
+		SHAPE_LOCKED,	// A shape was locked, and the next one spawned
+		LEVEL_UP,		// The level went up
+		GAME_OVER,		// The game topped out (see isGameOver())
+		COUNT
+	};
+
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int NUM_NEXT_SHAPES{ 3 };		// Number of next shapes
+	static constexpr int numLevels{ GravityCurve::NUM_LEVELS };	// Number of levels
+
+	static constexpr int TICKS_PER_SECOND{GravityCurve::FRAMES_PER_SECOND};	// Fixed ticks (see step())
+	static constexpr int GARBAGE_BLOCK{static_cast<int>(Tetromino::TetColor::COUNT)};	// Content of a garbage block
+
+	// Rows of garbage sent for clearing 0 - 4 rows at once (before cancelling)
+	static constexpr int GARBAGE_FOR_ROWS_CLEARED[]{0, 0, 1, 2, 4};
+
+	// What one locked shape changed, taken from the lock and row removal (see getLastLock())
+	//  - Applying every lock in order to a board rebuilds it (place the blocks, remove
+	//     the cleared rows, add the garbage rows), so spectators need one per shape
+	struct LockDelta
+	{
+		std::uint32_t sequence;					// Shapes locked this game (0 before the first lock)
+		Tetromino::TetColor color;				// Color of the locked blocks
+		std::int8_t blockX[Tetromino::NUM_BLOCKS];	// Locked block x (cols)
+		std::int8_t blockY[Tetromino::NUM_BLOCKS];	// Locked block y (rows, negative in the hidden rows)
+		Board::ColumnMask clearedRows;			// Rows removed after the lock (bit y + HIDDEN_ROWS)
+		int garbageRows;						// Rows of garbage added after the lock (0 if rows were cleared)
+		std::int8_t garbageHoles[Board::TOTAL_ROWS];	// Hole column of each garbage row, in the order added (the first TOTAL_ROWS)
+		int score;								// The score after the lock
+		int lines;								// Total lines cleared after the lock
+	};
+
+	// A hard drop placement of a shape, from its spawn location (see getPlacements())
+	//  - The shape is rotated at the spawn location (without kicks), shifted to x and hard
+	//     dropped, so bots can play a whole shape in one call to place()
+	struct Placement
+	{
+		bool useHold;			// True to hold first, and place the shape that comes out of hold
+		std::int8_t rotation;	// Rotation state (0 - 3)
+		std::int8_t x;			// gridLoc x (cols)
+		std::int8_t y;			// gridLoc y (rows) the shape lands at (not read by place())
+	};
+
+	// Most placements of one shape (either shape, every rotation and column)
+	static constexpr int MAX_PLACEMENTS{2 * Tetromino::NUM_ROTATIONS * Board::MAX_X};
+
+	// An immutable copy of everything needed to draw the game (see writeSnapshot())
+	//  - Fixed size and trivially copyable, so the game loop can publish one to the
+	//     render thread every loop without allocating
+	struct Snapshot
+	{
+		// A shape to draw
+		struct Shape
+		{
+			bool visible;				// False if there is no shape (such as an empty hold)
+			Tetromino::TetColor color;	// Color of the blocks
+			float xViewBlockOffset;		// Blocks from the left of the shape to its center (for centering previews)
+			float yViewBlockOffset;		// Blocks from the top of the shape to its center (for centering previews)
+			std::int8_t blockX[Tetromino::NUM_BLOCKS];	// Block x (cols), mapped to the grid for the current/ ghost shape
+			std::int8_t blockY[Tetromino::NUM_BLOCKS];	// Block y (rows), mapped to the grid for the current/ ghost shape
+		};
+
+		std::int8_t board[Board::MAX_Y][Board::MAX_X];	// Visible gameboard contents (EMPTY_BLOCK or a TetColor)
+
+		Shape currentShape;					// The falling shape
+		Shape ghostShape;					// Where the falling shape would land
+		Shape holdShape;					// The shape on hold (relative block locs)
+		Shape nextShapes[NUM_NEXT_SHAPES];	// The next shapes, in order (relative block locs)
+
+		int score;	// The current game score
+		int level;	// The current level
+		int lines;	// Total lines cleared
+	};
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+
+	// Gameboard --------------------------------------------------
+	Board board;		// The gameboard (grid) to represent where all the blocks are
+
+
+	// Current, ghost, hold and next shape(s) ---------------------
+	GridTetromino currentShape; // The tetromino that is currently falling
+	GridTetromino ghostShape;	// A ghost for the tetromino that is currently falling
+
+	GridTetromino nextShapes[NUM_NEXT_SHAPES];	// The next shapes, in order ([0] spawns next)
+
+	ShapeBag shapeBag;			// Deals the shapes added to the end of nextShapes
+
+	GridTetromino holdShape;	// The Tetromino that is on hold
+	bool holdShapeSet{false};			// True if holdShape has been set this game
+	bool holdShapeSetThisRound{false};	// True if holdShape has been set this round
+
+	GridTetromino lockedShape;			// The last locked Tetromino (its rows are checked for completion)
+	LockDelta lastLock{};				// What the last locked Tetromino changed (for spectators)
+	bool lockedAboveBoard{false};		// True if the last locked Tetromino is entirely in the hidden rows (lock out)
+
+
+	// Score ------------------------------------------------------
+	int score;				 // The current game score
+	int level;				 // The current level (1 - numLevels)
+	GravityCurve::Curve gravityCurve{GravityCurve::Curve::NES};	// Gravity (seconds per tick) of each level
+
+	// Scoring points for actions
+	enum class scoringActions
+	{
+		singleRowClear = 100,
+		doubleRowClear = 300,
+		tripleRowClear = 500,
+		Tetris = 800,
+
+		softDrop = 1,
+		hardDrop = 2
+	};
+
+	int totalRowsCleared{0}; // Total lines cleared
+
+
+	// Handling members -------------------------------------------
+	Handling handling;				// DAS, ARR and soft drop settings
+	ActionSet heldActions;			// Actions that are held down
+	int shiftDirection{0};			// Direction being auto-shifted (-1 left, 1 right, 0 none)
+	double secondsShiftHeld{0.0};	// Time shiftDirection has been held for
+	int autoShiftsDone{0};			// Auto-repeated moves already made for shiftDirection
+
+
+	// Time members -----------------------------------------------
+	// Note: gravity is counted in fixed point frames (GravityCurve::FIXED_ONE per 1/60 second),
+	//        so the rows owed do not depend on how often advance() is called.
+	std::int64_t gravityFrames{0};				// Fixed point frames not yet turned into rows of gravity
+	bool shapePlacedSinceLastGameLoop{ false }; // Tracks if a shape has been placed (locked) in the current game loop
+
+
+	// Lock delay members -----------------------------------------
+	bool shapeGrounded{false};		// True while currentShape can not move down (the lock delay is running)
+	double secondsGrounded{0.0};	// Lock delay time used (only advances while shapeGrounded)
+	int lockResetsDone{0};			// Moves/ rotations that have restarted the lock delay
+	int lowestShapeRow{0};			// Lowest gridLoc row currentShape has reached (a new one refills the resets)
+
+
+	// Versus members ---------------------------------------------
+	GarbageQueue incomingGarbage;	// Garbage received, added to the board when a shape locks without clearing rows
+	int outgoingGarbage{0};			// Rows of attack left after cancelling, not taken yet (see takeOutgoingGarbage())
+
+
+	// State members ----------------------------------------------
+	bool gameOver{false};		// True once the game topped out (it stops until reset())
+	std::uint8_t events{0};		// Bit n is set if Event n happened and was not taken yet
+
+
+public:
+	// ========================================================================
+	// ============================= Constructor ==============================
+	// ========================================================================
+
+	// Constructor
+	//  - reset() the game
+	//
+	// - param 1: uint32_t, the seed for the shape order
+	explicit TetrisSimulation(std::uint32_t seed);
+
+
+	// ========================================================================
+	// ============================ Public Methods ============================
+	// ========================================================================
+
+	// Apply the actions that were released and pressed in one tick.
+	//  - Releases are applied first, then presses (in Action order)
+	//
+	// - param 1: ActionFrame, the released and pressed actions
+	void applyActions(const ActionFrame& frame);
+
+	// Action processing for pressed actions
+	//  - update ghost shape
+	//
+	// Provides controls for the game
+	//  - ROTATE_CLOCKWISE        - Attempt to rotate clockwise (SRS, with kicks)
+	//  - ROTATE_COUNTERCLOCKWISE - Attempt to rotate counter-clockwise (SRS, with kicks)
+	//  - ROTATE_180              - Attempt to rotate 180 degrees (SRS+ kicks)
+	//  - MOVE_LEFT        - Attempt to move to the left (auto-repeats while held)
+	//  - SOFT_DROP        - Attempt to soft drop (faster gravity while held)
+	//  - MOVE_RIGHT       - Attempt to move to the right (auto-repeats while held)
+	//  - HARD_DROP        - Hard drop
+	//  - HOLD             - Attempt to hold shape
+	//
+	// If attempt is successful, execute.
+	// Note: held actions are timed by the game, they are pressed once and released once.
+	//
+	// - param 1: Action action
+	void onActionPressed(Action action);
+
+	// Action processing for released actions
+	//  - Stops auto-shift for MOVE_LEFT/ MOVE_RIGHT (switching to the other direction if it is still held)
+	//  - Stops soft drop for SOFT_DROP
+	//
+	// - param 1: Action action
+	void onActionReleased(Action action);
+
+	// Set the handling (DAS, ARR and soft drop factor) settings.
+	//
+	// - param 1: Handling settings
+	void setHandling(const Handling& handling);
+
+	// Set the gravity curve used for each level's speed.
+	//
+	// - param 1: GravityCurve::Curve curve
+	void setGravityCurve(GravityCurve::Curve curve);
+
+	// Advance the game by one fixed tick (1 / TICKS_PER_SECOND seconds.)
+	//  - The gravity owed is counted exactly (no rounding of the elapsed time), so games
+	//     stepped with the same actions on the same ticks stay identical (lockstep, replays)
+	void step();
+
+	// Advance the game by a variable amount of time (such as the time between two loops.)
+	// - Applies all the rows of gravity owed since the last call in one step
+	//    (every row at once at 20G), so the speed does not depend on frame rate
+	// - If shape was placed, check to clear rows, send or receive garbage, spawn next
+	//    shape(s), update score, update level and lines, and reset all variables
+	//    as needed.
+	// - If game ends (the shape locked entirely in the hidden rows, garbage pushed
+	//    blocks off the board, or the next shape can not spawn), the game stops and
+	//    GAME_OVER is reported. It stays over until reset().
+	//
+	// - Advances the lock delay, and locks the currentShape once it expires
+	//
+	// Note: moves and rotations do not delay gravity, they may only restart the
+	//          lock delay (up to Handling::maxLockResets times), so a shape can
+	//          not be stalled forever.
+	//
+	// - param 1: float secondsSinceLastLoop
+	void advance(float secondsSinceLastLoop);
+
+	// Reset everything for a new game
+	//  - reset the score, level, and totalRowsCleared
+	//  - Clear the gameboard and the garbage
+	//  - Pick & spawn next shapes (both the "on-deck" shape, and the nextShapes
+	//
+	// - param 1: uint32_t, the seed for the shape order
+	void reset(std::uint32_t seed);
+
+	// Queue garbage sent by an opponent.
+	//  - It is added to the board when the next shape locks without clearing rows
+	//
+	// - param 1: int, rows of garbage
+	// - param 2: int, the hole column (x) of every row
+	void queueGarbage(int rows, int holeColumn);
+
+	// Take the rows of attack to send to the opponent (after cancelling incoming garbage.)
+	//
+	// - return: int, the rows of garbage to send (0 if none)
+	int takeOutgoingGarbage();
+
+	// Get the rows of garbage queued and not yet added to the board.
+	//
+	// - return: int, pending garbage rows
+	int getPendingGarbage() const;
+
+	// Determine if an event happened since it was last taken, and clear it.
+	//
+	// - param 1: Event event
+	// - return: bool, true if the event happened
+	bool takeEvent(Event event);
+
+	// Determine if the game topped out.
+	//
+	// - return: bool, true if the game is over (until reset())
+	bool isGameOver() const;
+
+	// Get the gameboard (including the hidden rows.)
+	//
+	// - return: Board, the gameboard
+	const Board& getBoard() const;
+
+	// Get what the last locked shape changed (its sequence counts the locks this game.)
+	//
+	// - return: LockDelta, the last lock (sequence 0 before the first lock)
+	const LockDelta& getLastLock() const;
+
+	// Get the current score.
+	//
+	// - return: int, the score
+	int getScore() const;
+
+	// Get the total lines cleared.
+	//
+	// - return: int, lines cleared this game
+	int getLines() const;
+
+	// Get the shape that is falling.
+	//
+	// - return: TetShape, the current shape
+	Tetromino::TetShape getCurrentShape() const;
+
+	// Get one of the next shapes.
+	//
+	// - param 1: int, the index (0 spawns next, up to NUM_NEXT_SHAPES - 1)
+	// - return: TetShape, the next shape
+	Tetromino::TetShape getNextShape(int index) const;
+
+	// Get the shape on hold.
+	//
+	// - param 1: TetShape, set to the shape on hold (if any)
+	// - return: bool, true if a shape is on hold
+	bool getHoldShape(Tetromino::TetShape& shape) const;
+
+	// Get the shape hold brings in: the shape on hold, or the next shape the first time.
+	//
+	// - return: TetShape, the shape a hold would make current
+	Tetromino::TetShape getShapeAfterHold() const;
+
+	// Get the shape hold brings in from a hold state (the rule of getShapeAfterHold(), for
+	// copies of a game such as GameState.)
+	//
+	// - param 1: bool, true if a shape is on hold
+	// - param 2: TetShape, the shape on hold (if any)
+	// - param 3: TetShape, the first next shape
+	// - return: TetShape, the shape a hold would make current
+	static Tetromino::TetShape getShapeAfterHold(bool holdShapeSet, Tetromino::TetShape holdShape, Tetromino::TetShape nextShape);
+
+	// Get the points for hard dropping a shape.
+	//
+	// - param 1: int, the rows it dropped
+	// - return: int, the points
+	static int getHardDropPoints(int rowsDropped);
+
+	// Get the points for the rows one shape cleared.
+	//
+	// - param 1: int, the rows cleared (0 - 4)
+	// - param 2: int, the level before the clear
+	// - return: int, the points
+	static int getRowClearPoints(int rowsCleared, int level);
+
+	// Get the level after a number of lines cleared.
+	//
+	// - param 1: int, the total lines cleared
+	// - return: int, the level (1 - numLevels)
+	static int getLevelForLines(int lines);
+
+	// Determine if hold can be used (once per shape.)
+	//
+	// - return: bool, true if the current shape has not been swapped with hold yet
+	bool isHoldAvailable() const;
+
+	// Get the bag that deals the shapes (after the next shapes.)
+	//
+	// - return: ShapeBag, the bag
+	const ShapeBag& getShapeBag() const;
+
+	// List the hard drop placements of the current shape, and of the shape hold would
+	// bring in (if hold can be used.)
+	//  - Each shape is rotated at the spawn location, then shifted left or right while it
+	//     can move, so every placement listed can be reached (no soft drop tucks or spins)
+	//  - Placements that cover the same blocks are only listed once per shape
+	//
+	// - param 1: Placement array, filled with the placements (MAX_PLACEMENTS at most)
+	// - return: int, the number of placements (0 if the game is over)
+	int getPlacements(Placement placements[MAX_PLACEMENTS]) const;
+
+	// Play a whole shape: hold (if asked), rotate, shift, hard drop, and lock it.
+	//  - Handles the lock like advance() does (rows, garbage, score, the next shape and
+	//     game over), with no time passing
+	//  - Nothing changes if the placement can not be reached (see getPlacements())
+	//
+	// - param 1: Placement, the placement
+	// - return: bool, true if the shape was placed
+	bool place(const Placement& placement);
+
+	// Get a hash of the game state (board, shapes, the bag, score, the handling, gravity and
+	// lock delay timers, the held actions and garbage.)
+	//  - Games that stay in step have equal hashes, so peers can detect a desync by
+	//     comparing hashes instead of whole states
+	//
+	// - return: uint32_t, FNV-1a hash of the game state
+	std::uint32_t getStateHash() const;
+
+	// Copy everything needed to draw the game into a snapshot.
+	//  - Only writes into the snapshot's fixed size arrays (never allocates)
+	//
+	// - param 1: Snapshot, filled with the current game state
+	void writeSnapshot(Snapshot& snapshot) const;
+
+
+
+private:
+	// ========================================================================
+	// =============================== Methods ================================
+	// ========================================================================
+
+
+	// ==============================================================
+	// ===================== Game loop methods ======================
+	// ==============================================================
+
+	// Gravity forces the currentShape to move (if there were no gravity,
+	// the currentShape would float in position forever). The shape is moved
+	// down by the rows owed, capped at its landing row, with one collision
+	// query (getDropDistance()). Once it can not move, the shape is resting on
+	// the stack and the lock delay decides when to lock() it.
+	//  - Rows moved while soft drop is held are scored as a soft drop
+	//
+	// - param 1: int, rows of gravity owed
+	void applyGravity(int rows);
+
+	// Restart the gravity and lock delay state for a new currentShape (spawned or swapped from hold).
+	void resetShapeTimers();
+
+	// Update the lock delay after the currentShape was moved or rotated.
+	//  - Reaching a new lowest row refills the resets and restarts the lock delay
+	//  - A player move/ rotation while (or into) resting restarts the lock delay,
+	//     if there are resets left
+	//
+	// - param 1: bool, true if the move was made by the player (not by gravity/ soft drop)
+	void onShapeMoved(bool byPlayer);
+
+	// Advance the lock delay by simulation time, and lock the currentShape if it expired.
+	//
+	// - param 1: double, seconds since the last call
+	void updateLockDelay(double seconds);
+
+	// Get the frames per row of gravity for the current level (from the gravityCurve table).
+	//  - Divided by the soft drop factor while soft drop is held
+	//
+	// - return: int32_t, fixed point (GravityCurve::FIXED_ONE) frames per row
+	std::int32_t getFramesPerRow() const;
+
+	// Start auto-shifting in a direction.
+	//  - Restarts the DAS timer for the new direction
+	//
+	// - param 1: int direction (-1 left, 1 right)
+	// - param 2: bool, true to also move the shape once immediately
+	void startAutoShift(int direction, bool moveNow);
+
+	// Advance the auto-shift timer and make any auto-repeated moves that are due.
+	//  - The number of moves depends only on how long the direction has been held,
+	//     not on how often this is called, so it is frame rate independent
+	//  - With an ARR of 0, the shape is moved straight to the wall once DAS is charged
+	//
+	// - param 1: double, seconds since the last call
+	void updateAutoShift(double seconds);
+
+	// Advance the game by an amount of time (see advance().)
+	//
+	// - param 1: double, seconds since the last call (for handling and the lock delay)
+	// - param 2: int64_t, fixed point frames since the last call (GravityCurve::FIXED_ONE per frame, for gravity)
+	void advanceBy(double seconds, std::int64_t frames);
+
+	// Handle the shape locked since the last advance
+	//  - Clear rows (sending garbage) or add the pending garbage, score, and spawn the next shape
+	//  - Ends the game if it topped out
+	void onShapeLocked();
+
+	// Updates level
+	//  - Level = totalRowsCleared / 10 + 1 (up to numLevels)
+	//  - reports LEVEL_UP if level up
+	void updateLevel();
+
+	// Record that an event happened (see takeEvent()).
+	//
+	// - param 1: Event event
+	void raiseEvent(Event event);
+
+
+	// ==============================================================
+	// ========================= Set Shapes =========================
+	// ==============================================================
+
+	// Fill the nextShapes with "NUM_NEXT_SHAPES" of shapes.
+	void setStartingShapes();
+
+	// Copy the nextShape into the currentShape (through assignment)
+	//  - Position the currentShape to its spawn location
+	//  - Updates the ghost shape
+	//
+	// - return: bool, true/false based on isPositionLegal()
+	bool spawnNextShape();
+
+	// Picks a new shape to put on the end of the nextShapes
+	//  - Removes the first of the nextShapes (moving the rest up)
+	//  - The new shape is dealt by the shapeBag (one of each shape, before a new set
+	//     of all shapes can be returned)
+	void pickNextShape();
+
+	// Sets hold shape
+	//  - Sets hold shape to what current shape is
+	//    - If there is already a current shape, set current shape to the previous
+	//       hold shape
+	//    - Else, set current shape to the next shape, and update the nextShapes
+	//       accordingly
+	//  - Does nothing if hold was used this round, or the shape it brings in does not fit
+	//     at the spawn location
+	//
+	// - return: bool, true if the shapes were swapped
+	bool setHoldShape();
+
+	// Swap the current shape with the hold shape (see setHoldShape()), without checking
+	// the shape it brings in fits at the spawn location
+	//  - For place(), which already checked the placement of the shape it brings in (in a
+	//     rotation that may fit where the spawn rotation does not)
+	void swapHoldShape();
+
+
+	// ==============================================================
+	// ========================== Movement ==========================
+	// ==============================================================
+
+	// Test if a rotation is legal on the tetromino and if so, rotate it.
+	//  - Tests the Super Rotation System kicks in order, and keeps the first
+	//     legal position (no heap allocation per test)
+	//
+	// - param 1: GridTetromino shape
+	// - param 2: int, quarter turns clockwise (1 - clockwise, 2 - 180, 3 or -1 - counter-clockwise)
+	// - return: bool, true/false to indicate successful movement
+	bool attemptRotate(GridTetromino& shape, int quarterTurns) const;
+
+	// Test if a move is legal on the tetromino, if so, move it.
+	//
+	// - param 1: GridTetromino shape
+	// - param 2: int x (cols)
+	// - param 3: int y (rows)
+	// - return: true/false to indicate successful movement
+	bool attemptMove(GridTetromino& shape, int x, int y) const;
+
+	// Move a shape from the spawn location to a placement's rotation and x (see place().)
+	//
+	// - param 1: GridTetromino shape, set to the shape at the placement (not dropped)
+	// - param 2: Placement, the placement (useHold picks the shape)
+	// - return: bool, true if every position on the way is legal
+	bool movePlacedShape(GridTetromino& shape, const Placement& placement) const;
+
+	// Get how far the tetromino can legally drop.
+	//  - One column mask lookup per block (no repeated attemptMove())
+	//
+	// - param 1: GridTetromino shape
+	// - return: int, rows the shape can drop (0 if it is resting on the stack or floor)
+	int getDropDistance(const GridTetromino& shape) const;
+
+	// Drops the tetromino vertically as far as it can legally go.
+	//  - The landing row is found directly from the gameboard's column masks,
+	//     with one lookup per block (no repeated attemptMove())
+	//
+	// - param 1: GridTetromino shape
+	// - return: int of num rows dropped
+	int drop(GridTetromino& shape) const;
+
+	// Copy the contents (color) of the Tetrominos mapped block locs to the grid.
+	//  - Remembers the locked shape, so only its rows are checked for completion
+	//  - Blocks in the hidden rows are kept, and flag a lock out if no block is visible
+	//
+	// - param 1: GridTetromino shape
+	// - return: nothing
+	void lock(const GridTetromino& shape);
+
+	// Updates ghost shape to be in the same position as current shape, but dropped.
+	void updateGhostShape();
+
+	// Determine if a Tetromino is resting on the stack or the floor.
+	//
+	// - param 1: GridTetromino shape
+	// - return: bool, true if the shape can not move down one row
+	bool isGrounded(const GridTetromino& shape) const;
+
+
+	// ==============================================================
+	// ================== State & gameplay/ logic ===================
+	// ==============================================================
+
+	// Determine if a Tetromino can legally be placed at its current position
+	// on the gameboard.
+	//
+	// - param 1: GridTetromino shape
+	// - return: bool, true if shape is within borders (isWithinBorders()) and 
+	//           the shape's mapped board locs are empty (false otherwise).
+	bool isPositionLegal(const GridTetromino& shape) const;
+
+	// Determine if the shape is within the gameboard borders
+	// The upper border is the top of the hidden rows, so shapes can spawn and
+	// rotate above the visible gameboard.
+	// All of a shape's blocks must be inside these 4 borders to return true.
+	//
+	// - param 1: GridTetromino shape
+	// - return: bool, true if the shape is within the left, right, and lower border
+	//	         of the grid, and below the top of the hidden rows (false otherwise)
+	bool isWithinBorders(const GridTetromino& shape) const;
+};
+
+#endif /* TETRISSIMULATION_H */
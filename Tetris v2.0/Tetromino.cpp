@@ -1,11 +1,7 @@
 #include "Tetromino.h"
 
 #include <iostream>
-
-
-// STATIC VARIABLE INITIALIZATION -----------------------------------------
-bool Tetromino::chosenShapes[];
-int Tetromino::numChosenShapes;
+#include "SuperRotationSystem.h"
 
 
 // Constructor ------------------------------------------------------------
@@ -30,40 +26,18 @@ Tetromino::TetShape Tetromino::getShape() const
 	return shape;
 }
 
-
-// Other Methods ---------------------------------
-
-Tetromino::TetShape Tetromino::getRandomShape(bool reset)
+int Tetromino::getRotation() const
 {
-	if ((numChosenShapes == static_cast<int>(TetShape::COUNT)) || (reset))
-	{
-		for (int i = 0, arrayLength = std::size(chosenShapes); i < arrayLength; i++)
-		{
-			chosenShapes[i] = false;
-		}
-
-		numChosenShapes = 0;
-	}
-
-	int randNum{ rand() % static_cast<int>(TetShape::COUNT) };
+	return rotation;
+}
 
-	while (chosenShapes[randNum])
-	{
-		if (randNum == static_cast<int>(TetShape::COUNT) - 1)
-		{
-			randNum = 0;
-		}
-		else
-		{
-			randNum++;
-		}
-	}
+const std::array<Point, Tetromino::NUM_BLOCKS>& Tetromino::getBlockLocs() const
+{
+	return blockLocs;
+}
 
-	chosenShapes[randNum] = true;
-	numChosenShapes++;
 
-	return static_cast<TetShape>(randNum);
-}
+// Other Methods ---------------------------------
 
 void Tetromino::setShape(const TetShape& shape)
 {
@@ -72,40 +46,22 @@ void Tetromino::setShape(const TetShape& shape)
 	switch (this->shape)
 	{
 	case TetShape::S:
-		blockLocs = {
-			Point(-1, 0),
-			Point(0, 0),
-			Point(0, 1),
-			Point(1, 1)
-		};
 		color = TetColor::RED;
 
 		xViewBlockOffset = 0.5;
-		yViewBlockOffset = 1;
+		yViewBlockOffset = 0;
 
 		break;
 
 	case TetShape::Z:
-		blockLocs = {
-			Point(-1, 1),
-			Point(0, 1),
-			Point(0, 0),
-			Point(1, 0)
-		};
 		color = TetColor::GREEN;
 
 		xViewBlockOffset = 0.5;
-		yViewBlockOffset = 1;
+		yViewBlockOffset = 0;
 
 		break;
 
 	case TetShape::J:
-		blockLocs = {
-			Point(-1, -1),
-			Point(-1, 0),
-			Point(0, 0),
-			Point(1, 0)
-		};
 		color = TetColor::BLUE_DARK;
 
 		xViewBlockOffset = 0.5;
@@ -114,12 +70,6 @@ void Tetromino::setShape(const TetShape& shape)
 		break;
 
 	case TetShape::L:
-		blockLocs = {
-			Point(-1, 0),
-			Point(0, 0),
-			Point(1, 0),
-			Point(1, -1)
-		};
 		color = TetColor::ORANGE;
 
 		xViewBlockOffset = 0.5;
@@ -128,26 +78,14 @@ void Tetromino::setShape(const TetShape& shape)
 		break;
 
 	case TetShape::O:
-		blockLocs = {
-			Point(-1, 0),
-			Point(-1, 1),
-			Point(0, 1),
-			Point(0, 0)
-		};
 		color = TetColor::YELLOW;
 
 		xViewBlockOffset = 0;
-		yViewBlockOffset = 1;
+		yViewBlockOffset = 0;
 
 		break;
 
 	case TetShape::I:
-		blockLocs = {
-			Point(-2, 0),
-			Point(-1, 0),
-			Point(0, 0),
-			Point(1, 0)
-		};
 		color = TetColor::BLUE_LIGHT;
 
 		xViewBlockOffset = 0;
@@ -156,12 +94,6 @@ void Tetromino::setShape(const TetShape& shape)
 		break;
 
 	case TetShape::T:
-		blockLocs = {
-			Point(-1, 0),
-			Point(0, 0),
-			Point(1, 0),
-			Point(0, -1)
-		};
 		color = TetColor::PURPLE;
 
 		xViewBlockOffset = 0.5;
@@ -174,22 +106,40 @@ void Tetromino::setShape(const TetShape& shape)
 			"		  \nSOMETHING EXTREMELY BROKEN"
 			"         \n---------------------------\n";
 	}
-}
 
+	setRotation(0);
+}
 
-void Tetromino::rotateClockwise()
+void Tetromino::setRotation(const int rotation)
 {
-	if (shape != TetShape::O)
+	this->rotation = rotation;
+
+	const SuperRotationSystem::Offset* offsets{SuperRotationSystem::getBlockOffsets(shape, rotation)};
+
+	for (int i{0}; i < NUM_BLOCKS; i++)
 	{
-		for (auto& blockLoc : blockLocs)
-		{
-			blockLoc.swapXY();
-			blockLoc.multiplyY(-1);
-		}
+		blockLocs[i].setXY(offsets[i].x, offsets[i].y);
 	}
 }
 
 
+void Tetromino::rotate(const int quarterTurns)
+{
+	// Wrap into [0, NUM_ROTATIONS) for negative turns too
+	setRotation(((rotation + quarterTurns) % NUM_ROTATIONS + NUM_ROTATIONS) % NUM_ROTATIONS);
+}
+
+void Tetromino::rotateClockwise()
+{
+	rotate(1);
+}
+
+void Tetromino::rotateCounterClockwise()
+{
+	rotate(-1);
+}
+
+
 void Tetromino::printToConsole() const
 {
 	for (int y{3}; y >= -3; y--)
@@ -2,13 +2,17 @@
 
 #pragma once
 
-#include <vector>
+#include <array>
 #include "Point.h"
 
 
 class Tetromino
 {
 public:
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int NUM_BLOCKS{4};		// Number of blocks in every Tetromino
+	static constexpr int NUM_ROTATIONS{4};	// Number of rotation states (0 - spawn, 1 - R, 2, 3 - L)
+
 	// ENUM CLASS -------------------------------------------------------------
 
 	// Enum Tetromino Color for each color possible for the Tetrominos
@@ -43,15 +47,7 @@ private:
 
 	TetColor color;	// Tetromino Color
 	TetShape shape;	// Tetromino Shape
-
-
-	// STATIC VARIABLES -------------------------------------------------------
-
-	// A bool array of size TetShape::COUNT
-	static bool chosenShapes[static_cast<int>(TetShape::COUNT)];
-
-	// Num of shapes chosen
-	static int numChosenShapes;										
+	int rotation;	// Tetromino rotation state (0 - 3, see SuperRotationSystem)
 
 
 public:
@@ -68,31 +64,41 @@ public:
 
 	TetColor getColor() const; // Get the Color
 	TetShape getShape() const; // Get the Shape
+	int getRotation() const;   // Get the rotation state
 
+	const std::array<Point, NUM_BLOCKS>& getBlockLocs() const; // Get the block locs (relative to [0,0])
 
-	// Other Methods ---------------------------------
 
-	// Chooses a random shape.
-	//  - Choose a shape that hasn't been chosen yet, when all shapes has been
-	//     chosen, all shapes can be chosen again
-	//
-	// - param 1: a bool to determine if reset it needed (such as when the game resets)
-	static TetShape getRandomShape(bool reset);
+	// Other Methods ---------------------------------
 
 	// Set the shape.
 	//  - Set the shape
-	//  - Set the blockLocs for the shape
+	//  - Set the blockLocs for the shape (in its spawn rotation state)
 	//  - Set the color for the shape
 	//  - Set the X and Y offset for the shape
 	//
 	// - param 1: shape - the shape to set
 	void setShape(const TetShape& shape);
 
+	// Set the rotation state, and the blockLocs for it (from the SRS tables.)
+	//
+	// - param 1: int, the rotation state (0 - 3)
+	void setRotation(int rotation);
+
 
-	// Rotate the shape 90 degrees around [0,0] (clockwise)
-	// - Note: TetShape::O will not rotate
+	// Rotate the shape by quarter turns around its SRS rotation center
+	// (no kicks, see TetrisGame::attemptRotate() for kicks.)
+	// - Note: TetShape::O will not change
+	//
+	// - param 1: int, quarter turns clockwise (negative for counter-clockwise)
+	void rotate(int quarterTurns);
+
+	// Rotate the shape 90 degrees clockwise
 	void rotateClockwise();
 
+	// Rotate the shape 90 degrees counter-clockwise
+	void rotateCounterClockwise();
+
 
 	// Print a grid to display the current shape
 	void printToConsole() const;
@@ -100,7 +106,7 @@ public:
 
 protected:
 	// PROTECTED MEMBER VARIABLES ---------------------------------------------
-	std::vector<Point> blockLocs;
+	std::array<Point, NUM_BLOCKS> blockLocs;
 
 	// Offset for X and Y when viewing (for either being on hold, or on next shapes)
 	float xViewBlockOffset;
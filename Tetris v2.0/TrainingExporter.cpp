@@ -0,0 +1,351 @@
+#include "TrainingExporter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+
+static constexpr int NUM_COLUMNS{TrainingExporter::NUM_COLUMNS};
+
+static_assert(sizeof(TrainingExporter::COLUMN_BYTES) / sizeof(int) == NUM_COLUMNS, "Every column needs its bytes per record");
+static_assert(24 + 16 * NUM_COLUMNS <= TrainingExporter::HEADER_BYTES, "The column table must fit in the header");
+static_assert(TrainingExporter::CHUNK_RECORDS % TrainingExporter::COLUMN_ALIGNMENT == 0, "Chunks must start on their own cache lines in every column");
+
+
+// Write an unsigned value in little endian order.
+//
+// - param 1: uint8_t pointer, the position to write at
+// - param 2: uint64_t, the value
+// - param 3: int, the bytes to write (1 - 8)
+static void writeUint(std::uint8_t* const position, const std::uint64_t value, const int bytes)
+{
+	for (int i{0}; i < bytes; i++)
+	{
+		position[i] = static_cast<std::uint8_t>(value >> (i * 8));
+	}
+}
+
+// Mix a seed with two indices into the seed of one chunk, game or policy (murmur3 finalizer),
+// so neighbouring shards, chunks and games do not play related shape orders
+static std::uint32_t mixSeed(const std::uint32_t seed, const std::uint32_t major, const std::uint32_t minor)
+{
+	std::uint32_t hash{seed ^ (major * 0x9E3779B9u) ^ (minor * 0x85EBCA6Bu)};
+
+	hash ^= hash >> 16;
+	hash *= 0x85EBCA6Bu;
+	hash ^= hash >> 13;
+	hash *= 0xC2B2AE35u;
+	hash ^= hash >> 16;
+
+	return hash;
+}
+
+
+ExportError::ExportError(const std::string& path)
+	: std::runtime_error("could not write training data shard " + path)
+{
+}
+
+
+// Constructor ------------------------------------------------------------
+
+TrainingExporter::TrainingExporter(const Settings& settings)
+	: settings(validateSettings(settings)), pool(settings.numWorkers)
+{
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+TrainingExporter::Result TrainingExporter::run()
+{
+	const auto start{std::chrono::steady_clock::now()};
+
+	const std::int64_t recordsPerShard{getRecordsPerShard(settings.shardBytes)};
+	const int shards{static_cast<int>((settings.records + recordsPerShard - 1) / recordsPerShard)};
+	const int maxShardsInMemory{pool.getNumWorkers() + 1};
+
+	std::vector<std::unique_ptr<Shard>> shardList(static_cast<std::size_t>(shards));
+
+	{
+		std::lock_guard<std::mutex> lock(doneMutex);
+		shardsLeft = shards;
+		shardsInMemory = 0;
+		result = Result{};
+		failedPath.clear();
+	}
+
+	for (int index{0}; index < shards; index++)
+	{
+		// Wait for a shard to be written before building another one past the limit
+		{
+			std::unique_lock<std::mutex> lock(doneMutex);
+
+			shardDone.wait(lock, [this, maxShardsInMemory]() { return shardsInMemory < maxShardsInMemory; });
+			shardsInMemory++;
+		}
+
+		shardList[index] = std::make_unique<Shard>();
+		Shard& shard{*shardList[index]};
+
+		shard.index = index;
+		shard.records = std::min(recordsPerShard, settings.records - index * recordsPerShard);
+		getColumnOffsets(shard.records, shard.offsets);
+
+		// Zeroed, so the padding between the columns is written as zeros
+		shard.storage.resize(static_cast<std::size_t>(shard.offsets[NUM_COLUMNS] + COLUMN_ALIGNMENT - 1));
+		shard.image = shard.storage.data() + (COLUMN_ALIGNMENT - reinterpret_cast<std::uintptr_t>(shard.storage.data()) % COLUMN_ALIGNMENT) % COLUMN_ALIGNMENT;
+
+		const int chunks{static_cast<int>((shard.records + CHUNK_RECORDS - 1) / CHUNK_RECORDS)};
+		shard.chunksLeft = chunks;
+
+		for (int chunk{0}; chunk < chunks; chunk++)
+		{
+			const std::int64_t firstRecord{chunk * CHUNK_RECORDS};
+			const std::int64_t records{std::min(CHUNK_RECORDS, shard.records - firstRecord)};
+
+			pool.submit([this, &shard, firstRecord, records]() { exportChunk(shard, firstRecord, records); });
+		}
+	}
+
+	std::unique_lock<std::mutex> lock(doneMutex);
+
+	shardDone.wait(lock, [this]() { return shardsLeft == 0; });
+
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	if (!failedPath.empty())
+	{
+		throw ExportError(failedPath);
+	}
+
+	return result;
+}
+
+std::int64_t TrainingExporter::getMinShardBytes()
+{
+	std::int64_t offsets[NUM_COLUMNS + 1];
+	getColumnOffsets(1, offsets);
+
+	return offsets[NUM_COLUMNS];
+}
+
+std::int64_t TrainingExporter::getRecordsPerShard(const std::int64_t shardBytes)
+{
+	int recordBytes{0};
+
+	for (const int bytes : COLUMN_BYTES)
+	{
+		recordBytes += bytes;
+	}
+
+	// Room for the header, and the padding that aligns each column
+	return std::max<std::int64_t>(1, (shardBytes - HEADER_BYTES - NUM_COLUMNS * COLUMN_ALIGNMENT) / recordBytes);
+}
+
+std::string TrainingExporter::getShardPath(const std::string& pathPrefix, const int shard)
+{
+	char index[16];
+	std::snprintf(index, sizeof(index), "%05d", shard);
+
+	return pathPrefix + "-" + index + ".tdat";
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+const TrainingExporter::Settings& TrainingExporter::validateSettings(const Settings& settings)
+{
+	if (settings.records <= 0)
+	{
+		throw std::invalid_argument("training data records must be positive");
+	}
+
+	if (settings.shardBytes < getMinShardBytes())
+	{
+		throw std::invalid_argument("training data shards must be at least " + std::to_string(getMinShardBytes()) + " bytes");
+	}
+
+	if (settings.maxPlacementsPerGame <= 0)
+	{
+		throw std::invalid_argument("training data games must allow a placement");
+	}
+
+	return settings;
+}
+
+void TrainingExporter::exportChunk(Shard& shard, const std::int64_t firstRecord, const std::int64_t records)
+{
+	using Placement = TetrisSimulation::Placement;
+
+	// Records are indexed from the start of the shard, each chunk only touches its own slice
+	auto column = [&shard](const Column id, const std::int64_t record)
+	{
+		return shard.image + shard.offsets[static_cast<int>(id)] + record * COLUMN_BYTES[static_cast<int>(id)];
+	};
+
+	const std::uint32_t chunkSeed{mixSeed(settings.seed, static_cast<std::uint32_t>(shard.index), static_cast<std::uint32_t>(firstRecord / CHUNK_RECORDS))};
+	const std::int64_t endRecord{firstRecord + records};
+
+	std::uint32_t game{0};		// The index of the game being played (seeds it)
+	std::int64_t gamesPlayed{0};	// Games with a record in the chunk
+	TetrisSimulation simulation{mixSeed(chunkSeed, game, 0)};
+	PlacementPolicy policy{settings.policy, mixSeed(~chunkSeed, 0, 0)};
+	int gamePlacements{0};
+
+	Placement placements[TetrisSimulation::MAX_PLACEMENTS];
+	TetrisSimulation::Board::PackedBoard packed;
+
+	for (std::int64_t record{firstRecord}; record < endRecord; record++)
+	{
+		const int count{simulation.getPlacements(placements)};
+		const int chosen{policy.choose(simulation, placements, count)};
+
+		// No shape can be placed (it should have topped out), start the next game over
+		if ((chosen < 0) || (gamePlacements >= settings.maxPlacementsPerGame))
+		{
+			if (record > firstRecord)
+			{
+				*column(Column::FLAGS, record - 1) |= TRUNCATED_FLAG;
+			}
+
+			simulation.reset(mixSeed(chunkSeed, ++game, 0));
+			gamePlacements = 0;
+			record--;
+
+			continue;
+		}
+
+		const Placement& placement{placements[chosen]};
+
+		gamesPlayed += (gamePlacements == 0);
+
+		// The state before the placement
+		simulation.getBoard().pack(packed);
+
+		for (int i{0}; i < TetrisSimulation::Board::PACKED_WORDS; i++)
+		{
+			writeUint(column(Column::BOARD, record) + i * 8, packed.occupancy[i], 8);
+		}
+
+		*column(Column::CURRENT, record) = static_cast<std::uint8_t>(simulation.getCurrentShape());
+
+		for (int i{0}; i < TetrisSimulation::NUM_NEXT_SHAPES; i++)
+		{
+			column(Column::NEXT, record)[i] = static_cast<std::uint8_t>(simulation.getNextShape(i));
+		}
+
+		Tetromino::TetShape holdShape;
+		*column(Column::HOLD, record) = simulation.getHoldShape(holdShape) ? static_cast<std::uint8_t>(holdShape) : NO_SHAPE;
+
+		std::uint8_t* const placementBytes{column(Column::PLACEMENT, record)};
+		placementBytes[0] = placement.useHold;
+		placementBytes[1] = static_cast<std::uint8_t>(placement.rotation);
+		placementBytes[2] = static_cast<std::uint8_t>(placement.x);
+		placementBytes[3] = static_cast<std::uint8_t>(placement.y);
+
+		// Play it
+		const int scoreBefore{simulation.getScore()};
+		const int linesBefore{simulation.getLines()};
+
+		simulation.place(placement);
+		gamePlacements++;
+
+		const float reward{static_cast<float>(simulation.getScore() - scoreBefore)};
+		std::uint32_t rewardBits;
+		std::memcpy(&rewardBits, &reward, sizeof(rewardBits));
+
+		writeUint(column(Column::REWARD, record), rewardBits, 4);
+		*column(Column::LINES, record) = static_cast<std::uint8_t>(simulation.getLines() - linesBefore);
+
+		std::uint8_t flags{0};
+
+		if (simulation.isGameOver())
+		{
+			flags |= GAME_OVER_FLAG;
+
+			simulation.reset(mixSeed(chunkSeed, ++game, 0));
+			gamePlacements = 0;
+		}
+		else if (record == endRecord - 1)
+		{
+			flags |= TRUNCATED_FLAG;	// The chunk is full
+		}
+
+		*column(Column::FLAGS, record) = flags;
+	}
+
+	shard.games += gamesPlayed;
+
+	// The last chunk sees every other chunk's records (acquire), and writes the shard
+	if (shard.chunksLeft.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		writeShard(shard);
+	}
+}
+
+void TrainingExporter::writeShard(Shard& shard)
+{
+	std::uint8_t* const header{shard.image};
+
+	std::memcpy(header, MAGIC, 8);
+	writeUint(header + 8, VERSION, 4);
+	writeUint(header + 12, NUM_COLUMNS, 4);
+	writeUint(header + 16, static_cast<std::uint64_t>(shard.records), 8);
+
+	for (int i{0}; i < NUM_COLUMNS; i++)
+	{
+		std::uint8_t* const entry{header + 24 + i * 16};
+
+		writeUint(entry, static_cast<std::uint64_t>(i), 4);
+		writeUint(entry + 4, static_cast<std::uint64_t>(COLUMN_BYTES[i]), 4);
+		writeUint(entry + 8, static_cast<std::uint64_t>(shard.offsets[i]), 8);
+	}
+
+	// One sequential write of the whole file image
+	const std::string path{getShardPath(settings.pathPrefix, shard.index)};
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+	file.write(reinterpret_cast<const char*>(shard.image), static_cast<std::streamsize>(shard.offsets[NUM_COLUMNS]));
+	file.close();
+
+	const std::int64_t bytes{file ? shard.offsets[NUM_COLUMNS] : 0};
+
+	shard.image = nullptr;
+	std::vector<std::uint8_t>().swap(shard.storage);
+
+	{
+		std::lock_guard<std::mutex> lock(doneMutex);
+
+		if (bytes == 0)
+		{
+			failedPath = failedPath.empty() ? path : failedPath;
+		}
+		else
+		{
+			result.records += shard.records;
+			result.games += shard.games;
+			result.shards++;
+			result.bytes += bytes;
+		}
+
+		shardsLeft--;
+		shardsInMemory--;
+	}
+
+	shardDone.notify_all();
+}
+
+void TrainingExporter::getColumnOffsets(const std::int64_t records, std::int64_t offsets[])
+{
+	offsets[0] = HEADER_BYTES;
+
+	for (int i{0}; i < NUM_COLUMNS; i++)
+	{
+		const std::int64_t end{offsets[i] + records * COLUMN_BYTES[i]};
+
+		offsets[i + 1] = (end + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT;
+	}
+}
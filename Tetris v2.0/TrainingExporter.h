@@ -0,0 +1,215 @@
+// The TrainingExporter class plays headless games with a PlacementPolicy, and writes one
+// record per placed shape to columnar binary shard files (training data for offline learning.)
+//  - A record is the state before the placement (the packed board, the current, next and
+//     hold shapes), the placement the policy chose, the reward (score gained), the lines
+//     cleared and flags (the game ended, or was cut off)
+//  - Columnar: every column of a shard is one contiguous array at a 64 byte aligned offset,
+//     so a shard can be memory-mapped and each column used in place as an array
+//  - Sharded by size: a shard holds the records that fit in Settings::shardBytes, and is
+//     built in memory as its file image, then written with one sequential write (never one
+//     write per record)
+//  - Chunked: a shard's records are split into chunks of CHUNK_RECORDS, each played by its
+//     own task on a WorkStealingPool into its own slice of every column (disjoint cache
+//     lines), so even a single shard keeps every worker busy. At most one shard more than
+//     there are workers is in memory at a time
+//  - Deterministic: the games of a chunk are seeded from the seed, the shard and the chunk
+//     index (a game is cut off at the end of its chunk), so the same settings write the
+//     same files for any number of workers
+//  - Settings are checked when the exporter is made (std::invalid_argument if records,
+//     shardBytes or maxPlacementsPerGame can not export anything)
+//
+// Shard format (little endian):
+//  - Header (HEADER_BYTES): char[8] "TETRDATA", uint32 version, uint32 column count, uint64
+//     record count, then per column: uint32 column id, uint32 bytes per record, uint64 offset
+//  - Columns, in Column order:
+//     BOARD: uint64[PACKED_WORDS], the occupancy (see Gameboard::pack(), hidden rows first)
+//     CURRENT: uint8, the current shape (TetShape)
+//     NEXT: uint8[NUM_NEXT_SHAPES], the next shapes
+//     HOLD: uint8, the shape on hold (NO_SHAPE if none)
+//     PLACEMENT: uint8 use hold, int8 rotation, int8 x, int8 y (see TetrisSimulation::Placement)
+//     REWARD: float32, the score gained
+//     LINES: uint8, the lines cleared
+//     FLAGS: uint8, GAME_OVER_FLAG and TRUNCATED_FLAG
+
+#ifndef TRAININGEXPORTER_H
+#define TRAININGEXPORTER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "PlacementPolicy.h"
+#include "TetrisSimulation.h"
+#include "WorkStealingPool.h"
+
+
+// Thrown when a shard can not be written
+class ExportError : public std::runtime_error
+{
+public:
+	// Constructor
+	//
+	// - param 1: string, the path of the shard
+	explicit ExportError(const std::string& path);
+};
+
+
+class TrainingExporter
+{
+public:
+	// TYPES ------------------------------------------------------------------
+
+	// The columns of a shard, in file order
+	enum class Column : std::uint32_t
+	{
+		BOARD,
+		CURRENT,
+		NEXT,
+		HOLD,
+		PLACEMENT,
+		REWARD,
+		LINES,
+		FLAGS,
+		COUNT
+	};
+
+	// What to export
+	struct Settings
+	{
+		std::string pathPrefix{"training"};			// Shards are written to <pathPrefix>-<shard>.tdat
+		PlacementPolicy::Kind policy{PlacementPolicy::Kind::GREEDY};	// Picks the placements
+		std::int64_t records{1000000};				// Records to write (over every shard)
+		std::int64_t shardBytes{32 << 20};			// Largest shard file (bytes)
+		int numWorkers{0};							// Workers (0 for one per hardware thread)
+		std::uint32_t seed{1};						// Seeds the games and the policy
+		int maxPlacementsPerGame{10000};			// Placements before a game is cut off
+	};
+
+	// What was exported (see run())
+	struct Result
+	{
+		std::int64_t records{0};	// Records written
+		std::int64_t games{0};		// Games played (cut off ones too)
+		int shards{0};				// Shard files written
+		std::int64_t bytes{0};		// Bytes written
+		double seconds{0.0};		// Time taken
+	};
+
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr char MAGIC[]{"TETRDATA"};		// First 8 bytes of a shard
+	static constexpr std::uint32_t VERSION{1};		// Shard format version
+	static constexpr int HEADER_BYTES{256};			// Header bytes (the first column follows)
+	static constexpr int COLUMN_ALIGNMENT{64};		// Byte alignment of every column
+	static constexpr int NUM_COLUMNS{static_cast<int>(Column::COUNT)};	// Columns of a shard
+	static constexpr std::int64_t CHUNK_RECORDS{1 << 14};	// Records played by one task (a multiple of COLUMN_ALIGNMENT)
+
+	static constexpr std::uint8_t NO_SHAPE{0xFF};			// HOLD when no shape is on hold
+	static constexpr std::uint8_t GAME_OVER_FLAG{1};		// The game topped out after the placement
+	static constexpr std::uint8_t TRUNCATED_FLAG{2};		// The game was cut off after the placement (chunk full or too long)
+
+	// Bytes per record of each column (in Column order)
+	static constexpr int COLUMN_BYTES[]{TetrisSimulation::Board::PACKED_WORDS * 8, 1, TetrisSimulation::NUM_NEXT_SHAPES, 1, 4, 4, 1, 1};
+
+private:
+	// A shard being played, built in memory as its file image
+	struct Shard
+	{
+		int index{0};							// The shard index
+		std::int64_t records{0};				// Records of the shard
+		std::int64_t offsets[NUM_COLUMNS + 1]{};	// File offset of each column, then the file size
+		std::vector<std::uint8_t> storage;		// The file image (and the slack that aligns it)
+		std::uint8_t* image{nullptr};			// The file image, 64 byte aligned (in storage)
+		std::atomic<int> chunksLeft{0};			// Chunks not played yet (the last one writes the file)
+		std::atomic<std::int64_t> games{0};		// Games with a record in the shard
+	};
+
+	// MEMBER VARIABLES -------------------------------------------------------
+	Settings settings;						// What to export
+
+	std::mutex doneMutex;					// Guards the members below
+	std::condition_variable shardDone;		// Signaled when a shard is written
+	int shardsLeft{0};						// Shards not written yet
+	int shardsInMemory{0};					// Shards submitted and not written yet
+	Result result;							// Totals of the finished shards
+	std::string failedPath;					// The first shard that could not be written (empty if none)
+
+	WorkStealingPool pool;					// Plays and writes the shards (last, so it stops first)
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//  - Starts the pool's workers
+	//  - Throws a std::invalid_argument if records, shardBytes or maxPlacementsPerGame is
+	//     not positive, or shardBytes is too small for one record (see getMinShardBytes())
+	//
+	// - param 1: Settings, what to export
+	explicit TrainingExporter(const Settings& settings);
+
+	// The exporter owns threads, so it can not be copied
+	TrainingExporter(const TrainingExporter&) = delete;
+	TrainingExporter& operator=(const TrainingExporter&) = delete;
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Play the games and write every shard, waiting until they are all written.
+	//  - Throws an ExportError if a shard can not be written (the others are still written)
+	//
+	// - return: Result, what was exported
+	Result run();
+
+	// Get the smallest shard file that holds a record.
+	//
+	// - return: int64_t, the header, one record and the padding of every column (bytes)
+	static std::int64_t getMinShardBytes();
+
+	// Get the records of a full shard.
+	//
+	// - param 1: int64_t, the largest shard file (bytes)
+	// - return: int64_t, records per shard (at least 1)
+	static std::int64_t getRecordsPerShard(std::int64_t shardBytes);
+
+	// Get the path of a shard.
+	//
+	// - param 1: string, the path prefix
+	// - param 2: int, the shard index
+	// - return: string, <pathPrefix>-<shard, 5 digits>.tdat
+	static std::string getShardPath(const std::string& pathPrefix, int shard);
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// Check the settings before any work starts.
+	//  - Throws a std::invalid_argument if they can not export anything
+	//
+	// - param 1: Settings, what to export
+	// - return: Settings, the same settings
+	static const Settings& validateSettings(const Settings& settings);
+
+	// Play games until a chunk of a shard is full, and write the shard if it was the last
+	// chunk left (run on a worker.)
+	//
+	// - param 1: Shard, the shard
+	// - param 2: int64_t, the first record of the chunk
+	// - param 3: int64_t, the records of the chunk
+	void exportChunk(Shard& shard, std::int64_t firstRecord, std::int64_t records);
+
+	// Write a shard's file image to its file (see the shard format), and free the image.
+	//
+	// - param 1: Shard, the shard (every chunk played)
+	void writeShard(Shard& shard);
+
+	// Get the file offset of every column (64 byte aligned, after the header.)
+	//
+	// - param 1: int64_t, the records
+	// - param 2: int64_t array, filled with the offset of each column, then the file size
+	static void getColumnOffsets(std::int64_t records, std::int64_t offsets[]);
+};
+
+#endif /* TRAININGEXPORTER_H */
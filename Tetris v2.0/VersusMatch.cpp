@@ -0,0 +1,136 @@
+#include "VersusMatch.h"
+
+#include <cassert>
+#include <type_traits>
+
+
+static_assert(std::is_trivially_copyable<VersusMatch::State>::value, "Match states are saved by copying them");
+
+
+// Constructor ------------------------------------------------------------
+
+VersusMatch::VersusMatch(const std::uint32_t seed, const bool recordInput)
+	: seed(seed),
+	  state{{TetrisSimulation{seed}, TetrisSimulation{seed}}, Random{seed ^ 0xA5A5A5A5u}, 0, false, NO_WINNER},
+	  recordInput(recordInput)
+{
+}
+
+
+// State ------------------------------------------------------------------
+
+std::uint32_t VersusMatch::State::getHash() const
+{
+	std::uint32_t hash{0};
+
+	for (const TetrisSimulation& player : players)
+	{
+		hash = (hash * 31u) ^ player.getStateHash();
+	}
+
+	return hash;
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+void VersusMatch::step(const TickActions& actions)
+{
+	if (state.over)
+	{
+		return;
+	}
+
+	TetrisSimulation* const players{state.players};
+
+	if (recordInput)
+	{
+		inputLog.push_back(actions);
+	}
+
+	state.tick++;
+
+	for (int i{0}; i < NUM_PLAYERS; i++)
+	{
+		players[i].applyActions(actions.players[i]);
+		players[i].step();
+	}
+
+	// Exchange the garbage sent this tick
+	for (int i{0}; i < NUM_PLAYERS; i++)
+	{
+		const int rows{players[i].takeOutgoingGarbage()};
+
+		if (rows > 0)
+		{
+			players[(i + 1) % NUM_PLAYERS].queueGarbage(rows, state.garbageRandom.nextInt(TetrisSimulation::Board::MAX_X));
+		}
+	}
+
+	const bool player1Lost{players[0].isGameOver()};
+	const bool player2Lost{players[1].isGameOver()};
+
+	if (player1Lost || player2Lost)
+	{
+		state.over = true;
+
+		if (player1Lost != player2Lost)
+		{
+			state.winner = player1Lost ? 1 : 0;
+		}
+	}
+}
+
+void VersusMatch::restoreState(const State& savedState)
+{
+	assert((savedState.tick >= 0) && (savedState.tick <= state.tick) && "The state is not from this match.");
+
+	state = savedState;
+
+	if (recordInput)
+	{
+		inputLog.resize(static_cast<std::size_t>(state.tick));
+	}
+}
+
+const TetrisSimulation& VersusMatch::getPlayer(const int player) const
+{
+	assert((player >= 0) && (player < NUM_PLAYERS) && "Invalid player.");
+
+	return state.players[player];
+}
+
+const VersusMatch::State& VersusMatch::getState() const
+{
+	return state;
+}
+
+std::uint32_t VersusMatch::getSeed() const
+{
+	return seed;
+}
+
+std::int64_t VersusMatch::getTick() const
+{
+	return state.tick;
+}
+
+bool VersusMatch::isOver() const
+{
+	return state.over;
+}
+
+int VersusMatch::getWinner() const
+{
+	return state.winner;
+}
+
+std::uint32_t VersusMatch::getStateHash() const
+{
+	return state.getHash();
+}
+
+const std::vector<VersusMatch::TickActions>& VersusMatch::getInputLog() const
+{
+	return inputLog;
+}
@@ -0,0 +1,117 @@
+// The VersusMatch class runs a two player versus game: two TetrisSimulations side by
+// side, sending garbage to each other.
+//  - The match is the single authority: both players are stepped in lockstep, one
+//     fixed tick at a time, and garbage is exchanged at the end of each tick
+//  - Rows a player clears first cancel the garbage queued for them, the rest is sent
+//     to the opponent with a hole column picked by the match's seeded Random
+//  - Everything is decided by the seed and the actions given to step(), so a match is
+//     replayed by stepping a new match with the same seed through getInputLog() (when
+//     the match records its input), and bots can play it headless (no graphics or audio)
+//  - Everything a tick changes is one trivially copyable State, so the match can be
+//     saved and restored by copying it (see getState()/ restoreState(), for rollback)
+
+#ifndef VERSUSMATCH_H
+#define VERSUSMATCH_H
+
+#include <cstdint>
+#include <vector>
+#include "Actions.h"
+#include "Random.h"
+#include "TetrisSimulation.h"
+
+
+class VersusMatch
+{
+public:
+	// STATIC CONSTANT EXPR ---------------------------------------------------
+	static constexpr int NUM_PLAYERS{2};	// Players in a match
+	static constexpr int NO_WINNER{-1};		// getWinner() of a running match, or a draw
+
+	// The actions of every player during one tick
+	struct TickActions
+	{
+		ActionFrame players[NUM_PLAYERS];
+	};
+
+	// Everything that is changed by step() (a snapshot of the match)
+	//  - Trivially copyable, so saving and restoring it is a plain copy
+	struct State
+	{
+		TetrisSimulation players[NUM_PLAYERS];	// The players' games, by player index
+
+		Random garbageRandom;					// Picks the hole column of sent garbage
+		std::int64_t tick;						// Ticks stepped so far
+		bool over;								// True once a player topped out
+		int winner;								// The winning player (NO_WINNER until over, or on a draw)
+
+		// Get a hash of both players' game states (see TetrisSimulation::getStateHash().)
+		//
+		// - return: uint32_t, the combined hash
+		std::uint32_t getHash() const;
+	};
+
+private:
+	// MEMBER VARIABLES -------------------------------------------------------
+	std::uint32_t seed;							// The seed the match was started with
+	State state;								// The players and the rest of the match state
+
+	bool recordInput;							// True if inputLog is kept (it grows by one every tick)
+	std::vector<TickActions> inputLog;			// The actions of every tick stepped (for replays)
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//  - Both players are dealt the same shapes (same bag seed)
+	//  - The input log is only kept if asked for, so a long running match (a server's)
+	//     does not grow
+	//
+	// - param 1: uint32_t, the seed for the shapes and garbage holes
+	// - param 2: bool, true to keep the actions of every tick (see getInputLog())
+	explicit VersusMatch(std::uint32_t seed, bool recordInput = false);
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Advance both players by one tick.
+	//  - Applies each player's actions, steps each player, then sends each player's
+	//     attack to the other (always player 1 then player 2)
+	//  - Ends the match when a player tops out (both topping out on one tick is a draw)
+	//  - Does nothing once the match is over
+	//
+	// - param 1: TickActions, the actions of each player this tick
+	void step(const TickActions& actions);
+
+	// Restore the match to a state saved from it (see getState().)
+	//  - The input log (if recorded) is cut back to the restored tick
+	//
+	// - param 1: State, a state of this match (at or before the current tick)
+	void restoreState(const State& savedState);
+
+	// Getters ---------------------------------
+
+	// Get a player's game (to draw it, or for a bot to read.)
+	//
+	// - param 1: int, the player index (0 - NUM_PLAYERS - 1)
+	// - return: TetrisSimulation, the player's game
+	const TetrisSimulation& getPlayer(int player) const;
+
+	const State& getState() const;		// Get the match state (copy it to save the match)
+	std::uint32_t getSeed() const;		// Get the seed the match was started with
+	std::int64_t getTick() const;		// Get the number of ticks stepped
+	bool isOver() const;				// True once a player topped out
+	int getWinner() const;				// Get the winning player (NO_WINNER while running, or on a draw)
+
+	// Get a hash of both players' game states (see TetrisSimulation::getStateHash().)
+	//
+	// - return: uint32_t, the combined hash
+	std::uint32_t getStateHash() const;
+
+	// Get the actions of every tick stepped, in order.
+	//  - Empty unless the match was constructed to record its input
+	//
+	// - return: a vector of TickActions, one per tick
+	const std::vector<TickActions>& getInputLog() const;
+};
+
+#endif /* VERSUSMATCH_H */
@@ -0,0 +1,136 @@
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+
+
+// Constructor ------------------------------------------------------------
+
+WorkStealingPool::WorkStealingPool(const int numWorkers)
+{
+	const int count{(numWorkers > 0) ? numWorkers : std::max(1, static_cast<int>(std::thread::hardware_concurrency()))};
+
+	// Every queue exists before any worker starts (workers steal from all of them)
+	for (int i{0}; i < count; i++)
+	{
+		queues.push_back(std::make_unique<WorkerQueue>());
+	}
+
+	for (int i{0}; i < count; i++)
+	{
+		workers.emplace_back(&WorkStealingPool::runWorker, this, i);
+	}
+}
+
+
+// METHODS ----------------------------------------------------------------
+
+void WorkStealingPool::submit(Task task)
+{
+	WorkerQueue& queue{*queues[nextQueue++ % queues.size()]};
+
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.tasks.push_back(std::move(task));
+	}
+
+	queuedTasks++;
+
+	// Lock so a worker can not miss the wake up between checking for tasks and sleeping
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+
+	wakeUp.notify_one();
+}
+
+int WorkStealingPool::getNumWorkers() const
+{
+	return static_cast<int>(workers.size());
+}
+
+int WorkStealingPool::getQueueDepth() const
+{
+	return queuedTasks;
+}
+
+
+// Destructor -------------------------------------------------------------
+
+WorkStealingPool::~WorkStealingPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		stopping = true;
+	}
+
+	wakeUp.notify_all();
+
+	for (std::thread& worker : workers)
+	{
+		if (worker.joinable())
+		{
+			worker.join();
+		}
+	}
+}
+
+
+// PRIVATE METHODS --------------------------------------------------------
+
+bool WorkStealingPool::takeTask(const int worker, Task& task)
+{
+	const int numQueues{static_cast<int>(queues.size())};
+
+	// The worker's own queue first, then the others starting with the next one
+	for (int i{0}; i < numQueues; i++)
+	{
+		WorkerQueue& queue{*queues[(worker + i) % numQueues]};
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		if (queue.tasks.empty())
+		{
+			continue;
+		}
+
+		if (i == 0)
+		{
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+		}
+		else
+		{
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+		}
+
+		queuedTasks--;
+
+		return true;
+	}
+
+	return false;
+}
+
+void WorkStealingPool::runWorker(const int worker)
+{
+	Task task;
+
+	for (;;)
+	{
+		if (takeTask(worker, task))
+		{
+			task();
+			task = nullptr;		// Release what the task holds before sleeping
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+
+		wakeUp.wait(lock, [this]() { return stopping || (queuedTasks > 0); });
+
+		if (stopping)
+		{
+			return;
+		}
+	}
+}
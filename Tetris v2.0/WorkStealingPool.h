@@ -0,0 +1,100 @@
+// The WorkStealingPool class runs short tasks on a fixed pool of worker threads.
+//  - Each worker has its own task queue, so workers do not contend on one lock. Tasks
+//     submitted from outside the pool are spread over the queues in turn, and a worker
+//     whose queue is empty steals from the others (so one slow task never holds back
+//     the tasks queued behind it while another worker is idle)
+//  - A worker runs its own tasks oldest first, and steals the newest task of another
+//     queue (the one its owner would reach last)
+//  - Idle workers sleep until a task is submitted
+//
+// Note: tasks should not block (they share the workers with every other task).
+
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+class WorkStealingPool
+{
+public:
+	// TYPES ------------------------------------------------------------------
+	using Task = std::function<void()>;
+
+private:
+	// The task queue of one worker
+	//  - On its own cache line, so workers locking their own queues do not share one
+	struct alignas(64) WorkerQueue
+	{
+		std::mutex mutex;			// Guards tasks
+		std::deque<Task> tasks;		// Queued tasks, oldest first
+	};
+
+	// MEMBER VARIABLES -------------------------------------------------------
+	std::vector<std::unique_ptr<WorkerQueue>> queues;	// One per worker
+	std::vector<std::thread> workers;					// The worker threads
+
+	std::atomic<int> queuedTasks{0};		// Tasks submitted and not taken by a worker yet
+	std::atomic<unsigned> nextQueue{0};		// The queue the next submitted task goes to
+
+	std::mutex sleepMutex;					// Guards stopping, and the workers' sleep
+	std::condition_variable wakeUp;			// Signaled when a task is submitted (or on stop)
+	bool stopping{false};					// True once the pool is being destroyed
+
+public:
+	// Constructor ------------------------------------------------------------
+
+	// Constructor
+	//  - Starts the workers
+	//
+	// - param 1: int, the number of workers (0 for one per hardware thread)
+	explicit WorkStealingPool(int numWorkers = 0);
+
+	// The pool owns threads, so it can not be copied
+	WorkStealingPool(const WorkStealingPool&) = delete;
+	WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+
+	// METHODS ----------------------------------------------------------------
+
+	// Queue a task to run on a worker (from any thread.)
+	//
+	// - param 1: Task, the task
+	void submit(Task task);
+
+	// Getters ---------------------------------
+
+	int getNumWorkers() const;		// Get the number of workers
+	int getQueueDepth() const;		// Get the tasks waiting for a worker (it may change right after)
+
+
+	// Destructor -------------------------------------------------------------
+
+	// Stops the workers (after the tasks they are running finish, queued tasks are dropped)
+	~WorkStealingPool();
+
+
+private:
+	// PRIVATE METHODS --------------------------------------------------------
+
+	// Take the oldest task of a worker's own queue, or steal the newest task of another.
+	//
+	// - param 1: int, the worker index
+	// - param 2: Task, filled with the task taken
+	// - return: bool, true if a task was taken
+	bool takeTask(int worker, Task& task);
+
+	// Take and run tasks until the pool stops, run on each worker.
+	//
+	// - param 1: int, the worker index
+	void runWorker(int worker);
+};
+
+#endif /* WORKSTEALINGPOOL_H */
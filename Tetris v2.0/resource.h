@@ -0,0 +1,18 @@
+// Resource IDs of the assets embedded in the executable (see Tetris v2.0.rc)
+//  - Must stay in AssetPack::AssetId order, starting at IDR_FIRST_ASSET
+
+#ifndef RESOURCE_H
+#define RESOURCE_H
+
+#define IDR_FIRST_ASSET				101
+
+#define IDR_BACKGROUND_IMAGE		101
+#define IDR_TILES_IMAGE				102
+#define IDR_FONT					103
+#define IDR_BLOCK_DROP_SOUND		104
+#define IDR_BLOCK_ROTATE_SOUND		105
+#define IDR_LEVEL_UP_SOUND			106
+#define IDR_GAME_OVER_SOUND			107
+#define IDR_MUSIC					108
+
+#endif /* RESOURCE_H */